@@ -0,0 +1,88 @@
+// fetch_add throughput on one shared counter, atomic_uint128 against a mutex and, with -DBENCH_LIBATOMIC,
+// std::atomic<unsigned __int128> through libatomic
+// g++ -std=c++11 -O2 -pthread -I src bench/atomic128.cpp -o atomic128_bench [-DBENCH_LIBATOMIC -latomic]
+
+#include "int128_atomic.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+    struct locked_counter {
+        std::mutex lock;
+        uint128_t value{};
+
+        void add(uint128_t arg_) {
+            std::lock_guard<std::mutex> guard_(lock);
+            value += arg_;
+        }
+
+        uint128_t get() {
+            std::lock_guard<std::mutex> guard_(lock);
+            return value;
+        }
+    };
+
+    struct cas_counter {
+        large_int::atomic_uint128 value{uint128_t(0)};
+
+        void add(uint128_t arg_) { value.fetch_add(arg_); }
+
+        uint128_t get() { return value.load(); }
+    };
+
+#if defined(BENCH_LIBATOMIC) && __SIZEOF_INT128__ == 16
+    struct std_counter {
+        std::atomic<unsigned __int128> value{0};
+
+        void add(uint128_t arg_) { // the generic std::atomic has no fetch_add
+            auto cur_ = value.load(std::memory_order_relaxed);
+            while (!value.compare_exchange_weak(cur_, cur_ + static_cast<unsigned __int128>(arg_))) {}
+        }
+
+        uint128_t get() { return uint128_t(value.load()); }
+    };
+#endif
+
+    // ns per increment over all threads, the carry into the high half is taken on every other add
+    template<class _Counter>
+    double ns_per_op(unsigned threads_, std::size_t ops_) {
+        _Counter counter_;
+        auto step_ = uint128_t(1) << 63;
+        auto start_ = std::chrono::steady_clock::now();
+        std::vector<std::thread> pool_;
+        for (unsigned t_ = 0; t_ < threads_; ++t_) {
+            pool_.emplace_back([&] { for (std::size_t i_ = 0; i_ < ops_; ++i_) counter_.add(step_); });
+        }
+        for (auto &th_ : pool_) th_.join();
+        std::chrono::duration<double, std::nano> elapsed_ = std::chrono::steady_clock::now() - start_;
+        if (counter_.get() != uint128_t(ops_ * threads_) * step_) {
+            printf("lost updates\n");
+            std::exit(1);
+        }
+        return elapsed_.count() / double(ops_ * threads_);
+    }
+}
+
+int main(int argc, char *argv[]) {
+    std::size_t ops_ = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1U << 20;
+    auto max_ = std::max(4U, std::thread::hardware_concurrency());
+    printf("atomic_uint128 lock free: %d\n", int(large_int::atomic_uint128::is_always_lock_free));
+    printf("%-8s %12s %12s", "threads", "cmpxchg16b", "mutex");
+#if defined(BENCH_LIBATOMIC) && __SIZEOF_INT128__ == 16
+    printf(" %12s", "libatomic");
+#endif
+    printf("\n");
+    for (unsigned t_ = 1; t_ <= max_; t_ *= 2) {
+        printf("%-8u %12.1f %12.1f", t_, ns_per_op<cas_counter>(t_, ops_), ns_per_op<locked_counter>(t_, ops_));
+#if defined(BENCH_LIBATOMIC) && __SIZEOF_INT128__ == 16
+        printf(" %12.1f", ns_per_op<std_counter>(t_, ops_));
+#endif
+        printf("\n");
+    }
+    return 0;
+}
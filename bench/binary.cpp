@@ -0,0 +1,100 @@
+// ns per value to decode a buffer of LEB128 varints with varint_decode against a byte at a time loop, then to
+// encode them, for values of up to 14, 63 and 128 bits; and ns per value for the 16-byte load_le and load_be
+// g++ -std=c++11 -O2 -I src bench/binary.cpp -o binary_bench
+
+#include "int128_binary.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+    volatile uint64_t sink;
+
+    template<class _Fn>
+    double time_ns(std::size_t ops_, _Fn fn_) {
+        auto start_ = std::chrono::steady_clock::now();
+        sink = fn_();
+        std::chrono::duration<double, std::nano> elapsed_ = std::chrono::steady_clock::now() - start_;
+        return elapsed_.count() / double(ops_);
+    }
+
+    // what a decoder without the word loads does
+    const char *decode_bytes(const char *first_, uint128_t &value_) {
+        uint128_t res_(0);
+        for (int shift_ = 0;; shift_ += 7) {
+            auto byte_ = static_cast<unsigned char>(*first_++);
+            res_ = res_ | uint128_t(byte_ & 0x7fU) << shift_;
+            if (!(byte_ & 0x80U)) break;
+        }
+        value_ = res_;
+        return first_;
+    }
+}
+
+int main(int argc, char *argv[]) {
+    std::size_t n_ = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000;
+    unsigned reps_ = 20;
+    std::mt19937_64 rng_(42);
+    printf("%-10s %12s %12s %12s\n", "bits", "decode", "byte loop", "encode");
+    for (int bits_ : {14, 63, 128}) {
+        std::vector<uint128_t> values_(n_);
+        std::vector<char> buf_(n_ * 19 + 16);
+        auto pos_ = buf_.data();
+        for (auto &v_ : values_) {
+            v_ = (uint128_t(rng_()) << 64 | uint128_t(rng_())) >> static_cast<int>(128 - 1 - rng_() % bits_);
+            pos_ = large_int::varint_encode(pos_, buf_.data() + buf_.size(), v_).ptr;
+        }
+        auto end_ = pos_;
+        auto decode_ = time_ns(n_ * reps_, [&] {
+            uint64_t sum_ = 0;
+            for (unsigned r_ = 0; r_ < reps_; ++r_) {
+                uint128_t v_;
+                for (const char *p_ = buf_.data(); p_ != end_; sum_ += static_cast<uint64_t>(v_)) {
+                    p_ = large_int::varint_decode(p_, buf_.data() + buf_.size(), v_).ptr;
+                }
+            }
+            return sum_;
+        });
+        auto loop_ = time_ns(n_ * reps_, [&] {
+            uint64_t sum_ = 0;
+            for (unsigned r_ = 0; r_ < reps_; ++r_) {
+                uint128_t v_;
+                for (const char *p_ = buf_.data(); p_ != end_; sum_ += static_cast<uint64_t>(v_)) {
+                    p_ = decode_bytes(p_, v_);
+                }
+            }
+            return sum_;
+        });
+        auto encode_ = time_ns(n_ * reps_, [&] {
+            uint64_t sum_ = 0;
+            for (unsigned r_ = 0; r_ < reps_; ++r_) {
+                auto p_ = buf_.data();
+                for (auto v_ : values_) p_ = large_int::varint_encode(p_, buf_.data() + buf_.size(), v_).ptr;
+                sum_ += static_cast<uint64_t>(p_ - buf_.data());
+            }
+            return sum_;
+        });
+        printf("%-10d %12.2f %12.2f %12.2f\n", bits_, decode_, loop_, encode_);
+    }
+    std::vector<char> fixed_(n_ * 16);
+    for (auto &c_ : fixed_) c_ = static_cast<char>(rng_());
+    auto le_ = time_ns(n_ * reps_, [&] {
+        uint64_t sum_ = 0;
+        for (unsigned r_ = 0; r_ < reps_; ++r_) {
+            for (std::size_t i_ = 0; i_ < n_; ++i_) sum_ += static_cast<uint64_t>(large_int::load_le(&fixed_[i_ * 16]));
+        }
+        return sum_;
+    });
+    auto be_ = time_ns(n_ * reps_, [&] {
+        uint64_t sum_ = 0;
+        for (unsigned r_ = 0; r_ < reps_; ++r_) {
+            for (std::size_t i_ = 0; i_ < n_; ++i_) sum_ += static_cast<uint64_t>(large_int::load_be(&fixed_[i_ * 16]));
+        }
+        return sum_;
+    });
+    printf("%-10s %12.2f load_le %.2f load_be\n", "fixed", le_, be_);
+    return 0;
+}
@@ -0,0 +1,94 @@
+// ns per value of the column kernels, each one the cpu runs, against a loop of operators over an array of
+// int128_t, on 2048 values that stay in L1
+// g++ -std=c++11 -O2 -I src bench/column.cpp -o column_bench
+
+#include "int128_column.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+    namespace dt = large_int::detail_;
+
+    volatile uint64_t sink;
+
+    template<class _Fn>
+    double time_ns(std::size_t ops_, _Fn fn_) {
+        auto start_ = std::chrono::steady_clock::now();
+        sink = fn_();
+        std::chrono::duration<double, std::nano> elapsed_ = std::chrono::steady_clock::now() - start_;
+        return elapsed_.count() / double(ops_);
+    }
+}
+
+int main(int argc, char *argv[]) {
+    std::size_t n_ = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2048;
+    unsigned reps_ = 20000;
+    std::mt19937_64 rng_(42);
+    std::vector<int128_t> lhs_(n_), rhs_(n_), out_(n_);
+    for (std::size_t i_ = 0; i_ < n_; ++i_) {
+        lhs_[i_] = int128_t(uint128_t(rng_()) << 64 | uint128_t(rng_()));
+        rhs_[i_] = int128_t(uint128_t(rng_() % 4 ? rng_() : static_cast<uint64_t>(uint128_t(lhs_[i_]) >> 64)) << 64 |
+                            uint128_t(rng_()));
+    }
+    large_int::int128_column a_(lhs_.data(), n_), b_(rhs_.data(), n_), c_(n_);
+    std::vector<uint8_t> mask_(n_);
+    dt::column_args_ args_ = {a_.high(), a_.low(), b_.high(), b_.low(), c_.high(), c_.low(), mask_.data(), mask_.data()};
+
+    printf("%-10s %10s %10s %10s %10s\n", "impl", "add", "sub", "less", "min");
+    auto ops_ = n_ * reps_;
+    auto add_ = time_ns(ops_, [&] {
+        for (unsigned r_ = 0; r_ < reps_; ++r_) {
+            for (std::size_t i_ = 0; i_ < n_; ++i_) out_[i_] = lhs_[i_] + rhs_[i_];
+            __asm__ __volatile__("" ::: "memory");
+        }
+        return static_cast<uint64_t>(out_[n_ / 2]);
+    });
+    auto sub_ = time_ns(ops_, [&] {
+        for (unsigned r_ = 0; r_ < reps_; ++r_) {
+            for (std::size_t i_ = 0; i_ < n_; ++i_) out_[i_] = lhs_[i_] - rhs_[i_];
+            __asm__ __volatile__("" ::: "memory");
+        }
+        return static_cast<uint64_t>(out_[n_ / 2]);
+    });
+    auto less_ = time_ns(ops_, [&] {
+        for (unsigned r_ = 0; r_ < reps_; ++r_) {
+            for (std::size_t i_ = 0; i_ < n_; ++i_) mask_[i_] = lhs_[i_] < rhs_[i_];
+            __asm__ __volatile__("" ::: "memory");
+        }
+        return uint64_t(mask_[n_ / 2]);
+    });
+    auto min_ = time_ns(ops_, [&] {
+        for (unsigned r_ = 0; r_ < reps_; ++r_) {
+            for (std::size_t i_ = 0; i_ < n_; ++i_) out_[i_] = rhs_[i_] < lhs_[i_] ? rhs_[i_] : lhs_[i_];
+            __asm__ __volatile__("" ::: "memory");
+        }
+        return static_cast<uint64_t>(out_[n_ / 2]);
+    });
+    printf("%-10s %10.3f %10.3f %10.3f %10.3f\n", "operators", add_, sub_, less_, min_);
+
+    struct kernel_set {
+        const char *name;
+        const dt::column_table_ *table;
+    } sets_[3] = {{"scalar", &dt::column_scalar_kernels_()}, {nullptr, nullptr}, {nullptr, nullptr}};
+#ifdef INT128_COLUMN_X86
+    if (__builtin_cpu_supports("avx2")) sets_[1] = {"avx2", &dt::column_avx2_kernels_()};
+    if (__builtin_cpu_supports("avx512f")) sets_[2] = {"avx512", &dt::column_avx512_kernels_()};
+#endif
+    for (auto &set_ : sets_) {
+        if (!set_.table) continue;
+        double ns_[4];
+        dt::column_fn_ fns_[4] = {set_.table->add, set_.table->sub, set_.table->less[1], set_.table->min[1]};
+        for (int k_ = 0; k_ < 4; ++k_) {
+            ns_[k_] = time_ns(ops_, [&] {
+                for (unsigned r_ = 0; r_ < reps_; ++r_) fns_[k_](args_, 0, n_);
+                return c_.low()[n_ / 2] ^ mask_[n_ / 2];
+            });
+        }
+        printf("%-10s %10.3f %10.3f %10.3f %10.3f\n", set_.name, ns_[0], ns_[1], ns_[2], ns_[3]);
+    }
+    return 0;
+}
@@ -0,0 +1,128 @@
+// distribution and throughput of hash128 against the usual hand written hashes
+// g++ -std=c++11 -O2 -I src bench/hash128.cpp -o hash128_bench
+
+#include "int128.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+    struct xor_hash {
+        size_t operator()(uint128_t val_) const { return size_t(uint64_t(val_ >> 64) ^ uint64_t(val_)); }
+    };
+
+    struct combine_hash { // boost::hash_combine of the two halves
+        size_t operator()(uint128_t val_) const {
+            size_t seed_ = std::hash<uint64_t>()(uint64_t(val_ >> 64));
+            return seed_ ^ (std::hash<uint64_t>()(uint64_t(val_)) + 0x9e3779b97f4a7c15 + (seed_ << 6) + (seed_ >> 2));
+        }
+    };
+
+    struct mixer_hash {
+        size_t operator()(uint128_t val_) const { return size_t(large_int::hash128(val_)); }
+    };
+
+    uint128_t make(uint64_t high_, uint64_t low_) { return uint128_t(high_) << 64 | uint128_t(low_); }
+
+    std::vector<uint128_t> sequential_keys(std::size_t n_) {
+        std::vector<uint128_t> keys_(n_);
+        for (std::size_t i_ = 0; i_ < n_; ++i_) keys_[i_] = uint128_t(i_);
+        return keys_;
+    }
+
+    // a few /48 prefixes, small subnet ids, EUI-64 interface ids from sequential MACs of one vendor
+    std::vector<uint128_t> ipv6_keys(std::size_t n_, std::mt19937_64 &rng_) {
+        std::vector<uint128_t> keys_(n_);
+        uint64_t prefixes_[4];
+        for (auto &p_ : prefixes_) p_ = (UINT64_C(0x2001) << 48 | (rng_() & UINT64_C(0xffffffff)) << 16);
+        for (std::size_t i_ = 0; i_ < n_; ++i_) {
+            auto high_ = prefixes_[i_ % 4] | (i_ / 4 % 256);
+            auto mac_ = UINT64_C(0x001b21000000) + i_ / 1024;
+            auto low_ = (mac_ >> 24 ^ 0x020000) << 40 | UINT64_C(0xfffe) << 24 | (mac_ & 0xffffff);
+            keys_[i_] = make(high_, low_);
+        }
+        return keys_;
+    }
+
+    // random version 4 UUIDs
+    std::vector<uint128_t> uuid_keys(std::size_t n_, std::mt19937_64 &rng_) {
+        std::vector<uint128_t> keys_(n_);
+        for (auto &k_ : keys_) {
+            auto high_ = (rng_() & ~UINT64_C(0xf000)) | UINT64_C(0x4000);
+            auto low_ = (rng_() & ~(UINT64_C(3) << 62)) | UINT64_C(1) << 63;
+            k_ = make(high_, low_);
+        }
+        return keys_;
+    }
+
+    // the same low half, keys differ only in the high half
+    std::vector<uint128_t> high_only_keys(std::size_t n_) {
+        std::vector<uint128_t> keys_(n_);
+        for (std::size_t i_ = 0; i_ < n_; ++i_) keys_[i_] = make(i_ << 20, UINT64_C(0xdeadbeef));
+        return keys_;
+    }
+
+    // chi-square of the occupancy of n_ power of two buckets over the expected value, 1.0 is uniform
+    template<class _Hash>
+    double chi_square_ratio(const std::vector<uint128_t> &keys_) {
+        std::size_t buckets_ = 1;
+        while (buckets_ < keys_.size()) buckets_ <<= 1;
+        std::vector<unsigned> count_(buckets_);
+        _Hash hash_;
+        for (auto k_ : keys_) ++count_[hash_(k_) & (buckets_ - 1)];
+        double expect_ = double(keys_.size()) / double(buckets_), chi_ = 0;
+        for (auto c_ : count_) chi_ += (c_ - expect_) * (c_ - expect_) / expect_;
+        return chi_ / double(buckets_);
+    }
+
+    template<class _Hash>
+    double ns_per_hash(const std::vector<uint128_t> &keys_, uint64_t &sink_) {
+        _Hash hash_;
+        auto start_ = std::chrono::steady_clock::now();
+        for (int r_ = 0; r_ < 20; ++r_) for (auto k_ : keys_) sink_ += hash_(k_);
+        std::chrono::duration<double, std::nano> elapsed_ = std::chrono::steady_clock::now() - start_;
+        return elapsed_.count() / double(20 * keys_.size());
+    }
+
+    template<class _Hash>
+    double ns_per_map_op(const std::vector<uint128_t> &keys_, uint64_t &sink_) {
+        auto start_ = std::chrono::steady_clock::now();
+        std::unordered_map<uint128_t, uint64_t, _Hash> map_;
+        for (auto k_ : keys_) ++map_[k_];
+        for (auto k_ : keys_) sink_ += map_.find(k_)->second;
+        std::chrono::duration<double, std::nano> elapsed_ = std::chrono::steady_clock::now() - start_;
+        return elapsed_.count() / double(2 * keys_.size());
+    }
+
+    template<class _Hash>
+    void report(const char *set_, const char *name_, const std::vector<uint128_t> &keys_, uint64_t &sink_) {
+        printf("%-10s %-8s %12.3f %10.2f %12.1f\n", set_, name_, chi_square_ratio<_Hash>(keys_),
+               ns_per_hash<_Hash>(keys_, sink_), ns_per_map_op<_Hash>(keys_, sink_));
+    }
+}
+
+int main(int argc, char *argv[]) {
+    std::size_t n_ = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1U << 20;
+    std::mt19937_64 rng_(42);
+    struct {
+        const char *name;
+        std::vector<uint128_t> keys;
+    } sets_[] = {
+            {"sequential", sequential_keys(n_)},
+            {"ipv6", ipv6_keys(n_, rng_)},
+            {"uuid", uuid_keys(n_, rng_)},
+            {"high-only", high_only_keys(n_)},
+    };
+    uint64_t sink_ = 0;
+    printf("%-10s %-8s %12s %10s %12s\n", "keys", "hash", "chi2/bucket", "ns/hash", "ns/map-op");
+    for (auto &s_ : sets_) {
+        report<xor_hash>(s_.name, "xor", s_.keys, sink_);
+        report<combine_hash>(s_.name, "combine", s_.keys, sink_);
+        report<mixer_hash>(s_.name, "hash128", s_.keys, sink_);
+    }
+    return sink_ == 42; // keep the loops alive
+}
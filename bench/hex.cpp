@@ -0,0 +1,87 @@
+// ns per value of each hex kernel called once per value, as to_hex and from_hex do, against one call for the whole
+// batch, and of to_chars base 16 for scale
+// g++ -std=c++11 -O2 -I src bench/hex.cpp -o hex_bench
+
+#include "int128_hex.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+    namespace dt = large_int::detail_;
+
+    volatile uint64_t sink;
+
+    template<class _Fn>
+    double time_ns(std::size_t ops_, _Fn fn_) {
+        auto start_ = std::chrono::steady_clock::now();
+        sink = fn_();
+        std::chrono::duration<double, std::nano> elapsed_ = std::chrono::steady_clock::now() - start_;
+        return elapsed_.count() / double(ops_);
+    }
+
+    struct kernel {
+        const char *name;
+        dt::hex_encode_fn_ encode;
+        dt::hex_decode_fn_ decode;
+    };
+}
+
+int main(int argc, char *argv[]) {
+    std::size_t n_ = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 4096;
+    unsigned reps_ = 500;
+    std::mt19937_64 rng_(42);
+    std::vector<uint128_t> values_(n_), back_(n_);
+    for (auto &v_ : values_) v_ = uint128_t(rng_()) << 64 | uint128_t(rng_());
+    std::vector<char> text_(32 * n_);
+    auto ops_ = n_ * reps_;
+
+    auto chars_ = time_ns(ops_, [&] {
+        uint64_t sum_ = 0;
+        for (unsigned r_ = 0; r_ < reps_; ++r_) {
+            for (std::size_t i_ = 0; i_ < n_; ++i_) {
+                sum_ += static_cast<uint64_t>(large_int::to_chars(&text_[32 * i_], &text_[32 * i_] + 32,
+                                                                  values_[i_], 16).ptr - text_.data());
+            }
+        }
+        return sum_;
+    });
+    printf("%-8s %12s %12s %12s %12s\n", "kernel", "to_hex", "to_hex_batch", "from_hex", "from_batch");
+    printf("%-8s %12.2f (to_chars base 16)\n", "-", chars_);
+
+    std::vector<kernel> kernels_ = {{"scalar", dt::hex_encode_scalar_, dt::hex_decode_scalar_}};
+#ifdef INT128_HEX_X86
+    if (__builtin_cpu_supports("sse2")) kernels_.push_back({"sse2", dt::hex_encode_sse2_, dt::hex_decode_sse2_});
+    if (__builtin_cpu_supports("ssse3")) kernels_.push_back({"ssse3", dt::hex_encode_ssse3_, dt::hex_decode_ssse3_});
+    if (__builtin_cpu_supports("avx2")) kernels_.push_back({"avx2", dt::hex_encode_avx2_, dt::hex_decode_avx2_});
+#endif
+    for (auto &k_ : kernels_) {
+        auto one_ = time_ns(ops_, [&] {
+            for (unsigned r_ = 0; r_ < reps_; ++r_) {
+                for (std::size_t i_ = 0; i_ < n_; ++i_) k_.encode(&text_[32 * i_], &values_[i_], 1, false);
+            }
+            return uint64_t(text_[n_]);
+        });
+        auto batch_ = time_ns(ops_, [&] {
+            for (unsigned r_ = 0; r_ < reps_; ++r_) k_.encode(text_.data(), values_.data(), n_, false);
+            return uint64_t(text_[n_]);
+        });
+        auto dec_one_ = time_ns(ops_, [&] {
+            uint64_t sum_ = 0;
+            for (unsigned r_ = 0; r_ < reps_; ++r_) {
+                for (std::size_t i_ = 0; i_ < n_; ++i_) sum_ += k_.decode(&text_[32 * i_], &back_[i_], 1);
+            }
+            return sum_ + static_cast<uint64_t>(back_[n_ / 2]);
+        });
+        auto dec_batch_ = time_ns(ops_, [&] {
+            uint64_t sum_ = 0;
+            for (unsigned r_ = 0; r_ < reps_; ++r_) sum_ += k_.decode(text_.data(), back_.data(), n_);
+            return sum_ + static_cast<uint64_t>(back_[n_ / 2]);
+        });
+        printf("%-8s %12.2f %12.2f %12.2f %12.2f\n", k_.name, one_, batch_, dec_one_, dec_batch_);
+    }
+    return 0;
+}
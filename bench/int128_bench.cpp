@@ -0,0 +1,510 @@
+// per operation timings of both delegates and of raw unsigned __int128, as csv or json rows:
+// build, op, impl, dist, ns/op and a checksum of the results, which has to agree between impls of one op
+// built twice by cmake, int128_bench with __int128 and int128_bench_fallback with -U__SIZEOF_INT128__.
+// In the first, "fallback" is detail_delegate<false>, whose divide is Knuth D on 32-bit digits with 64-by-32 steps,
+// only detail_delegate<true> divides with divq.
+// int128_bench_m32 is the fallback on 32-bit limbs, where the toolchain can link -m32
+// int128_bench [--format=csv|json] [--output=file] [--n=4096] [--reps=200] [--filter=op]
+
+#include "int128.h"
+#include "int128_float.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <locale>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using large_int::int128_t;
+using large_int::uint128_t;
+
+namespace {
+#if __SIZEOF_INT128__ == 16
+    const char *const build_name = "native";
+#elif INT128_LIMB32
+    const char *const build_name = "limb32";
+#else
+    const char *const build_name = "fallback";
+#endif
+
+    struct options {
+        std::size_t n = 4096;
+        unsigned reps = 200;
+        bool json = false;
+        std::string filter;
+        FILE *out = stdout;
+    };
+
+    struct operands {
+        const char *name;
+        std::vector<uint128_t> lhs, rhs; // rhs is never zero, its low 7 bits are the shift count
+    };
+
+    uint128_t make(uint64_t high_, uint64_t low_) { return uint128_t(high_) << 64 | uint128_t(low_); }
+
+    uint128_t nonzero(uint128_t val_) { return val_ ? val_ : uint128_t(1); }
+
+    std::vector<operands> make_operands(std::size_t n_) {
+        std::mt19937_64 rng_(42);
+        std::vector<operands> sets_ = {{"random", {}, {}}, {"narrow", {}, {}}, {"mixed", {}, {}},
+                                        {"adversarial", {}, {}}};
+        for (auto &s_ : sets_) {
+            s_.lhs.resize(n_);
+            s_.rhs.resize(n_);
+        }
+        static const unsigned edges_[] = {0, 1, 63, 64, 65, 127};
+        for (std::size_t i_ = 0; i_ < n_; ++i_) {
+            // full width random
+            sets_[0].lhs[i_] = make(rng_(), rng_());
+            sets_[0].rhs[i_] = nonzero(make(rng_(), rng_()));
+            // both fit in 64 bits, the short paths
+            sets_[1].lhs[i_] = uint128_t(rng_());
+            sets_[1].rhs[i_] = nonzero(uint128_t(rng_()));
+            // random bit lengths, the divides take every path
+            sets_[2].lhs[i_] = make(rng_(), rng_()) >> int(rng_() % 128);
+            sets_[2].rhs[i_] = nonzero(make(rng_(), rng_()) >> int(rng_() % 128));
+            // full dividends over divisors just past 64 bits, shifts at the limb edges, float casts at a
+            // rounding tie
+            sets_[3].lhs[i_] = make(~uint64_t(0) >> (i_ % 2), (rng_() | 1) << 10 | UINT64_C(1) << 9);
+            sets_[3].rhs[i_] = make(1 + i_ % 3, ~UINT64_C(127) | edges_[i_ % 6]);
+        }
+        return sets_;
+    }
+
+    void fold(uint64_t &sum_, uint128_t val_) {
+        sum_ = (sum_ ^ static_cast<uint64_t>(val_) ^ static_cast<uint64_t>(val_ >> 64)) * UINT64_C(0x100000001b3);
+        sum_ ^= sum_ >> 29U; // doubles have their low bits clear
+    }
+
+    void fold(uint64_t &sum_, int128_t val_) { fold(sum_, uint128_t(val_)); }
+
+    void fold(uint64_t &sum_, bool val_) { fold(sum_, uint128_t(val_)); }
+
+    void fold(uint64_t &sum_, double val_) {
+        uint64_t bits_;
+        std::memcpy(&bits_, &val_, sizeof(bits_));
+        fold(sum_, uint128_t(bits_));
+    }
+
+    void fold(uint64_t &sum_, float val_) { fold(sum_, double(val_)); }
+
+#if __SIZEOF_INT128__ == 16
+
+    void fold(uint64_t &sum_, unsigned __int128 val_) { fold(sum_, uint128_t(val_)); }
+
+    void fold(uint64_t &sum_, __int128 val_) { fold(sum_, uint128_t(val_)); }
+
+#endif
+
+    class reporter {
+        const options &opt_;
+        bool first_ = true;
+
+    public:
+        explicit reporter(const options &options_) : opt_(options_) {
+            if (opt_.json) {
+                fputs("[\n", opt_.out);
+            } else {
+                fputs("build,op,impl,dist,ns_per_op,checksum\n", opt_.out);
+            }
+        }
+
+        reporter(const reporter &) = delete;
+
+        reporter &operator=(const reporter &) = delete;
+
+        ~reporter() {
+            if (opt_.json) fputs("\n]\n", opt_.out);
+        }
+
+        bool wanted(const char *op_) const { return opt_.filter.empty() || opt_.filter == op_; }
+
+        void row(const char *op_, const char *impl_, const char *dist_, double ns_, uint64_t sum_) {
+            if (opt_.json) {
+                fprintf(opt_.out, "%s  {\"build\": \"%s\", \"op\": \"%s\", \"impl\": \"%s\", \"dist\": \"%s\", "
+                                  "\"ns_per_op\": %.3f, \"checksum\": \"%016llx\"}", first_ ? "" : ",\n",
+                        build_name, op_, impl_, dist_, ns_, static_cast<unsigned long long>(sum_));
+            } else {
+                fprintf(opt_.out, "%s,%s,%s,%s,%.3f,%016llx\n", build_name, op_, impl_, dist_, ns_,
+                        static_cast<unsigned long long>(sum_));
+            }
+            first_ = false;
+        }
+    };
+
+    // hides the value from the optimizer, so nothing is hoisted out of the repetitions
+    template<class _Tp>
+    _Tp opaque(const _Tp &val_) {
+        auto copy_ = val_;
+#if defined(__GNUC__)
+        __asm__ __volatile__("" : "+m"(copy_));
+#endif
+        return copy_;
+    }
+
+    volatile uint64_t sink;
+
+    // _Val converts the operands to what fn_ takes, the checksum covers one pass
+    template<class _Val, class _Fn>
+    void measure(reporter &rep_, const options &opt_, const char *op_, const char *impl_, const operands &set_,
+                 _Fn fn_) {
+        if (!rep_.wanted(op_)) return;
+        std::vector<_Val> lhs_(set_.lhs.size()), rhs_(set_.rhs.size());
+        for (std::size_t i_ = 0; i_ < lhs_.size(); ++i_) {
+            lhs_[i_] = static_cast<_Val>(set_.lhs[i_]);
+            rhs_[i_] = static_cast<_Val>(set_.rhs[i_]);
+        }
+        uint64_t sum_ = 0;
+        for (std::size_t i_ = 0; i_ < lhs_.size(); ++i_) fold(sum_, fn_(lhs_[i_], rhs_[i_]));
+        uint64_t sink_ = 0;
+        auto start_ = std::chrono::steady_clock::now();
+        for (unsigned r_ = 0; r_ < opt_.reps; ++r_) {
+            for (std::size_t i_ = 0; i_ < lhs_.size(); ++i_) fold(sink_, fn_(opaque(lhs_[i_]), rhs_[i_]));
+        }
+        std::chrono::duration<double, std::nano> elapsed_ = std::chrono::steady_clock::now() - start_;
+        sink = sink_;
+        rep_.row(op_, impl_, set_.name, elapsed_.count() / double(opt_.reps * lhs_.size()), sum_);
+    }
+
+    template<bool _Native>
+    void delegate_ops(reporter &rep_, const options &opt_, const char *impl_, const operands &set_) {
+        typedef large_int::detail_delegate<_Native> _Dg;
+        measure<uint128_t>(rep_, opt_, "mul", impl_, set_, [](uint128_t x_, uint128_t y_) { return _Dg::imul(x_, y_); });
+        measure<uint128_t>(rep_, opt_, "mulhi", impl_, set_, [](uint128_t x_, uint128_t y_) { return _Dg::mulhi(x_, y_); });
+        measure<uint128_t>(rep_, opt_, "div", impl_, set_, [](uint128_t x_, uint128_t y_) { return _Dg::div(x_, y_); });
+        measure<uint128_t>(rep_, opt_, "mod", impl_, set_, [](uint128_t x_, uint128_t y_) { return _Dg::mod(x_, y_); });
+        measure<int128_t>(rep_, opt_, "sdiv", impl_, set_, [](int128_t x_, int128_t y_) { return _Dg::div(x_, y_); });
+        measure<int128_t>(rep_, opt_, "smod", impl_, set_, [](int128_t x_, int128_t y_) { return _Dg::mod(x_, y_); });
+        measure<uint128_t>(rep_, opt_, "shl", impl_, set_, [](uint128_t x_, uint128_t y_) {
+            return _Dg::shl(x_, static_cast<unsigned>(y_) & 127U);
+        });
+        measure<uint128_t>(rep_, opt_, "shr", impl_, set_, [](uint128_t x_, uint128_t y_) {
+            return _Dg::shr(x_, static_cast<unsigned>(y_) & 127U);
+        });
+        measure<int128_t>(rep_, opt_, "sar", impl_, set_, [](int128_t x_, int128_t y_) {
+            return _Dg::sar(x_, static_cast<unsigned>(y_) & 127U);
+        });
+        measure<uint128_t>(rep_, opt_, "cmp", impl_, set_, [](uint128_t x_, uint128_t y_) { return _Dg::cmp(x_, y_); });
+        measure<int128_t>(rep_, opt_, "scmp", impl_, set_, [](int128_t x_, int128_t y_) { return _Dg::cmp(x_, y_); });
+        measure<uint128_t>(rep_, opt_, "to_double", impl_, set_, [](uint128_t x_, uint128_t) {
+            return _Dg::template cast_to_float<double>(x_);
+        });
+        measure<int128_t>(rep_, opt_, "sto_double", impl_, set_, [](int128_t x_, int128_t) {
+            return _Dg::template cast_to_float<double>(x_);
+        });
+        measure<uint128_t>(rep_, opt_, "to_float", impl_, set_, [](uint128_t x_, uint128_t) {
+            return _Dg::template cast_to_float<float>(x_);
+        });
+        // Euclid, a division per step, against the binary gcd of math_ops
+        measure<uint128_t>(rep_, opt_, "gcd", impl_, set_, [](uint128_t x_, uint128_t y_) {
+            while (y_) {
+                auto r_ = _Dg::mod(x_, y_);
+                x_ = y_;
+                y_ = r_;
+            }
+            return x_;
+        });
+    }
+
+    // add and sub are members of int128_base, the conversion from double too, the same code in both delegates
+    void member_ops(reporter &rep_, const options &opt_, const operands &set_) {
+        measure<uint128_t>(rep_, opt_, "add", "operator", set_, [](uint128_t x_, uint128_t y_) { return x_ + y_; });
+        measure<uint128_t>(rep_, opt_, "sub", "operator", set_, [](uint128_t x_, uint128_t y_) { return x_ - y_; });
+        measure<uint128_t>(rep_, opt_, "from_double", "operator", set_, [](uint128_t x_, uint128_t) {
+            return uint128_t(std::ldexp(static_cast<double>(static_cast<uint64_t>(x_)), 60));
+        });
+    }
+
+    // the <bit> functions against the loops over operator<< and operator>> they replace, rhs gives the rotation
+    // and the pdep/pext mask
+    void bit_ops(reporter &rep_, const options &opt_, const operands &set_) {
+        measure<uint128_t>(rep_, opt_, "popcount", "bit", set_, [](uint128_t x_, uint128_t) {
+            return uint128_t(large_int::popcount(x_));
+        });
+        measure<uint128_t>(rep_, opt_, "popcount", "loop", set_, [](uint128_t x_, uint128_t) {
+            unsigned n_ = 0;
+            for (; x_; x_ >>= 1) n_ += static_cast<unsigned>(x_ & uint128_t(1));
+            return uint128_t(n_);
+        });
+        measure<uint128_t>(rep_, opt_, "countr_zero", "bit", set_, [](uint128_t x_, uint128_t) {
+            return uint128_t(large_int::countr_zero(x_));
+        });
+        measure<uint128_t>(rep_, opt_, "countr_zero", "loop", set_, [](uint128_t x_, uint128_t) {
+            unsigned n_ = 0;
+            for (; n_ < 128 && !(x_ & uint128_t(1)); x_ >>= 1) ++n_;
+            return uint128_t(n_);
+        });
+        measure<uint128_t>(rep_, opt_, "bit_width", "bit", set_, [](uint128_t x_, uint128_t) {
+            return uint128_t(large_int::bit_width(x_));
+        });
+        measure<uint128_t>(rep_, opt_, "bit_width", "loop", set_, [](uint128_t x_, uint128_t) {
+            unsigned n_ = 0;
+            for (; x_; x_ >>= 1) ++n_;
+            return uint128_t(n_);
+        });
+        measure<uint128_t>(rep_, opt_, "rotl", "bit", set_, [](uint128_t x_, uint128_t y_) {
+            return large_int::rotl(x_, static_cast<int>(y_ & uint128_t(127)));
+        });
+        measure<uint128_t>(rep_, opt_, "rotl", "loop", set_, [](uint128_t x_, uint128_t y_) {
+            auto r_ = static_cast<int>(y_ & uint128_t(127));
+            return r_ ? x_ << r_ | x_ >> (128 - r_) : x_;
+        });
+        measure<uint128_t>(rep_, opt_, "byteswap", "bit", set_, [](uint128_t x_, uint128_t) {
+            return large_int::byteswap(x_);
+        });
+        measure<uint128_t>(rep_, opt_, "byteswap", "loop", set_, [](uint128_t x_, uint128_t) {
+            uint128_t res_(0);
+            for (int i_ = 0; i_ < 16; ++i_, x_ >>= 8) res_ = res_ << 8 | (x_ & uint128_t(0xff));
+            return res_;
+        });
+        measure<uint128_t>(rep_, opt_, "pdep", "bit", set_, [](uint128_t x_, uint128_t y_) {
+            return large_int::pdep(x_, y_);
+        });
+        measure<uint128_t>(rep_, opt_, "pdep", "loop", set_, [](uint128_t x_, uint128_t y_) {
+            uint128_t res_(0);
+            for (int i_ = 0; i_ < 128; ++i_) {
+                if (y_ >> i_ & uint128_t(1)) {
+                    res_ = res_ | (x_ & uint128_t(1)) << i_;
+                    x_ >>= 1;
+                }
+            }
+            return res_;
+        });
+        measure<uint128_t>(rep_, opt_, "pext", "bit", set_, [](uint128_t x_, uint128_t y_) {
+            return large_int::pext(x_, y_);
+        });
+        measure<uint128_t>(rep_, opt_, "pext", "loop", set_, [](uint128_t x_, uint128_t y_) {
+            uint128_t res_(0);
+            for (int i_ = 0, k_ = 0; i_ < 128; ++i_) {
+                if (y_ >> i_ & uint128_t(1)) res_ = res_ | (x_ >> i_ & uint128_t(1)) << k_++;
+            }
+            return res_;
+        });
+    }
+
+    // integer roots, digit counts and powers against Newton's iteration, division by the base and a product loop
+    void math_ops(reporter &rep_, const options &opt_, const operands &set_) {
+        measure<uint128_t>(rep_, opt_, "isqrt", "math", set_, [](uint128_t x_, uint128_t) {
+            return uint128_t(large_int::isqrt(x_));
+        });
+        measure<uint128_t>(rep_, opt_, "isqrt", "loop", set_, [](uint128_t x_, uint128_t) {
+            return uint128_t(large_int::detail_::isqrt_newton_(x_));
+        });
+        measure<uint128_t>(rep_, opt_, "icbrt", "math", set_, [](uint128_t x_, uint128_t) {
+            return uint128_t(large_int::icbrt(x_));
+        });
+        measure<uint128_t>(rep_, opt_, "icbrt", "loop", set_, [](uint128_t x_, uint128_t) {
+            return uint128_t(large_int::detail_::icbrt_newton_(x_));
+        });
+        measure<uint128_t>(rep_, opt_, "num_digits", "math", set_, [](uint128_t x_, uint128_t) {
+            return uint128_t(large_int::num_digits(x_));
+        });
+        measure<uint128_t>(rep_, opt_, "num_digits", "loop", set_, [](uint128_t x_, uint128_t) {
+            unsigned n_ = 1;
+            for (; x_ >= uint128_t(10); x_ /= uint128_t(10)) ++n_;
+            return uint128_t(n_);
+        });
+        measure<uint128_t>(rep_, opt_, "ipow", "math", set_, [](uint128_t x_, uint128_t y_) {
+            uint128_t res_;
+            return large_int::ipow_overflow(x_ & uint128_t(0xff), static_cast<unsigned>(y_ & uint128_t(31)), res_)
+                   ? ~res_ : res_;
+        });
+        measure<uint128_t>(rep_, opt_, "ipow", "loop", set_, [](uint128_t x_, uint128_t y_) {
+            uint128_t res_(1), base_ = x_ & uint128_t(0xff);
+            bool over_ = false;
+            for (auto n_ = static_cast<unsigned>(y_ & uint128_t(31)); n_; --n_) over_ |= mul_overflow(res_, base_, res_);
+            return over_ ? ~res_ : res_;
+        });
+        measure<uint128_t>(rep_, opt_, "gcd", "math", set_, [](uint128_t x_, uint128_t y_) {
+            return large_int::gcd(x_, y_);
+        });
+        measure<uint128_t>(rep_, opt_, "extended_gcd", "math", set_, [](uint128_t x_, uint128_t y_) {
+            auto res_ = large_int::extended_gcd(x_, y_);
+            return res_.gcd + uint128_t(res_.x) + uint128_t(res_.y);
+        });
+        measure<uint128_t>(rep_, opt_, "extended_gcd", "loop", set_, [](uint128_t x_, uint128_t y_) {
+            uint128_t s0_(1), s1_(0), t0_(0), t1_(1);
+            while (y_) {
+                auto qr_ = divmod(x_, y_);
+                auto s2_ = s0_ - qr_.quot * s1_, t2_ = t0_ - qr_.quot * t1_;
+                x_ = y_;
+                y_ = qr_.rem;
+                s0_ = s1_;
+                s1_ = s2_;
+                t0_ = t1_;
+                t1_ = t2_;
+            }
+            return x_ + s0_ + t0_;
+        });
+    }
+
+#if __SIZEOF_INT128__ == 16
+
+    void raw_ops(reporter &rep_, const options &opt_, const operands &set_) {
+        typedef unsigned __int128 _Ut;
+        typedef __int128 _St;
+        const char *impl_ = "raw";
+        measure<_Ut>(rep_, opt_, "add", impl_, set_, [](_Ut x_, _Ut y_) { return x_ + y_; });
+        measure<_Ut>(rep_, opt_, "sub", impl_, set_, [](_Ut x_, _Ut y_) { return x_ - y_; });
+        measure<_Ut>(rep_, opt_, "mul", impl_, set_, [](_Ut x_, _Ut y_) { return x_ * y_; });
+        measure<_Ut>(rep_, opt_, "div", impl_, set_, [](_Ut x_, _Ut y_) { return x_ / y_; });
+        measure<_Ut>(rep_, opt_, "mod", impl_, set_, [](_Ut x_, _Ut y_) { return x_ % y_; });
+        measure<_St>(rep_, opt_, "sdiv", impl_, set_, [](_St x_, _St y_) { return x_ / y_; });
+        measure<_St>(rep_, opt_, "smod", impl_, set_, [](_St x_, _St y_) { return x_ % y_; });
+        measure<_Ut>(rep_, opt_, "shl", impl_, set_, [](_Ut x_, _Ut y_) { return x_ << (unsigned(y_) & 127U); });
+        measure<_Ut>(rep_, opt_, "shr", impl_, set_, [](_Ut x_, _Ut y_) { return x_ >> (unsigned(y_) & 127U); });
+        measure<_St>(rep_, opt_, "sar", impl_, set_, [](_St x_, _St y_) { return x_ >> (unsigned(y_) & 127U); });
+        measure<_Ut>(rep_, opt_, "cmp", impl_, set_, [](_Ut x_, _Ut y_) { return x_ < y_; });
+        measure<_St>(rep_, opt_, "scmp", impl_, set_, [](_St x_, _St y_) { return x_ < y_; });
+        measure<_Ut>(rep_, opt_, "to_double", impl_, set_, [](_Ut x_, _Ut) { return double(x_); });
+        measure<_St>(rep_, opt_, "sto_double", impl_, set_, [](_St x_, _St) { return double(x_); });
+        measure<_Ut>(rep_, opt_, "to_float", impl_, set_, [](_Ut x_, _Ut) { return float(x_); });
+        measure<_Ut>(rep_, opt_, "from_double", impl_, set_, [](_Ut x_, _Ut) {
+            return _Ut(std::ldexp(static_cast<double>(static_cast<uint64_t>(x_)), 60));
+        });
+    }
+
+#endif
+
+    // _Out per _In over the whole operand set in one call of fn_, rows are per value and the checksum agrees
+    // with the per value impls of the same op
+    template<class _Out, class _In, class _Fn>
+    void measure_batch(reporter &rep_, const options &opt_, const char *op_, const char *impl_, const operands &set_,
+                       const std::vector<_In> &in_, _Fn fn_) {
+        if (!rep_.wanted(op_)) return;
+        std::vector<_Out> out_(in_.size());
+        fn_(out_.data(), in_.data(), in_.size());
+        uint64_t sum_ = 0;
+        for (auto &v_ : out_) fold(sum_, v_);
+        uint64_t sink_ = 0;
+        auto start_ = std::chrono::steady_clock::now();
+        for (unsigned r_ = 0; r_ < opt_.reps; ++r_) {
+            fn_(out_.data(), opaque(in_.data()), in_.size());
+            fold(sink_, out_[r_ % out_.size()]);
+        }
+        std::chrono::duration<double, std::nano> elapsed_ = std::chrono::steady_clock::now() - start_;
+        sink = sink_;
+        rep_.row(op_, impl_, set_.name, elapsed_.count() / double(opt_.reps * in_.size()), sum_);
+    }
+
+    // to_float_batch and from_float_batch against the same loops of casts, "batch_scalar", and the dispatched
+    // kernel, "batch"
+    void float_batch_ops(reporter &rep_, const options &opt_, const operands &set_) {
+        namespace dt = large_int::detail_;
+        std::vector<uint128_t> u_(set_.lhs);
+        std::vector<int128_t> s_(set_.lhs.begin(), set_.lhs.end());
+        std::vector<double> d_(set_.lhs.size());
+        for (std::size_t i_ = 0; i_ < d_.size(); ++i_) {
+            d_[i_] = std::ldexp(static_cast<double>(static_cast<uint64_t>(set_.lhs[i_])), 60);
+        }
+        measure_batch<double>(rep_, opt_, "to_double", "batch_scalar", set_, u_, dt::to_float_scalar_<double, uint128_t>);
+        measure_batch<double>(rep_, opt_, "to_double", "batch", set_, u_, [](double *out_, const uint128_t *in_,
+                                                                             std::size_t n_) {
+            large_int::to_float_batch(out_, in_, n_);
+        });
+        measure_batch<double>(rep_, opt_, "sto_double", "batch_scalar", set_, s_, dt::to_float_scalar_<double, int128_t>);
+        measure_batch<double>(rep_, opt_, "sto_double", "batch", set_, s_, [](double *out_, const int128_t *in_,
+                                                                              std::size_t n_) {
+            large_int::to_float_batch(out_, in_, n_);
+        });
+        measure_batch<float>(rep_, opt_, "to_float", "batch_scalar", set_, u_, dt::to_float_scalar_<float, uint128_t>);
+        measure_batch<float>(rep_, opt_, "to_float", "batch", set_, u_, [](float *out_, const uint128_t *in_,
+                                                                           std::size_t n_) {
+            large_int::to_float_batch(out_, in_, n_);
+        });
+        measure_batch<uint128_t>(rep_, opt_, "from_double", "batch_scalar", set_, d_,
+                                 dt::from_float_scalar_<double, uint128_t>);
+        measure_batch<uint128_t>(rep_, opt_, "from_double", "batch", set_, d_, [](uint128_t *out_, const double *in_,
+                                                                                  std::size_t n_) {
+            large_int::from_float_batch(out_, in_, n_);
+        });
+    }
+
+    struct grouping : std::numpunct<char> {
+        char do_thousands_sep() const override { return ','; }
+
+        std::string do_grouping() const override { return "\3"; }
+    };
+
+    // print_value in each base, then decimal through a grouping locale, showbase and a padded width
+    void print_ops(reporter &rep_, const options &opt_, const operands &set_) {
+        struct {
+            const char *op;
+            std::ios::fmtflags flags;
+            bool grouped;
+        } cases_[] = {
+                {"print_dec", std::ios::dec, false},
+                {"print_hex", std::ios::hex | std::ios::showbase, false},
+                {"print_oct", std::ios::oct, false},
+                {"print_grouped", std::ios::dec, true},
+        };
+        for (auto &c_ : cases_) {
+            std::ostringstream os_;
+            if (c_.grouped) os_.imbue(std::locale(os_.getloc(), new grouping));
+            os_.flags(c_.flags);
+            measure<int128_t>(rep_, opt_, c_.op, "operator", set_, [&os_](int128_t x_, int128_t) {
+                os_.str(std::string());
+                os_ << x_;
+                return uint128_t(os_.str().size());
+            });
+        }
+    }
+
+    bool parse(int argc, char *argv[], options &opt_) {
+        for (int i_ = 1; i_ < argc; ++i_) {
+            std::string arg_ = argv[i_];
+            auto eq_ = arg_.find('=');
+            auto key_ = arg_.substr(0, eq_), value_ = eq_ == std::string::npos ? std::string() : arg_.substr(eq_ + 1);
+            if (key_ == "--format" && (value_ == "csv" || value_ == "json")) {
+                opt_.json = value_ == "json";
+            } else if (key_ == "--n" && std::strtoull(value_.c_str(), nullptr, 10)) {
+                opt_.n = std::strtoull(value_.c_str(), nullptr, 10);
+            } else if (key_ == "--reps" && std::strtoul(value_.c_str(), nullptr, 10)) {
+                opt_.reps = static_cast<unsigned>(std::strtoul(value_.c_str(), nullptr, 10));
+            } else if (key_ == "--filter") {
+                opt_.filter = value_;
+            } else if (key_ == "--output" && !value_.empty()) {
+                opt_.out = fopen(value_.c_str(), "w");
+                if (!opt_.out) {
+                    perror(value_.c_str());
+                    return false;
+                }
+            } else {
+                fprintf(stderr, "usage: %s [--format=csv|json] [--output=file] [--n=4096] [--reps=200] [--filter=op]\n",
+                        argv[0]);
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+int main(int argc, char *argv[]) {
+    options opt_;
+    if (!parse(argc, argv, opt_)) return 2;
+    auto sets_ = make_operands(opt_.n);
+    {
+        reporter rep_(opt_);
+        for (auto &s_ : sets_) {
+#if __SIZEOF_INT128__ == 16
+            delegate_ops<true>(rep_, opt_, "native", s_);
+            raw_ops(rep_, opt_, s_);
+#endif
+            delegate_ops<false>(rep_, opt_, "fallback", s_);
+            member_ops(rep_, opt_, s_);
+            bit_ops(rep_, opt_, s_);
+            math_ops(rep_, opt_, s_);
+            float_batch_ops(rep_, opt_, s_);
+            print_ops(rep_, opt_, s_);
+        }
+    }
+    if (opt_.out != stdout) fclose(opt_.out);
+#ifdef INT128_INSTRUMENT
+    large_int::instrument_dump(std::cerr, large_int::instrument_snapshot());
+#endif
+    return 0;
+}
@@ -0,0 +1,90 @@
+// ns per modular product and per powmod for 128-bit moduli: a 256-by-128 division per product (what % on the wide
+// product gives) against barrett_context and montgomery_context, then is_prime
+// g++ -std=c++11 -O2 -I src bench/modular.cpp -o modular_bench
+
+#include "int128_modular.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+    volatile uint64_t sink;
+
+    struct division_mod {
+        uint128_t mod;
+
+        explicit division_mod(uint128_t mod_) : mod(mod_) {}
+
+        uint128_t mul(uint128_t lhs_, uint128_t rhs_) const { return large_int::mulmod(lhs_, rhs_, mod); }
+
+        uint128_t powmod(uint128_t base_, uint128_t exp_) const {
+            uint128_t res_ = uint128_t(1) % mod;
+            for (base_ %= mod; exp_; exp_ >>= 1, base_ = mul(base_, base_)) {
+                if (exp_ & uint128_t(1)) res_ = mul(res_, base_);
+            }
+            return res_;
+        }
+    };
+
+    template<class _Fn>
+    double time_ns(std::size_t ops_, _Fn fn_) {
+        auto start_ = std::chrono::steady_clock::now();
+        sink = fn_();
+        std::chrono::duration<double, std::nano> elapsed_ = std::chrono::steady_clock::now() - start_;
+        return elapsed_.count() / double(ops_);
+    }
+
+    // a chain of dependent products, each one waits for the last, as inside powmod
+    template<class _Ctx>
+    double mul_chain(const std::vector<uint128_t> &mods_, std::size_t steps_) {
+        return time_ns(mods_.size() * steps_, [&] {
+            uint64_t sum_ = 0;
+            for (auto mod_ : mods_) {
+                _Ctx ctx_(mod_);
+                auto x_ = mod_ >> 1, y_ = mod_ / uint128_t(3);
+                for (std::size_t i_ = 0; i_ < steps_; ++i_) x_ = ctx_.mul(x_, y_);
+                sum_ += static_cast<uint64_t>(x_);
+            }
+            return sum_;
+        });
+    }
+
+    template<class _Ctx>
+    double pow_all(const std::vector<uint128_t> &mods_, const std::vector<uint128_t> &exps_) {
+        return time_ns(mods_.size(), [&] {
+            uint64_t sum_ = 0;
+            for (std::size_t i_ = 0; i_ < mods_.size(); ++i_) {
+                sum_ += static_cast<uint64_t>(_Ctx(mods_[i_]).powmod(mods_[i_] >> 3, exps_[i_]));
+            }
+            return sum_;
+        });
+    }
+}
+
+int main(int argc, char *argv[]) {
+    std::size_t n_ = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2000;
+    std::mt19937_64 rng_(42);
+    printf("%-10s %-12s %12s %12s %12s\n", "bits", "op", "division", "barrett", "montgomery");
+    for (int bits_ : {64, 96, 128}) {
+        std::vector<uint128_t> mods_(n_), exps_(n_);
+        for (std::size_t i_ = 0; i_ < n_; ++i_) {
+            mods_[i_] = (uint128_t(rng_()) << 64 | uint128_t(rng_())) >> (128 - bits_) | uint128_t(1) << (bits_ - 1) |
+                        uint128_t(1);
+            exps_[i_] = uint128_t(rng_()) << 64 | uint128_t(rng_());
+        }
+        printf("%-10d %-12s %12.1f %12.1f %12.1f\n", bits_, "mul chain", mul_chain<division_mod>(mods_, 256),
+               mul_chain<large_int::barrett_context>(mods_, 256), mul_chain<large_int::montgomery_context>(mods_, 256));
+        printf("%-10d %-12s %12.1f %12.1f %12.1f\n", bits_, "powmod", pow_all<division_mod>(mods_, exps_),
+               pow_all<large_int::barrett_context>(mods_, exps_), pow_all<large_int::montgomery_context>(mods_, exps_));
+        auto prime_ns_ = time_ns(n_, [&] {
+            uint64_t count_ = 0;
+            for (auto mod_ : mods_) count_ += large_int::is_prime(mod_);
+            return count_;
+        });
+        printf("%-10d %-12s %12.1f ns per odd candidate\n", bits_, "is_prime", prime_ns_);
+    }
+    return 0;
+}
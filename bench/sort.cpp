@@ -0,0 +1,77 @@
+// ns per key of std::sort, std::stable_sort, radix_sort, radix_sort with a 32-bit payload, radix_argsort and
+// parallel_radix_sort on every hardware thread, over full width, narrow and signed keys of each size
+// g++ -std=c++11 -O2 -pthread -I src bench/sort.cpp -o radix_sort_bench
+
+#include "int128_sort.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using large_int::int128_t;
+using large_int::uint128_t;
+
+namespace {
+    volatile uint64_t sink;
+
+    // fn_ reps_ times on a fresh copy of keys_, the copies are not timed
+    template<class _Key, class _Fn>
+    double time_ns(const std::vector<_Key> &keys_, unsigned reps_, _Fn fn_) {
+        std::vector<_Key> work_;
+        std::chrono::duration<double, std::nano> elapsed_(0);
+        for (unsigned r_ = 0; r_ < reps_; ++r_) {
+            work_ = keys_;
+            auto start_ = std::chrono::steady_clock::now();
+            fn_(work_);
+            elapsed_ += std::chrono::steady_clock::now() - start_;
+            sink = static_cast<uint64_t>(uint128_t(work_[work_.size() / 2]));
+        }
+        return elapsed_.count() / double(reps_ * keys_.size());
+    }
+
+    template<class _Key>
+    void row(const char *dist_, const std::vector<_Key> &keys_) {
+        auto n_ = keys_.size();
+        auto reps_ = static_cast<unsigned>(std::max<std::size_t>(1, (std::size_t(1) << 22) / n_));
+        std::vector<uint32_t> vals_(n_);
+        auto sort_ = time_ns(keys_, reps_, [](std::vector<_Key> &k_) { std::sort(k_.begin(), k_.end()); });
+        auto stable_ = time_ns(keys_, reps_, [](std::vector<_Key> &k_) { std::stable_sort(k_.begin(), k_.end()); });
+        auto radix_ = time_ns(keys_, reps_, [](std::vector<_Key> &k_) {
+            large_int::radix_sort(k_.data(), k_.data() + k_.size());
+        });
+        auto payload_ = time_ns(keys_, reps_, [&vals_](std::vector<_Key> &k_) {
+            large_int::radix_sort(k_.data(), k_.data() + k_.size(), vals_.data());
+        });
+        auto argsort_ = time_ns(keys_, reps_, [&vals_](std::vector<_Key> &k_) {
+            large_int::radix_argsort(k_.data(), k_.data() + k_.size(), vals_.data());
+        });
+        auto parallel_ = time_ns(keys_, reps_, [](std::vector<_Key> &k_) {
+            large_int::parallel_radix_sort(k_.data(), k_.data() + k_.size());
+        });
+        printf("%-8s %9zu %9.2f %9.2f %9.2f %9.2f %9.2f %9.2f\n", dist_, n_, sort_, stable_, radix_, payload_, argsort_,
+               parallel_);
+    }
+}
+
+int main(int argc, char *argv[]) {
+    std::size_t max_ = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    std::mt19937_64 rng_(42);
+    printf("%-8s %9s %9s %9s %9s %9s %9s %9s\n", "keys", "n", "std_sort", "stable", "radix", "payload", "argsort",
+           "parallel");
+    for (std::size_t n_ = 100; n_ <= max_; n_ *= 10) {
+        std::vector<uint128_t> random_(n_), narrow_(n_);
+        std::vector<int128_t> signed_(n_);
+        for (std::size_t i_ = 0; i_ < n_; ++i_) {
+            random_[i_] = uint128_t(rng_()) << 64 | uint128_t(rng_());
+            narrow_[i_] = uint128_t(rng_() >> 24);
+            signed_[i_] = int128_t(static_cast<int64_t>(rng_()) >> 16);
+        }
+        row("random", random_);
+        row("narrow", narrow_);
+        row("signed", signed_);
+    }
+    return 0;
+}
@@ -1,19 +1,86 @@
 #pragma once
 
-#include <cinttypes>
 #include <cmath>
 #include <cstdint>
 #include <cstring>
+#include <functional>
 #include <iostream>
 #include <limits>
 #include <locale>
 #include <string>
+#include <system_error>
 #include <type_traits>
 
+// constexpr where C++14 relaxes it, division, divmod and to_chars_constexpr then work in constant expressions
+#if __cplusplus >= 201402L
+#define INT128_CXX14_CONSTEXPR constexpr
+#else
+#define INT128_CXX14_CONSTEXPR inline
+#endif
+
 #ifndef __BYTE_ORDER__
 #error __BYTE_ORDER__ not defined
 #endif
 
+// 32-bit targets without __int128 multiply and divide on 32-bit limbs, -DINT128_LIMB32=0 keeps the 64-bit halves,
+// -DINT128_LIMB32=1 forces the limbs anywhere __int128 is undefined
+#ifndef INT128_LIMB32
+#if !defined(__SIZEOF_INT128__) && (__SIZEOF_POINTER__ == 4 || defined(_M_IX86) || defined(_M_ARM))
+#define INT128_LIMB32 1
+#else
+#define INT128_LIMB32 0
+#endif
+#endif
+
+// asm, intrinsics and floating point in a C++14 constexpr function only outside constant evaluation, which takes
+// __builtin_is_constant_evaluated; C++11 ones are plain inline
+#if __cplusplus < 201402L
+#define INT128_RUNTIME_PATHS 1
+#elif defined(__has_builtin)
+#if __has_builtin(__builtin_is_constant_evaluated)
+#define INT128_RUNTIME_PATHS 1
+#endif
+#endif
+
+// one divl per 64-by-32 step
+#if INT128_LIMB32 && defined(__i386__) && defined(__GNUC__) && defined(INT128_RUNTIME_PATHS)
+#define INT128_DIVL 1
+#endif
+
+// pdep and pext on each half with -mbmi2
+#if defined(__BMI2__) && defined(__x86_64__) && defined(__GNUC__) && defined(INT128_RUNTIME_PATHS)
+#define INT128_BMI2 1
+#endif
+
+// -DINT128_INSTRUMENT counts division, part_div and print_value per thread, see instrument_snapshot; without it the
+// hooks expand to nothing
+#ifdef INT128_INSTRUMENT
+#ifndef INT128_RUNTIME_PATHS
+#error INT128_INSTRUMENT takes __builtin_is_constant_evaluated with C++ 14
+#endif
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <vector>
+#if __cplusplus >= 201402L
+#define INT128_COUNT_(op_) \
+    do { if (!__builtin_is_constant_evaluated()) ::large_int::detail_::instrument_count_(op_); } while (0)
+#define INT128_INSTRUMENTED_(...) if (!__builtin_is_constant_evaluated()) return __VA_ARGS__;
+#else
+#define INT128_COUNT_(op_) ::large_int::detail_::instrument_count_(op_)
+#define INT128_INSTRUMENTED_(...) return __VA_ARGS__;
+#endif
+#define INT128_TIMER_(name_, op_) ::large_int::detail_::instrument_timer_ name_(op_)
+#define INT128_TIMER_OP_(name_, which_) name_.op_ = (which_)
+#define INT128_TIMER_STOP_(name_) name_.stop()
+#else
+#define INT128_COUNT_(op_) ((void) 0)
+#define INT128_INSTRUMENTED_(...)
+#define INT128_TIMER_(name_, op_) ((void) 0)
+#define INT128_TIMER_OP_(name_, which_) ((void) 0)
+#define INT128_TIMER_STOP_(name_) ((void) 0)
+#endif
+
 namespace large_int {
     template<class, class>
     class int128_base;
@@ -44,13 +111,264 @@ namespace large_int {
 
     constexpr int128_t operator<<(int128_t, int);
 
-    inline uint128_t operator/(uint128_t, uint128_t);
+    INT128_CXX14_CONSTEXPR uint128_t operator/(uint128_t, uint128_t);
+
+    INT128_CXX14_CONSTEXPR int128_t operator/(int128_t, int128_t);
+
+    INT128_CXX14_CONSTEXPR uint128_t operator%(uint128_t, uint128_t);
+
+    INT128_CXX14_CONSTEXPR int128_t operator%(int128_t, int128_t);
+
+    template<class _Tp>
+    struct divmod_result {
+        _Tp quot;
+        _Tp rem;
+    };
+
+    INT128_CXX14_CONSTEXPR divmod_result<uint128_t> divmod(uint128_t, uint128_t);
+
+    INT128_CXX14_CONSTEXPR divmod_result<int128_t> divmod(int128_t, int128_t);
+
+    enum class rounding {
+        toward_zero,
+        floor,
+        ceil,
+        half_up, // ties away from zero
+        half_even
+    };
+
+    struct to_chars_result {
+        char *ptr;
+        std::errc ec;
+    };
+
+    struct from_chars_result {
+        const char *ptr;
+        std::errc ec;
+    };
+
+#ifdef INT128_INSTRUMENT
+
+    // what INT128_INSTRUMENT counts. Division by the magnitudes of its operands: both in 64 bits, a 64-bit divisor, a
+    // wider divisor above the dividend, a wider divisor below it. print_* is the digits of each base, put_* the
+    // locale, grouping and padding after them, without and with grouping, the stream's write in neither.
+    enum class instrument_op : unsigned {
+        div_64, div_128_64, div_below, div_128,
+        mod_64, mod_128_64, mod_below, mod_128,
+        divmod_64, divmod_128_64, divmod_below, divmod_128,
+        part_div,
+        print_dec, print_hex, print_oct, print_fixed,
+        put_plain, put_grouped,
+        // counted, not timed: 128-by-64 steps of the fallback (64-by-32 digits with INT128_LIMB32), the corrections
+        // of their estimates, the corrections of a quotient by a two limb divisor
+        div_step, div_step_fix, div_quot_fix,
+        count_
+    };
+
+    // per instrument_op: calls, their total ticks and a histogram of bit_width(ticks), the last bucket taking the
+    // rest. Ticks are the time stamp counter on x86, nanoseconds elsewhere.
+    struct instrument_stats {
+        static constexpr unsigned ops = static_cast<unsigned>(instrument_op::count_);
+        static constexpr unsigned buckets = 32;
+
+        uint64_t count[ops];
+        uint64_t ticks[ops];
+        uint64_t histogram[ops][buckets];
+    };
+
+    namespace detail_ {
+        inline uint64_t instrument_ticks_() {
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+            return __builtin_ia32_rdtsc();
+#else
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+        }
+
+        // written by its thread only, relaxed loads and stores so snapshots of other threads may read it
+        struct instrument_block_ {
+            std::atomic<uint64_t> count_[instrument_stats::ops];
+            std::atomic<uint64_t> ticks_[instrument_stats::ops];
+            std::atomic<uint64_t> histogram_[instrument_stats::ops][instrument_stats::buckets];
+
+            instrument_block_();
+
+            ~instrument_block_();
+
+            void clear_() {
+                for (auto &c_ : count_) c_.store(0, std::memory_order_relaxed);
+                for (auto &t_ : ticks_) t_.store(0, std::memory_order_relaxed);
+                for (auto &h_ : histogram_) for (auto &c_ : h_) c_.store(0, std::memory_order_relaxed);
+            }
+
+            void add_to_(instrument_stats &to_) const {
+                for (unsigned i_ = 0; i_ < instrument_stats::ops; ++i_) {
+                    to_.count[i_] += count_[i_].load(std::memory_order_relaxed);
+                    to_.ticks[i_] += ticks_[i_].load(std::memory_order_relaxed);
+                    for (unsigned k_ = 0; k_ < instrument_stats::buckets; ++k_) {
+                        to_.histogram[i_][k_] += histogram_[i_][k_].load(std::memory_order_relaxed);
+                    }
+                }
+            }
+        };
+
+        // the blocks of running threads, and the sum of those that exited
+        struct instrument_registry_ {
+            std::mutex lock_;
+            std::vector<const instrument_block_ *> live_;
+            instrument_stats retired_{};
+
+            static instrument_registry_ &get_() {
+                static instrument_registry_ registry_;
+                return registry_;
+            }
+        };
+
+        inline instrument_block_::instrument_block_() {
+            clear_();
+            auto &reg_ = instrument_registry_::get_(); // constructed first, destroyed after every thread's block
+            std::lock_guard<std::mutex> guard_(reg_.lock_);
+            reg_.live_.push_back(this);
+        }
+
+        inline instrument_block_::~instrument_block_() {
+            auto &reg_ = instrument_registry_::get_();
+            std::lock_guard<std::mutex> guard_(reg_.lock_);
+            add_to_(reg_.retired_);
+            for (auto &p_ : reg_.live_) {
+                if (p_ == this) {
+                    p_ = reg_.live_.back();
+                    reg_.live_.pop_back();
+                    break;
+                }
+            }
+        }
+
+        inline instrument_block_ &instrument_local_() {
+            static thread_local instrument_block_ block_;
+            return block_;
+        }
+
+        inline void instrument_bump_(std::atomic<uint64_t> &cell_, uint64_t by_) {
+            cell_.store(cell_.load(std::memory_order_relaxed) + by_, std::memory_order_relaxed);
+        }
+
+        inline void instrument_count_(instrument_op op_) {
+            instrument_bump_(instrument_local_().count_[static_cast<unsigned>(op_)], 1);
+        }
+
+        inline void instrument_record_(instrument_op op_, uint64_t ticks_) {
+            auto &block_ = instrument_local_();
+            auto i_ = static_cast<unsigned>(op_);
+            auto k_ = ticks_ ? 64U - static_cast<unsigned>(__builtin_clzll(ticks_)) : 0U;
+            instrument_bump_(block_.count_[i_], 1);
+            instrument_bump_(block_.ticks_[i_], ticks_);
+            instrument_bump_(block_.histogram_[i_][k_ < instrument_stats::buckets ? k_ : instrument_stats::buckets - 1], 1);
+        }
+
+        // records the ticks from construction to stop() or destruction under op_, which may change before that
+        struct instrument_timer_ {
+            instrument_op op_;
+            uint64_t start_;
+            bool stopped_ = false;
+
+            explicit instrument_timer_(instrument_op which_) : op_(which_), start_(instrument_ticks_()) {}
+
+            instrument_timer_(const instrument_timer_ &) = delete;
+
+            instrument_timer_ &operator=(const instrument_timer_ &) = delete;
+
+            void stop() {
+                if (stopped_) return;
+                stopped_ = true;
+                instrument_record_(op_, instrument_ticks_() - start_);
+            }
+
+            ~instrument_timer_() { stop(); }
+        };
+    }
 
-    inline int128_t operator/(int128_t, int128_t);
+    inline const char *instrument_name(instrument_op op_) {
+        static const char *const names_[] = {
+                "div.64", "div.128/64", "div.below", "div.128/128",
+                "mod.64", "mod.128/64", "mod.below", "mod.128/128",
+                "divmod.64", "divmod.128/64", "divmod.below", "divmod.128/128",
+                "part_div",
+                "print.dec", "print.hex", "print.oct", "print.fixed",
+                "put.plain", "put.grouped",
+                "div.step", "div.step_fix", "div.quot_fix"};
+        static_assert(sizeof(names_) / sizeof(names_[0]) == instrument_stats::ops, "a name per instrument_op");
+        return op_ < instrument_op::count_ ? names_[static_cast<unsigned>(op_)] : "";
+    }
+
+    // the sum over every thread so far, exited ones included, running ones as of their last store
+    inline instrument_stats instrument_snapshot() {
+        auto &reg_ = detail_::instrument_registry_::get_();
+        std::lock_guard<std::mutex> guard_(reg_.lock_);
+        auto res_ = reg_.retired_;
+        for (auto block_ : reg_.live_) block_->add_to_(res_);
+        return res_;
+    }
+
+    // the calling thread only
+    inline instrument_stats instrument_thread_snapshot() {
+        instrument_stats res_{};
+        detail_::instrument_local_().add_to_(res_);
+        return res_;
+    }
+
+    // zeroes the calling thread and what exited threads left, a running thread's counts are its own to reset
+    inline void instrument_reset() {
+        detail_::instrument_local_().clear_();
+        auto &reg_ = detail_::instrument_registry_::get_();
+        std::lock_guard<std::mutex> guard_(reg_.lock_);
+        reg_.retired_ = instrument_stats{};
+    }
+
+    // a line per instrument_op that was counted: calls, mean ticks, and the bucket bounds of the median and the
+    // 99th percentile for the timed ones
+    inline std::ostream &instrument_dump(std::ostream &out_, const instrument_stats &stats_) {
+        for (unsigned i_ = 0; i_ < instrument_stats::ops; ++i_) {
+            if (!stats_.count[i_]) continue;
+            out_ << instrument_name(static_cast<instrument_op>(i_)) << ' ' << stats_.count[i_];
+            if (stats_.ticks[i_] || stats_.histogram[i_][0]) {
+                out_ << " mean " << double(stats_.ticks[i_]) / double(stats_.count[i_]);
+                uint64_t seen_ = 0;
+                auto p50_ = (stats_.count[i_] + 1) / 2, p99_ = stats_.count[i_] - stats_.count[i_] / 100;
+                for (unsigned k_ = 0; k_ < instrument_stats::buckets; ++k_) {
+                    auto before_ = seen_;
+                    seen_ += stats_.histogram[i_][k_];
+                    if (before_ < p50_ && seen_ >= p50_) out_ << " p50 < " << (UINT64_C(1) << k_);
+                    if (before_ < p99_ && seen_ >= p99_) out_ << " p99 < " << (UINT64_C(1) << k_);
+                }
+            }
+            out_ << '\n';
+        }
+        return out_;
+    }
+
+#endif
+
+    namespace detail_ {
+        // 2^64, exact in every floating point type
+        template<class _Tp>
+        constexpr _Tp two64_() { return _Tp(18446744073709551616.0L); }
 
-    inline uint128_t operator%(uint128_t, uint128_t);
+        // 2^127 for a signed high half, 2^128 otherwise
+        template<class _Hi>
+        constexpr long double float_upper_() {
+            return two64_<long double>() * two64_<long double>() / (std::is_signed<_Hi>::value ? 2 : 1);
+        }
 
-    inline int128_t operator%(int128_t, int128_t);
+        // where val_ truncated falls against the range of int128_base<_Hi, _Low>: -1 below, 1 above, 0 inside or NaN
+        template<class _Hi, class _Tp>
+        constexpr int float_side_(_Tp val_) {
+            return static_cast<long double>(val_) >= float_upper_<_Hi>() ? 1 :
+                   (std::is_signed<_Hi>::value ? static_cast<long double>(val_) < -float_upper_<_Hi>() : val_ <= _Tp(-1))
+                   ? -1 : 0;
+        }
+    }
 
     template<class _Hi, class _Low>
     class alignas(sizeof(_Hi) * 2) int128_base final {
@@ -111,9 +429,28 @@ namespace large_int {
         template<class _Tp>
         constexpr explicit int128_base(int128_base<_Tp, _Low> val_) : int128_base(val_.high_, val_.low_) {}
 
+        static constexpr int128_base from_limbs_(_Low high_, _Low low_, bool neg_) {
+            return neg_ ? int128_base(_Hi(~high_ + (low_ == 0)), _Low(-low_)) : int128_base(_Hi(high_), low_);
+        }
+
+        // mag_ / 2^64 and the remainder are exact, the integer part of mag_ past 2^64 has no fraction
+        template<class _Tp>
+        static constexpr int128_base from_float_(_Tp mag_, bool neg_) {
+            return from_limbs_(_Low(mag_ / detail_::two64_<_Tp>()),
+                               _Low(mag_ - _Tp(_Low(mag_ / detail_::two64_<_Tp>())) * detail_::two64_<_Tp>()), neg_);
+        }
+
+        // the largest value, or the smallest
+        static constexpr int128_base limit_(bool max_) {
+            return max_ ? int128_base(_Hi(~_Low(0) >> unsigned(std::is_signed<_Hi>::value)), ~_Low(0))
+                        : int128_base(_Hi(_Low(std::is_signed<_Hi>::value) << 63U), 0);
+        }
+
+        // truncates toward zero, NaN gives 0, out of range saturates
         template<class _Tp>
         constexpr int128_base(_Tp val_, float_tag) :
-                int128_base(_Hi(std::ldexp(val_, -64)) - (val_ < 0), _Low(val_)) {}
+                int128_base(detail_::float_side_<_Hi>(val_) ? limit_(detail_::float_side_<_Hi>(val_) > 0) :
+                            !(val_ == val_) ? int128_base() : from_float_(val_ < 0 ? -val_ : val_, val_ < 0)) {}
 
         constexpr explicit int128_base(float val_) : int128_base(val_, float_tag()) {}
 
@@ -197,24 +534,26 @@ namespace large_int {
 
         constexpr int128_base operator+() const { return *this; }
 
-        constexpr int128_base operator-() const { return int128_base(-high_ - (low_ != 0), -low_); }
+        // wraps through the unsigned half, so -INT128_MIN is INT128_MIN without overflowing the signed one, also in
+        // constant expressions
+        constexpr int128_base operator-() const { return int128_base(_Hi(-_Low(high_) - (low_ != 0)), -low_); }
 
         constexpr int128_base operator~() const { return int128_base(~high_, ~low_); }
 
         constexpr bool operator!() const { return !high_ && !low_; }
 
         // avoid self plus on rvalue
-        int128_base &operator++() &{ return *this = *this + int128_base(1); }
+        INT128_CXX14_CONSTEXPR int128_base &operator++() &{ return *this = *this + int128_base(1); }
 
-        int128_base &operator--() &{ return *this = *this - int128_base(1); }
+        INT128_CXX14_CONSTEXPR int128_base &operator--() &{ return *this = *this - int128_base(1); }
 
-        int128_base operator++(int) &{ // NOLINT returns non constant
+        INT128_CXX14_CONSTEXPR int128_base operator++(int) &{ // NOLINT returns non constant
             int128_base tmp = *this;
             ++*this;
             return tmp;
         }
 
-        int128_base operator--(int) &{ // NOLINT returns non constant
+        INT128_CXX14_CONSTEXPR int128_base operator--(int) &{ // NOLINT returns non constant
             int128_base tmp = *this;
             --*this;
             return tmp;
@@ -257,29 +596,29 @@ namespace large_int {
 
         friend constexpr int128_base operator>>(int128_base lhs_, int128_base rhs_) { return lhs_ >> (int) rhs_.low_; }
 
-        int128_base &operator+=(int128_base rhs_) &{ return *this = *this + rhs_; }
+        INT128_CXX14_CONSTEXPR int128_base &operator+=(int128_base rhs_) &{ return *this = *this + rhs_; }
 
-        int128_base &operator-=(int128_base rhs_) &{ return *this = *this - rhs_; }
+        INT128_CXX14_CONSTEXPR int128_base &operator-=(int128_base rhs_) &{ return *this = *this - rhs_; }
 
-        int128_base &operator*=(int128_base rhs_) &{ return *this = *this * rhs_; }
+        INT128_CXX14_CONSTEXPR int128_base &operator*=(int128_base rhs_) &{ return *this = *this * rhs_; }
 
-        int128_base &operator/=(int128_base rhs_) &{ return *this = *this / rhs_; }
+        INT128_CXX14_CONSTEXPR int128_base &operator/=(int128_base rhs_) &{ return *this = *this / rhs_; }
 
-        int128_base &operator%=(int128_base rhs_) &{ return *this = *this % rhs_; }
+        INT128_CXX14_CONSTEXPR int128_base &operator%=(int128_base rhs_) &{ return *this = *this % rhs_; }
 
-        int128_base &operator<<=(int128_base rhs_) &{ return *this = *this << rhs_; }
+        INT128_CXX14_CONSTEXPR int128_base &operator<<=(int128_base rhs_) &{ return *this = *this << rhs_; }
 
-        int128_base &operator>>=(int128_base rhs_) &{ return *this = *this >> rhs_; }
+        INT128_CXX14_CONSTEXPR int128_base &operator>>=(int128_base rhs_) &{ return *this = *this >> rhs_; }
 
-        int128_base &operator<<=(int rhs_) &{ return *this = *this << rhs_; }
+        INT128_CXX14_CONSTEXPR int128_base &operator<<=(int rhs_) &{ return *this = *this << rhs_; }
 
-        int128_base &operator>>=(int rhs_) &{ return *this = *this >> rhs_; }
+        INT128_CXX14_CONSTEXPR int128_base &operator>>=(int rhs_) &{ return *this = *this >> rhs_; }
 
-        int128_base &operator&=(int128_base rhs_) &{ return *this = *this & rhs_; }
+        INT128_CXX14_CONSTEXPR int128_base &operator&=(int128_base rhs_) &{ return *this = *this & rhs_; }
 
-        int128_base &operator|=(int128_base rhs_) &{ return *this = *this | rhs_; }
+        INT128_CXX14_CONSTEXPR int128_base &operator|=(int128_base rhs_) &{ return *this = *this | rhs_; }
 
-        int128_base &operator^=(int128_base rhs_) &{ return *this = *this ^ rhs_; }
+        INT128_CXX14_CONSTEXPR int128_base &operator^=(int128_base rhs_) &{ return *this = *this ^ rhs_; }
 
         template<class, class>
         friend
@@ -289,9 +628,17 @@ namespace large_int {
         friend
         struct clz_helper;
 
+        template<class>
+        friend
+        struct bit_helper;
+
         template<bool>
         friend
         struct detail_delegate;
+
+        friend class uint128_divider;
+
+        friend class int128_divider;
     };
 
     inline namespace literals {
@@ -382,11 +729,23 @@ namespace large_int {
 
     template<bool>
     struct detail_delegate {
+#if INT128_LIMB32
+
+        // both halves at once, the flags of the two compares combine without a branch
+        template<class _Hi, class _Low>
+        static constexpr bool cmp(int128_base<_Hi, _Low> lhs_, int128_base<_Hi, _Low> rhs_) {
+            return (lhs_.high_ < rhs_.high_) | ((lhs_.high_ == rhs_.high_) & (lhs_.low_ < rhs_.low_));
+        }
+
+#else
+
         template<class _Hi, class _Low>
         static constexpr bool cmp(int128_base<_Hi, _Low> lhs_, int128_base<_Hi, _Low> rhs_) {
             return lhs_.high_ < rhs_.high_ || (lhs_.high_ == rhs_.high_ && lhs_.low_ < rhs_.low_);
         }
 
+#endif
+
         static constexpr uint128_t shr(uint128_t lhs_, unsigned rhs_) {
             return rhs_ & 64U ? uint128_t(0, lhs_.high_ >> (rhs_ & 63U)) :
                    rhs_ & 63U ? uint128_t(lhs_.high_ >> (rhs_ & 63U),
@@ -400,6 +759,34 @@ namespace large_int {
                            (uint64_t(lhs_.high_) << (64 - (rhs_ & 63U)) | (lhs_.low_ >> (rhs_ & 63U)))) : lhs_;
         }
 
+#if INT128_LIMB32
+
+        // the 64x64 product from 32x32 ones: the middle column sums in 64 bits without overflow, its carry and the
+        // high halves of the cross products go to the top
+        static constexpr uint128_t mul64_cols_(uint64_t ll_, uint64_t lh_, uint64_t hl_, uint64_t hh_, uint64_t mid_) {
+            return uint128_t(hh_ + (lh_ >> 32U) + (hl_ >> 32U) + (mid_ >> 32U), mid_ << 32U | (ll_ & UINT64_C(0xffffffff)));
+        }
+
+        static constexpr uint128_t mul64_parts_(uint64_t ll_, uint64_t lh_, uint64_t hl_, uint64_t hh_) {
+            return mul64_cols_(ll_, lh_, hl_, hh_, (ll_ >> 32U) + (lh_ & UINT64_C(0xffffffff)) +
+                                                   (hl_ & UINT64_C(0xffffffff)));
+        }
+
+        static constexpr uint128_t mul64_(uint64_t lhs_, uint64_t rhs_) {
+            return mul64_parts_(uint64_t(uint32_t(lhs_)) * uint32_t(rhs_), uint64_t(uint32_t(lhs_)) * uint32_t(rhs_ >> 32U),
+                                uint64_t(uint32_t(lhs_ >> 32U)) * uint32_t(rhs_),
+                                uint64_t(uint32_t(lhs_ >> 32U)) * uint32_t(rhs_ >> 32U));
+        }
+
+        // four limb schoolbook, the low limbs in full and the cross terms only as far as they reach the low 128 bits
+        template<class _Hi, class _Low>
+        static constexpr int128_base<_Hi, _Low> imul(int128_base<_Hi, _Low> lhs_, int128_base<_Hi, _Low> rhs_) {
+            return int128_base<_Hi, _Low>(mul64_(lhs_.low_, rhs_.low_)) +
+                   int128_base<_Hi, _Low>(_Hi(lhs_.low_ * rhs_.high_ + rhs_.low_ * lhs_.high_), _Low(0));
+        }
+
+#else
+
         template<class _Hi, class _Low>
         static constexpr int128_base<_Hi, _Low> imul(int128_base<_Hi, _Low> lhs_, int128_base<_Hi, _Low> rhs_) {
             return int128_base<_Hi, _Low>(
@@ -409,6 +796,8 @@ namespace large_int {
                    + (int128_base<_Hi, _Low>((rhs_.low_ >> 32U) * (lhs_.low_ & half_mask<_Low>::value)) << 32U);
         }
 
+#endif
+
         template<class _Hi, class _Low>
         static constexpr int128_base<_Hi, _Low> shl(int128_base<_Hi, _Low> lhs_, unsigned rhs_) {
             // [64,127], 64 {low_ << 0, 0}
@@ -418,65 +807,262 @@ namespace large_int {
                            lhs_.low_ << (rhs_ & 63U)) : lhs_;
         }
 
-        static uint128_t &slow_div_(uint128_t &dividend_, uint128_t divisor_, uint128_t &quot_) {
-            // assert(divisor != uint128_t(0));
-            quot_ = uint128_t(0);
-            if (cmp(dividend_, divisor_)) return dividend_;
-            if (dividend_.high_ == 0) { // (0,x) / ???
-                quot_.low_ = dividend_.low_ / divisor_.low_;
-                dividend_.low_ %= divisor_.low_;
-                return dividend_;
-            }
-            auto zend_ = clz_helper<uint128_t>::clz(dividend_), zsor_ = clz_helper<uint128_t>::clz(divisor_);
-            if (zend_ > zsor_) return dividend_;
-            for (zsor_ -= zend_, divisor_ <<= zsor_;; divisor_ >>= 1, quot_ <<= 1) {
-                if (dividend_ >= divisor_) {
-                    dividend_ -= divisor_;
-                    quot_ |= uint128_t(1);
-                }
-                if (!zsor_--) return dividend_;
+#if !INT128_LIMB32
+
+        static constexpr uint128_t mul64_(uint64_t lhs_, uint64_t rhs_) { return imul(uint128_t(lhs_), uint128_t(rhs_)); }
+
+#endif
+
+        // 256 bits product, returns the high 128 bits
+        static uint128_t mul_wide(uint128_t lhs_, uint128_t rhs_, uint128_t &low_) {
+            auto ll_ = mul64_(lhs_.low_, rhs_.low_), lh_ = mul64_(lhs_.low_, rhs_.high_);
+            auto hl_ = mul64_(lhs_.high_, rhs_.low_), hh_ = mul64_(lhs_.high_, rhs_.high_);
+            auto mid_ = uint128_t(ll_.high_) + uint128_t(lh_.low_) + uint128_t(hl_.low_);
+            low_ = uint128_t(mid_.low_, ll_.low_);
+            return hh_ + uint128_t(lh_.high_) + uint128_t(hl_.high_) + uint128_t(mid_.high_);
+        }
+
+        static uint128_t mulhi(uint128_t lhs_, uint128_t rhs_) {
+            uint128_t low_;
+            return mul_wide(lhs_, rhs_, low_);
+        }
+
+        // the carry out of the high limb of operator+ and operator-
+        static bool add_overflow(uint128_t lhs_, uint128_t rhs_, uint128_t &res_) {
+            res_ = lhs_ + rhs_;
+            return cmp(res_, lhs_);
+        }
+
+        static bool sub_overflow(uint128_t lhs_, uint128_t rhs_, uint128_t &res_) {
+            res_ = lhs_ - rhs_;
+            return cmp(lhs_, rhs_);
+        }
+
+        // signed overflow iff the result sign differs from both operand signs
+        static bool add_overflow(int128_t lhs_, int128_t rhs_, int128_t &res_) {
+            res_ = lhs_ + rhs_;
+            return ((lhs_.high_ ^ res_.high_) & (rhs_.high_ ^ res_.high_)) < 0;
+        }
+
+        static bool sub_overflow(int128_t lhs_, int128_t rhs_, int128_t &res_) {
+            res_ = lhs_ - rhs_;
+            return ((lhs_.high_ ^ rhs_.high_) & (lhs_.high_ ^ res_.high_)) < 0;
+        }
+
+        // at most one high limb may be set, then the cross product must fit in the high limb
+        static bool mul_overflow(uint128_t lhs_, uint128_t rhs_, uint128_t &res_) {
+            auto ll_ = mul64_(lhs_.low_, rhs_.low_);
+            auto cross_ = mul64_(lhs_.high_, rhs_.low_) + mul64_(rhs_.high_, lhs_.low_);
+            res_ = uint128_t(ll_.high_ + cross_.low_, ll_.low_);
+            return (lhs_.high_ && rhs_.high_) || cross_.high_ || res_.high_ < ll_.high_;
+        }
+
+        static bool mul_overflow(int128_t lhs_, int128_t rhs_, int128_t &res_) {
+            bool neg_ = (lhs_.high_ ^ rhs_.high_) < 0;
+            uint128_t abs_;
+            auto over_ = mul_overflow(uint128_t(lhs_.high_ < 0 ? -lhs_ : lhs_),
+                                      uint128_t(rhs_.high_ < 0 ? -rhs_ : rhs_), abs_);
+            res_ = int128_t(neg_ ? -abs_ : abs_);
+            // the magnitude may reach 2^127 only for a negative product
+            return over_ || (abs_.high_ >> 63U && !(neg_ && abs_ == uint128_t(1) << 127));
+        }
+
+#if INT128_LIMB32
+
+#ifdef INT128_DIVL
+
+        static uint32_t divl_(uint64_t num_, uint32_t den_, uint32_t &rem_) {
+            uint32_t quot_;
+            __asm__("divl %4" : "=a"(quot_), "=d"(rem_) : "a"(uint32_t(num_)), "d"(uint32_t(num_ >> 32U)), "rm"(den_));
+            return quot_;
+        }
+
+#endif
+
+        // num_ / den_ for a quotient below 2^32, otherwise the compiler calls the 64-by-64 division of its runtime
+        static INT128_CXX14_CONSTEXPR uint32_t div64_32_(uint64_t num_, uint32_t den_, uint32_t &rem_) {
+#ifdef INT128_DIVL
+#if __cplusplus >= 201402L
+            if (!__builtin_is_constant_evaluated())
+#endif
+                return divl_(num_, den_, rem_);
+#endif
+            rem_ = uint32_t(num_ % den_);
+            return uint32_t(num_ / den_);
+        }
+
+        // one quotient digit of (num_ << 32 | next_) / div_ and its remainder, requires num_ < div_ and div_
+        // normalized. The estimate from the top digit of div_ is at most two too large.
+        static INT128_CXX14_CONSTEXPR uint32_t div_digit_(uint64_t num_, uint32_t next_, uint64_t div_, uint64_t &rem_) {
+            INT128_COUNT_(instrument_op::div_step);
+            auto vn1_ = uint32_t(div_ >> 32U), vn0_ = uint32_t(div_);
+            uint32_t q_ = 0xffffffff;
+            uint64_t rhat_ = 0;
+            if (uint32_t(num_ >> 32U) < vn1_) {
+                uint32_t r_ = 0;
+                q_ = div64_32_(num_, vn1_, r_);
+                rhat_ = r_;
+            } else { // num_ >> 32 == vn1_, the estimate would be 2^32 or more
+                rhat_ = num_ - uint64_t(q_) * vn1_;
+            }
+            while (!(rhat_ >> 32U) && uint64_t(q_) * vn0_ > (rhat_ << 32U | next_)) {
+                INT128_COUNT_(instrument_op::div_step_fix);
+                --q_;
+                rhat_ += vn1_;
+            }
+            rem_ = (num_ << 32U | next_) - uint64_t(q_) * div_;
+            return q_;
+        }
+
+        // (high_, low_) / div_ for a normalized div_ above high_, two digits
+        static INT128_CXX14_CONSTEXPR uint64_t div_norm_(uint64_t high_, uint64_t low_, uint64_t div_, uint64_t &rem_) {
+            uint64_t q1_ = div_digit_(high_, uint32_t(low_ >> 32U), div_, rem_);
+            return q1_ << 32U | div_digit_(rem_, uint32_t(low_), div_, rem_);
+        }
+
+        // (high_, low_) / div_, requires high_ < div_, Knuth D on 32-bit digits
+        static INT128_CXX14_CONSTEXPR uint64_t div_128_64_(uint64_t high_, uint64_t low_, uint64_t div_, uint64_t &rem_) {
+            auto shift_ = clz_helper<uint64_t>::clz(div_);
+            uint64_t r_ = 0;
+            auto q_ = div_norm_(shift_ ? high_ << shift_ | low_ >> (64 - shift_) : high_, low_ << shift_, div_ << shift_, r_);
+            rem_ = r_ >> shift_;
+            return q_;
+        }
+
+#else
+
+        // (high_, low_) / div_, requires high_ < div_, Knuth D on 32-bit digits with 64-by-32 steps
+        static INT128_CXX14_CONSTEXPR uint64_t div_128_64_(uint64_t high_, uint64_t low_, uint64_t div_, uint64_t &rem_) {
+            INT128_COUNT_(instrument_op::div_step);
+            constexpr uint64_t base_ = UINT64_C(1) << 32U;
+            auto shift_ = clz_helper<uint64_t>::clz(div_);
+            div_ <<= shift_; // normalize, top bit of divisor set
+            uint64_t vn1_ = div_ >> 32U, vn0_ = div_ & half_mask<uint64_t>::value;
+            uint64_t un32_ = shift_ ? high_ << shift_ | low_ >> (64 - shift_) : high_;
+            uint64_t un10_ = low_ << shift_;
+            uint64_t un1_ = un10_ >> 32U, un0_ = un10_ & half_mask<uint64_t>::value;
+
+            uint64_t q1_ = un32_ / vn1_, rhat_ = un32_ - q1_ * vn1_;
+            while (q1_ >= base_ || q1_ * vn0_ > (rhat_ << 32U | un1_)) { // at most twice
+                INT128_COUNT_(instrument_op::div_step_fix);
+                --q1_;
+                if ((rhat_ += vn1_) >= base_) break;
+            }
+            uint64_t un21_ = (un32_ << 32U | un1_) - q1_ * div_;
+
+            uint64_t q0_ = un21_ / vn1_;
+            rhat_ = un21_ - q0_ * vn1_;
+            while (q0_ >= base_ || q0_ * vn0_ > (rhat_ << 32U | un0_)) {
+                INT128_COUNT_(instrument_op::div_step_fix);
+                --q0_;
+                if ((rhat_ += vn1_) >= base_) break;
             }
+            rem_ = ((un21_ << 32U | un0_) - q0_ * div_) >> shift_;
+            return q1_ << 32U | q0_;
         }
 
-        static uint128_t div(uint128_t dividend_, uint128_t divisor_) {
+#endif
+
+        static INT128_CXX14_CONSTEXPR uint128_t divmod(uint128_t dividend_, uint128_t divisor_, uint128_t &rem_) {
             if (!divisor_) return {!!dividend_ / !!divisor_}; // raise signal SIGFPE
-            uint128_t quot_(0);
-            slow_div_(dividend_, divisor_, quot_);
-            return quot_;
+            uint64_t r_ = 0;
+#if INT128_LIMB32
+            if (!divisor_.high_) { // one limb divisor, all in digit steps, no 64-bit division of the runtime
+                auto shift_ = clz_helper<uint64_t>::clz(divisor_.low_);
+                auto div_ = divisor_.low_ << shift_;
+                auto top_ = shift_ ? dividend_.high_ >> (64 - shift_) : 0;
+                auto un_ = dividend_ << shift_;
+                uint64_t qh_ = 0;
+                if (top_ || un_.high_ >= div_) {
+                    qh_ = div_norm_(top_, un_.high_, div_, r_);
+                } else {
+                    r_ = un_.high_;
+                }
+                auto ql_ = div_norm_(r_, un_.low_, div_, r_);
+                rem_ = uint128_t(r_ >> shift_);
+                return {qh_, ql_};
+            }
+#else
+            if (!divisor_.high_) { // one limb divisor
+                if (!dividend_.high_) {
+                    rem_ = uint128_t(dividend_.low_ % divisor_.low_);
+                    return uint128_t(dividend_.low_ / divisor_.low_);
+                }
+                uint64_t qh_ = 0, hi_ = dividend_.high_;
+                if (hi_ >= divisor_.low_) {
+                    qh_ = hi_ / divisor_.low_;
+                    hi_ -= qh_ * divisor_.low_;
+                }
+                auto ql_ = div_128_64_(hi_, dividend_.low_, divisor_.low_, r_);
+                rem_ = uint128_t(r_);
+                return {qh_, ql_};
+            }
+#endif
+            if (cmp(dividend_, divisor_)) {
+                rem_ = dividend_;
+                return uint128_t(0);
+            }
+            // two limb divisor, quotient fits in one limb: estimate with the normalized top limb, then correct
+            auto shift_ = clz_helper<uint64_t>::clz(divisor_.high_);
+            auto u_ = dividend_ >> 1;
+            auto q_ = div_128_64_(u_.high_, u_.low_, (divisor_ << shift_).high_, r_) >> (63 - shift_);
+            if (q_) --q_; // now exact or one too small
+            rem_ = dividend_ - uint128_t(q_) * divisor_;
+            if (!cmp(rem_, divisor_)) {
+                INT128_COUNT_(instrument_op::div_quot_fix);
+                ++q_;
+                rem_ -= divisor_;
+            }
+            return uint128_t(q_);
         }
 
-        static int128_t div(int128_t dividend_, int128_t divisor_) {
+        static INT128_CXX14_CONSTEXPR int128_t divmod(int128_t dividend_, int128_t divisor_, int128_t &rem_) {
             bool nneg_ = dividend_.high_ < 0, dneg_ = divisor_.high_ < 0;
-            auto res_ = div(uint128_t(nneg_ ? -dividend_ : dividend_), uint128_t(dneg_ ? -divisor_ : divisor_));
+            uint128_t r_;
+            auto res_ = divmod(uint128_t(nneg_ ? -dividend_ : dividend_), uint128_t(dneg_ ? -divisor_ : divisor_), r_);
+            rem_ = int128_t(nneg_ ? -r_ : r_);
             return int128_t(nneg_ ^ dneg_ ? -res_ : res_);
         }
 
-        static uint128_t mod(uint128_t dividend_, uint128_t divisor_) {
-            if (!divisor_) return {!!dividend_ % !!divisor_}; // raise signal SIGFPE
-            uint128_t quot_(0);
-            return slow_div_(dividend_, divisor_, quot_);
+        template<class _Hi, class _Low>
+        static INT128_CXX14_CONSTEXPR int128_base<_Hi, _Low>
+        div(int128_base<_Hi, _Low> dividend_, int128_base<_Hi, _Low> divisor_) {
+            int128_base<_Hi, _Low> rem_;
+            return divmod(dividend_, divisor_, rem_);
+        }
+
+        template<class _Hi, class _Low>
+        static INT128_CXX14_CONSTEXPR int128_base<_Hi, _Low>
+        mod(int128_base<_Hi, _Low> dividend_, int128_base<_Hi, _Low> divisor_) {
+            int128_base<_Hi, _Low> rem_;
+            divmod(dividend_, divisor_, rem_);
+            return rem_;
         }
 
-        static int128_t mod(int128_t dividend_, int128_t divisor_) {
-            bool neg_ = dividend_.high_ < 0;
-            auto res_ = mod(uint128_t(neg_ ? -dividend_ : dividend_),
-                            uint128_t(divisor_.high_ < 0 ? -divisor_ : divisor_));
-            return int128_t(neg_ ? -res_ : res_);
+        // the top 64 bits of val_ with the lowest or'ed with every bit below, shifted out by 64 - lz_
+        static constexpr uint64_t sticky_top_(uint128_t val_, int lz_) {
+            return (lz_ ? val_.high_ << lz_ | val_.low_ >> (64 - lz_) : val_.high_) | uint64_t(val_.low_ << lz_ != 0);
         }
 
-        static void part_div(uint128_t value_, uint64_t div_, uint64_t &high_, uint64_t &mid_, uint64_t &low_) {
-            uint128_t hh_(0), md_(0);
-            low_ = static_cast<uint64_t>(slow_div_(value_, div_, md_));
-            mid_ = static_cast<uint64_t>(slow_div_(md_, div_, hh_));
-            high_ = static_cast<uint64_t>(hh_);
+        // exact, a power of two in two steps for shift_ = 64
+        template<class _Tp>
+        constexpr static _Tp scale_(_Tp val_, int shift_) {
+            return val_ * _Tp(UINT64_C(1) << (shift_ - 1)) * _Tp(2);
         }
 
+        // rounded once: with at least 64 digits both halves are exact and only the sum rounds, with fewer the 64
+        // bits of sticky_top_ round just as val_ does, the sticky bit stays below the rounding position
         template<class _Tp>
-        constexpr static _Tp cast_to_float(uint128_t val_) { return std::ldexp(_Tp(val_.high_), 64) + _Tp(val_.low_); }
+        constexpr static _Tp cast_to_float(uint128_t val_) {
+            return !val_.high_ ? _Tp(val_.low_) :
+                   std::numeric_limits<_Tp>::digits >= 64 ? _Tp(val_.high_) * detail_::two64_<_Tp>() + _Tp(val_.low_) :
+                   scale_(_Tp(sticky_top_(val_, clz_helper<uint64_t>::clz(val_.high_))),
+                          64 - clz_helper<uint64_t>::clz(val_.high_));
+        }
 
         template<class _Tp>
         constexpr static _Tp cast_to_float(int128_t val_) {
-            return val_.high_ < 0 ? -cast_to_float<_Tp>(uint128_t(-val_)) : cast_to_float<_Tp>(uint128_t(val_));
+            return val_.high_ < 0 ? -cast_to_float<_Tp>(-uint128_t(val_)) : cast_to_float<_Tp>(uint128_t(val_));
         }
     };
 
@@ -518,6 +1104,65 @@ namespace large_int {
             return from_native(to_native(lhs_) << static_cast<decltype(to_native(lhs_))>(rhs_)); // NOLINT signed shift
         }
 
+        static constexpr uint128_t mul64_(uint64_t lhs_, uint64_t rhs_) {
+            return from_native(static_cast<tu_int_>(lhs_) * rhs_);
+        }
+
+        // 64x64 partial products, mul or mulx with -mbmi2
+        static uint128_t mul_wide(uint128_t lhs_, uint128_t rhs_, uint128_t &low_) {
+            auto ll_ = static_cast<tu_int_>(lhs_.low_) * rhs_.low_, lh_ = static_cast<tu_int_>(lhs_.low_) * rhs_.high_;
+            auto hl_ = static_cast<tu_int_>(lhs_.high_) * rhs_.low_, hh_ = static_cast<tu_int_>(lhs_.high_) * rhs_.high_;
+            auto mid_ = (ll_ >> 64U) + static_cast<uint64_t>(lh_) + static_cast<uint64_t>(hl_);
+            low_ = from_native(mid_ << 64U | static_cast<uint64_t>(ll_));
+            return from_native(hh_ + (lh_ >> 64U) + (hl_ >> 64U) + (mid_ >> 64U));
+        }
+
+        static uint128_t mulhi(uint128_t lhs_, uint128_t rhs_) {
+            uint128_t low_;
+            return mul_wide(lhs_, rhs_, low_);
+        }
+
+        template<class _Hi, class _Low>
+        static bool add_overflow(int128_base<_Hi, _Low> lhs_, int128_base<_Hi, _Low> rhs_,
+                                 int128_base<_Hi, _Low> &res_) {
+            decltype(to_native(lhs_)) val_;
+            auto over_ = __builtin_add_overflow(to_native(lhs_), to_native(rhs_), &val_);
+            res_ = from_native(val_);
+            return over_;
+        }
+
+        template<class _Hi, class _Low>
+        static bool sub_overflow(int128_base<_Hi, _Low> lhs_, int128_base<_Hi, _Low> rhs_,
+                                 int128_base<_Hi, _Low> &res_) {
+            decltype(to_native(lhs_)) val_;
+            auto over_ = __builtin_sub_overflow(to_native(lhs_), to_native(rhs_), &val_);
+            res_ = from_native(val_);
+            return over_;
+        }
+
+        template<class _Hi, class _Low>
+        static bool mul_overflow(int128_base<_Hi, _Low> lhs_, int128_base<_Hi, _Low> rhs_,
+                                 int128_base<_Hi, _Low> &res_) {
+            decltype(to_native(lhs_)) val_;
+            auto over_ = __builtin_mul_overflow(to_native(lhs_), to_native(rhs_), &val_);
+            res_ = from_native(val_);
+            return over_;
+        }
+
+        // (high_, low_) / div_, requires high_ < div_
+        static uint64_t div_128_64_(uint64_t high_, uint64_t low_, uint64_t div_, uint64_t &rem_) {
+#if defined(__x86_64__)
+            uint64_t quot_;
+            __asm__("divq %4" : "=a"(quot_), "=d"(rem_) : "a"(low_), "d"(high_), "rm"(div_));
+            return quot_;
+#else
+            auto value_ = static_cast<tu_int_>(high_) << 64U | low_;
+            auto quot_ = static_cast<uint64_t>(value_ / div_);
+            rem_ = low_ - quot_ * div_;
+            return quot_;
+#endif
+        }
+
         template<class _Hi, class _Low>
         static constexpr int128_base<_Hi, _Low> div(int128_base<_Hi, _Low> lhs_, int128_base<_Hi, _Low> rhs_) {
             return from_native(to_native(lhs_) / to_native(rhs_));
@@ -528,13 +1173,12 @@ namespace large_int {
             return from_native(to_native(lhs_) % to_native(rhs_));
         }
 
-        static void part_div(uint128_t value_, uint64_t div_, uint64_t &high_, uint64_t &mid_, uint64_t &low_) {
-            // on some cpu, compiler won't do optimize for us
-            auto vv_ = to_native(value_);
-            auto rest_ = vv_ / div_;
-            low_ = static_cast<uint64_t>(vv_) - div_ * static_cast<uint64_t>(rest_);
-            high_ = static_cast<uint64_t>(rest_ / div_);
-            mid_ = static_cast<uint64_t>(rest_) - div_ * high_;
+        template<class _Hi, class _Low>
+        static INT128_CXX14_CONSTEXPR int128_base<_Hi, _Low>
+        divmod(int128_base<_Hi, _Low> lhs_, int128_base<_Hi, _Low> rhs_, int128_base<_Hi, _Low> &rem_) {
+            auto quot_ = to_native(lhs_) / to_native(rhs_);
+            rem_ = from_native(to_native(lhs_) - quot_ * to_native(rhs_));
+            return from_native(quot_);
         }
 
         template<class _Tp, class _Hi, class _Low>
@@ -570,66 +1214,1213 @@ namespace large_int {
         return detail_delegate<>::shl(lhs_, static_cast<unsigned>(rhs_));
     }
 
-    inline uint128_t operator/(uint128_t lhs_, uint128_t rhs_) { return detail_delegate<>::div(lhs_, rhs_); };
+#ifdef INT128_INSTRUMENT
 
-    inline int128_t operator/(int128_t lhs_, int128_t rhs_) { return detail_delegate<>::div(lhs_, rhs_); };
+    namespace detail_ {
+        inline uint128_t instrument_abs_(uint128_t val_) { return val_; }
 
-    inline uint128_t operator%(uint128_t lhs_, uint128_t rhs_) { return detail_delegate<>::mod(lhs_, rhs_); };
+        inline uint128_t instrument_abs_(int128_t val_) { return val_ < int128_t(0) ? -uint128_t(val_) : uint128_t(val_); }
 
-    inline int128_t operator%(int128_t lhs_, int128_t rhs_) { return detail_delegate<>::mod(lhs_, rhs_); }
+        // the width class of lhs_ / rhs_ added to the first op of its group
+        template<class _Hi, class _Low>
+        inline instrument_op instrument_div_op_(instrument_op first_, int128_base<_Hi, _Low> lhs_,
+                                                int128_base<_Hi, _Low> rhs_) {
+            auto num_ = instrument_abs_(lhs_), den_ = instrument_abs_(rhs_);
+            unsigned class_ = !(den_ >> 64) ? !!(num_ >> 64) : num_ < den_ ? 2 : 3;
+            return static_cast<instrument_op>(static_cast<unsigned>(first_) + class_);
+        }
 
-    template<class _Hi, class _Low>
-    template<class _Tp>
-    constexpr _Tp int128_base<_Hi, _Low>::cast_to_float() const {
-        return detail_delegate<>::cast_to_float<_Tp>(*this);
+        template<class _Hi, class _Low>
+        inline int128_base<_Hi, _Low> instrument_div_(int128_base<_Hi, _Low> lhs_, int128_base<_Hi, _Low> rhs_) {
+            instrument_timer_ timer_(instrument_div_op_(instrument_op::div_64, lhs_, rhs_));
+            return detail_delegate<>::div(lhs_, rhs_);
+        }
+
+        template<class _Hi, class _Low>
+        inline int128_base<_Hi, _Low> instrument_mod_(int128_base<_Hi, _Low> lhs_, int128_base<_Hi, _Low> rhs_) {
+            instrument_timer_ timer_(instrument_div_op_(instrument_op::mod_64, lhs_, rhs_));
+            return detail_delegate<>::mod(lhs_, rhs_);
+        }
+
+        template<class _Hi, class _Low>
+        inline divmod_result<int128_base<_Hi, _Low> >
+        instrument_divmod_(int128_base<_Hi, _Low> lhs_, int128_base<_Hi, _Low> rhs_) {
+            instrument_timer_ timer_(instrument_div_op_(instrument_op::divmod_64, lhs_, rhs_));
+            divmod_result<int128_base<_Hi, _Low> > res_{};
+            res_.quot = detail_delegate<>::divmod(lhs_, rhs_, res_.rem);
+            return res_;
+        }
     }
 
-    template<class _CharT, class _Traits>
-    inline std::basic_ostream<_CharT, _Traits> &
-    print_value(std::basic_ostream<_CharT, _Traits> &out_, bool signed_integral_, uint128_t value_) {
-        constexpr std::size_t buf_size_ = 45;
+#endif
 
-        typename std::basic_ostream<_CharT, _Traits>::sentry sentry_(out_);
-        if (!sentry_) return out_;
-        auto flags_ = out_.flags(), base_flag_ = flags_ & std::ios::basefield;
-        auto adjust_field_ = flags_ & std::ios::adjustfield;
-        auto show_base_ = bool(flags_ & std::ios::showbase); // work not dec
-        auto show_pos_ = bool(flags_ & std::ios::showpos); // work only dec
-        auto upper_case_ = bool(flags_ & std::ios::uppercase); // work only hex
-        auto ns_ = out_.width(0);
-        auto fl_ = out_.fill();
+    INT128_CXX14_CONSTEXPR uint128_t operator/(uint128_t lhs_, uint128_t rhs_) {
+        INT128_INSTRUMENTED_(detail_::instrument_div_(lhs_, rhs_))
+        return detail_delegate<>::div(lhs_, rhs_);
+    }
 
-        char buf_[buf_size_];
-        char const *prefix_ = nullptr;
-        int offset_ = 0;
+    INT128_CXX14_CONSTEXPR int128_t operator/(int128_t lhs_, int128_t rhs_) {
+        INT128_INSTRUMENTED_(detail_::instrument_div_(lhs_, rhs_))
+        return detail_delegate<>::div(lhs_, rhs_);
+    }
 
-        switch (base_flag_) {
-            case std::ios::hex: {
-                if (show_base_ && value_) prefix_ = upper_case_ ? "0X" : "0x";
-                if (value_ >> 64) {
-                    offset_ = snprintf(buf_, buf_size_,
-                                       upper_case_ ? "%" PRIX64 "%016" PRIX64 : "%" PRIx64 "%016" PRIx64,
-                                       (uint64_t) (value_ >> 64), (uint64_t) value_);
-                } else {
-                    offset_ = snprintf(buf_, buf_size_,
-                                       upper_case_ ? "%" PRIX64 : "%" PRIx64, (uint64_t) value_);
-                }
-                break;
-            }
-            case std::ios::oct: {
-                constexpr uint64_t mask_ = (UINT64_C(1) << 63U) - 1;
-                if (show_base_ && value_) buf_[offset_++] = '0';
-                auto x_ = (uint64_t) (value_ >> 126U);
-                auto y_ = (uint64_t) (value_ >> 63U) & mask_;
-                auto z_ = (uint64_t) (value_) & mask_;
-                if (x_) {
-                    offset_ += snprintf(buf_ + offset_, buf_size_ - offset_, "%" PRIo64 "%021" PRIo64 "%021" PRIo64,
-                                        x_, y_, z_);
-                } else if (y_) {
-                    offset_ += snprintf(buf_ + offset_, buf_size_ - offset_, "%" PRIo64 "%021" PRIo64, y_, z_);
+    INT128_CXX14_CONSTEXPR uint128_t operator%(uint128_t lhs_, uint128_t rhs_) {
+        INT128_INSTRUMENTED_(detail_::instrument_mod_(lhs_, rhs_))
+        return detail_delegate<>::mod(lhs_, rhs_);
+    }
+
+    INT128_CXX14_CONSTEXPR int128_t operator%(int128_t lhs_, int128_t rhs_) {
+        INT128_INSTRUMENTED_(detail_::instrument_mod_(lhs_, rhs_))
+        return detail_delegate<>::mod(lhs_, rhs_);
+    }
+
+    // quotient and remainder of one division, same as (lhs_ / rhs_, lhs_ % rhs_)
+    INT128_CXX14_CONSTEXPR divmod_result<uint128_t> divmod(uint128_t lhs_, uint128_t rhs_) {
+        INT128_INSTRUMENTED_(detail_::instrument_divmod_(lhs_, rhs_))
+        divmod_result<uint128_t> res_{};
+        res_.quot = detail_delegate<>::divmod(lhs_, rhs_, res_.rem);
+        return res_;
+    }
+
+    INT128_CXX14_CONSTEXPR divmod_result<int128_t> divmod(int128_t lhs_, int128_t rhs_) {
+        INT128_INSTRUMENTED_(detail_::instrument_divmod_(lhs_, rhs_))
+        divmod_result<int128_t> res_{};
+        res_.quot = detail_delegate<>::divmod(lhs_, rhs_, res_.rem);
+        return res_;
+    }
+
+    // wrapped result in res_, returns true if it overflowed
+    inline bool add_overflow(uint128_t lhs_, uint128_t rhs_, uint128_t &res_) {
+        return detail_delegate<>::add_overflow(lhs_, rhs_, res_);
+    }
+
+    inline bool add_overflow(int128_t lhs_, int128_t rhs_, int128_t &res_) {
+        return detail_delegate<>::add_overflow(lhs_, rhs_, res_);
+    }
+
+    inline bool sub_overflow(uint128_t lhs_, uint128_t rhs_, uint128_t &res_) {
+        return detail_delegate<>::sub_overflow(lhs_, rhs_, res_);
+    }
+
+    inline bool sub_overflow(int128_t lhs_, int128_t rhs_, int128_t &res_) {
+        return detail_delegate<>::sub_overflow(lhs_, rhs_, res_);
+    }
+
+    inline bool mul_overflow(uint128_t lhs_, uint128_t rhs_, uint128_t &res_) {
+        return detail_delegate<>::mul_overflow(lhs_, rhs_, res_);
+    }
+
+    inline bool mul_overflow(int128_t lhs_, int128_t rhs_, int128_t &res_) {
+        return detail_delegate<>::mul_overflow(lhs_, rhs_, res_);
+    }
+
+    // clamped to the range of the type, max + 1 wraps to min for a negative bound
+    inline uint128_t add_sat(uint128_t lhs_, uint128_t rhs_) {
+        uint128_t res_;
+        return add_overflow(lhs_, rhs_, res_) ? ~uint128_t(0) : res_;
+    }
+
+    inline int128_t add_sat(int128_t lhs_, int128_t rhs_) {
+        int128_t res_;
+        return add_overflow(lhs_, rhs_, res_) ? int128_t((~uint128_t(0) >> 1) + (uint128_t(lhs_) >> 127)) : res_;
+    }
+
+    inline uint128_t sub_sat(uint128_t lhs_, uint128_t rhs_) {
+        uint128_t res_;
+        return sub_overflow(lhs_, rhs_, res_) ? uint128_t(0) : res_;
+    }
+
+    inline int128_t sub_sat(int128_t lhs_, int128_t rhs_) {
+        int128_t res_;
+        return sub_overflow(lhs_, rhs_, res_) ? int128_t((~uint128_t(0) >> 1) + (uint128_t(lhs_) >> 127)) : res_;
+    }
+
+    inline uint128_t mul_sat(uint128_t lhs_, uint128_t rhs_) {
+        uint128_t res_;
+        return mul_overflow(lhs_, rhs_, res_) ? ~uint128_t(0) : res_;
+    }
+
+    inline int128_t mul_sat(int128_t lhs_, int128_t rhs_) {
+        int128_t res_;
+        return mul_overflow(lhs_, rhs_, res_) ? int128_t((~uint128_t(0) >> 1) + (uint128_t(lhs_ ^ rhs_) >> 127)) : res_;
+    }
+
+    template<class>
+    struct bit_helper;
+
+    // each half one instruction where the target has it: popcnt, lzcnt and tzcnt with -mpopcnt and -mbmi, bswap,
+    // shld for the rotations, pdep and pext with -mbmi2
+    template<class _High, class _Low>
+    struct bit_helper<int128_base<_High, _Low> > {
+        typedef int128_base<_High, _Low> type;
+
+        // defined at 0, the compare folds into lzcnt and tzcnt
+        static constexpr int clz64_(_Low val_) { return val_ ? clz_helper<_Low>::clz(val_) : 64; }
+
+        static constexpr int ctz64_(_Low val_) { return val_ ? __builtin_ctzll(val_) : 64; }
+
+        static constexpr int popcount(type val_) {
+            return __builtin_popcountll(_Low(val_.high_)) + __builtin_popcountll(val_.low_);
+        }
+
+        static constexpr int countl_zero(type val_) {
+            return val_.high_ ? clz_helper<_Low>::clz(_Low(val_.high_)) : 64 + clz64_(val_.low_);
+        }
+
+        static constexpr int countr_zero(type val_) {
+            return val_.low_ ? __builtin_ctzll(val_.low_) : 64 + ctz64_(_Low(val_.high_));
+        }
+
+#if __SIZEOF_INT128__ == 16
+
+        // the compiler knows this one, two shld and a cmov
+        static constexpr type rotl(type val_, unsigned rhs_) {
+            return type(static_cast<unsigned __int128>(val_) << (rhs_ & 127U) |
+                        static_cast<unsigned __int128>(val_) >> ((0U - rhs_) & 127U));
+        }
+
+#else
+
+        // r_ in [0, 64), x >> 1 >> (63 - r_) is the x >> (64 - r_) of shld and 0 at r_ == 0
+        static constexpr type rotl_(_Low high_, _Low low_, unsigned r_) {
+            return type(_High(high_ << r_ | low_ >> 1U >> (63U - r_)), low_ << r_ | high_ >> 1U >> (63U - r_));
+        }
+
+        // swap_ is all ones to swap the halves first, for rhs_ in [64, 128)
+        static constexpr type rotl_swap_(_Low high_, _Low low_, _Low swap_, unsigned r_) {
+            return rotl_(high_ ^ ((high_ ^ low_) & swap_), low_ ^ ((high_ ^ low_) & swap_), r_);
+        }
+
+        static constexpr type rotl(type val_, unsigned rhs_) {
+            return rotl_swap_(_Low(val_.high_), val_.low_, 0 - _Low(rhs_ >> 6U & 1U), rhs_ & 63U);
+        }
+
+#endif
+
+        static constexpr type byteswap(type val_) {
+            return type(_High(__builtin_bswap64(val_.low_)), __builtin_bswap64(_Low(val_.high_)));
+        }
+
+        static INT128_CXX14_CONSTEXPR _Low pdep64_(_Low src_, _Low mask_) {
+#ifdef INT128_BMI2
+#if __cplusplus >= 201402L
+            if (!__builtin_is_constant_evaluated())
+#endif
+                return __builtin_ia32_pdep_di(src_, mask_);
+#endif
+            _Low res_ = 0;
+            for (; mask_; src_ >>= 1U, mask_ &= mask_ - 1) res_ |= mask_ & -mask_ & (0 - (src_ & 1U));
+            return res_;
+        }
+
+        static INT128_CXX14_CONSTEXPR _Low pext64_(_Low src_, _Low mask_) {
+#ifdef INT128_BMI2
+#if __cplusplus >= 201402L
+            if (!__builtin_is_constant_evaluated())
+#endif
+                return __builtin_ia32_pext_di(src_, mask_);
+#endif
+            _Low res_ = 0;
+            for (_Low bit_ = 1; mask_; bit_ <<= 1U, mask_ &= mask_ - 1) res_ |= bit_ & (0 - _Low(!!(src_ & mask_ & -mask_)));
+            return res_;
+        }
+
+        // the high half of mask_ takes the bits of src_ past the ones the low half used
+        static INT128_CXX14_CONSTEXPR type pdep(type src_, type mask_) {
+            return type(_High(pdep64_(_Low(src_ >> __builtin_popcountll(mask_.low_)), _Low(mask_.high_))),
+                        pdep64_(src_.low_, mask_.low_));
+        }
+
+        static INT128_CXX14_CONSTEXPR type pext(type src_, type mask_) {
+            return type(0, pext64_(src_.low_, mask_.low_)) |
+                   type(0, pext64_(_Low(src_.high_), _Low(mask_.high_))) << __builtin_popcountll(mask_.low_);
+        }
+    };
+
+    // <bit> for uint128_t, defined at 0; pdep and pext are constexpr from C++14
+    constexpr int popcount(uint128_t val_) { return bit_helper<uint128_t>::popcount(val_); }
+
+    constexpr int countl_zero(uint128_t val_) { return bit_helper<uint128_t>::countl_zero(val_); }
+
+    constexpr int countl_one(uint128_t val_) { return bit_helper<uint128_t>::countl_zero(~val_); }
+
+    constexpr int countr_zero(uint128_t val_) { return bit_helper<uint128_t>::countr_zero(val_); }
+
+    constexpr int countr_one(uint128_t val_) { return bit_helper<uint128_t>::countr_zero(~val_); }
+
+    constexpr bool has_single_bit(uint128_t val_) { return val_ && !(val_ & (val_ - uint128_t(1))); }
+
+    constexpr int bit_width(uint128_t val_) { return 128 - countl_zero(val_); }
+
+    constexpr uint128_t bit_floor(uint128_t val_) { return val_ ? uint128_t(1) << (bit_width(val_) - 1) : val_; }
+
+    // 0 above 2^127, where the power does not fit
+    constexpr uint128_t bit_ceil(uint128_t val_) {
+        return val_ > uint128_t(1) ? uint128_t(2) << (bit_width(val_ - uint128_t(1)) - 1) : uint128_t(1);
+    }
+
+    // a negative rhs_ rotates the other way
+    constexpr uint128_t rotl(uint128_t val_, int rhs_) {
+        return bit_helper<uint128_t>::rotl(val_, static_cast<unsigned>(rhs_));
+    }
+
+    constexpr uint128_t rotr(uint128_t val_, int rhs_) {
+        return bit_helper<uint128_t>::rotl(val_, 0U - static_cast<unsigned>(rhs_));
+    }
+
+    template<class _Hi, class _Low>
+    constexpr int128_base<_Hi, _Low> byteswap(int128_base<_Hi, _Low> val_) {
+        return bit_helper<int128_base<_Hi, _Low> >::byteswap(val_);
+    }
+
+    // the low bits of src_ deposited at the set bits of mask_, and back
+    INT128_CXX14_CONSTEXPR uint128_t pdep(uint128_t src_, uint128_t mask_) {
+        return bit_helper<uint128_t>::pdep(src_, mask_);
+    }
+
+    INT128_CXX14_CONSTEXPR uint128_t pext(uint128_t src_, uint128_t mask_) {
+        return bit_helper<uint128_t>::pext(src_, mask_);
+    }
+
+    template<class _Hi, class _Low>
+    template<class _Tp>
+    constexpr _Tp int128_base<_Hi, _Low>::cast_to_float() const {
+        return detail_delegate<>::cast_to_float<_Tp>(*this);
+    }
+
+    // res_ = val_ truncated toward zero, saturated as the constructor does, returns true if val_ is NaN or out of range
+    template<class _Tp, class _Hi, class _Low>
+    inline typename std::enable_if<std::is_floating_point<_Tp>::value, bool>::type
+    cast_overflow(_Tp val_, int128_base<_Hi, _Low> &res_) {
+        res_ = int128_base<_Hi, _Low>(val_);
+        return detail_::float_side_<_Hi>(val_) || !(val_ == val_);
+    }
+
+    namespace detail_ {
+        inline uint64_t hi64_(uint128_t val_) { return static_cast<uint64_t>(val_ >> 64); }
+
+        // Knuth D on 64-bit limbs, least significant limb first. u_ has _M limbs, v_ has n_ limbs with
+        // v_[n_ - 1] != 0 and n_ <= _M. q_ receives _M - n_ + 1 limbs, r_ unless null receives n_ limbs.
+        template<std::size_t _M>
+        inline void knuth_div_(const uint64_t *u_, const uint64_t *v_, std::size_t n_, uint64_t *q_, uint64_t *r_) {
+            uint64_t rhat_ = 0;
+            if (n_ == 1) {
+                for (auto j_ = _M; j_-- > 0;) q_[j_] = detail_delegate<>::div_128_64_(rhat_, u_[j_], v_[0], rhat_);
+                if (r_) r_[0] = rhat_;
+                return;
+            }
+            uint64_t un_[_M + 1], vn_[_M];
+            auto s_ = clz_helper<uint64_t>::clz(v_[n_ - 1]);
+            // normalize, x >> 1 >> (63 - s_) is x >> (64 - s_) without the undefined shift by 64
+            for (auto i_ = n_ - 1; i_ > 0; --i_) vn_[i_] = v_[i_] << s_ | v_[i_ - 1] >> 1U >> (63 - s_);
+            vn_[0] = v_[0] << s_;
+            un_[_M] = u_[_M - 1] >> 1U >> (63 - s_);
+            for (auto i_ = _M - 1; i_ > 0; --i_) un_[i_] = u_[i_] << s_ | u_[i_ - 1] >> 1U >> (63 - s_);
+            un_[0] = u_[0] << s_;
+
+            auto vtop_ = vn_[n_ - 1];
+            for (auto j_ = _M - n_ + 1; j_-- > 0;) {
+                uint64_t qhat_;
+                bool carry_ = false;
+                if (un_[j_ + n_] >= vtop_) { // only equal, estimate is base - 1
+                    qhat_ = ~UINT64_C(0);
+                    rhat_ = un_[j_ + n_ - 1] + vtop_;
+                    carry_ = rhat_ < vtop_;
                 } else {
-                    offset_ += snprintf(buf_ + offset_, buf_size_ - offset_, "%" PRIo64, z_);
+                    qhat_ = detail_delegate<>::div_128_64_(un_[j_ + n_], un_[j_ + n_ - 1], vtop_, rhat_);
+                }
+                while (!carry_ && detail_delegate<>::mul64_(qhat_, vn_[n_ - 2]) >
+                                  (uint128_t(rhat_) << 64 | uint128_t(un_[j_ + n_ - 2]))) {
+                    --qhat_;
+                    rhat_ += vtop_;
+                    carry_ = rhat_ < vtop_;
+                }
+
+                // multiply and subtract
+                uint64_t mul_carry_ = 0, borrow_ = 0;
+                for (std::size_t i_ = 0; i_ < n_; ++i_) {
+                    auto p_ = detail_delegate<>::mul64_(qhat_, vn_[i_]) + uint128_t(mul_carry_);
+                    auto pl_ = static_cast<uint64_t>(p_), t_ = un_[i_ + j_] - pl_;
+                    mul_carry_ = hi64_(p_);
+                    auto next_ = uint64_t(un_[i_ + j_] < pl_) | uint64_t(t_ < borrow_);
+                    un_[i_ + j_] = t_ - borrow_;
+                    borrow_ = next_;
+                }
+                auto top_ = un_[j_ + n_];
+                un_[j_ + n_] = top_ - mul_carry_ - borrow_;
+                if (top_ < mul_carry_ || top_ - mul_carry_ < borrow_) { // estimate one too large, add back
+                    --qhat_;
+                    uint64_t add_carry_ = 0;
+                    for (std::size_t i_ = 0; i_ < n_; ++i_) {
+                        auto sum_ = uint128_t(un_[i_ + j_]) + uint128_t(vn_[i_]) + uint128_t(add_carry_);
+                        un_[i_ + j_] = static_cast<uint64_t>(sum_);
+                        add_carry_ = hi64_(sum_);
+                    }
+                    un_[j_ + n_] += add_carry_;
+                }
+                q_[j_] = qhat_;
+            }
+            if (r_) {
+                for (std::size_t i_ = 0; i_ < n_; ++i_) r_[i_] = un_[i_] >> s_ | un_[i_ + 1] << 1U << (63 - s_);
+            }
+        }
+    }
+
+    template<class _Tp>
+    struct wide_result { // 256 bits two's complement
+        _Tp high;
+        uint128_t low;
+    };
+
+    inline wide_result<uint128_t> mul_wide(uint128_t lhs_, uint128_t rhs_) {
+        wide_result<uint128_t> res_;
+        res_.high = detail_delegate<>::mul_wide(lhs_, rhs_, res_.low);
+        return res_;
+    }
+
+    inline wide_result<int128_t> mul_wide(int128_t lhs_, int128_t rhs_) {
+        uint128_t low_;
+        auto high_ = detail_delegate<>::mul_wide(uint128_t(lhs_), uint128_t(rhs_), low_);
+        // unsigned product minus 2^128 times the other operand for each negative one
+        if (lhs_ < int128_t(0)) high_ -= uint128_t(rhs_);
+        if (rhs_ < int128_t(0)) high_ -= uint128_t(lhs_);
+        return {int128_t(high_), low_};
+    }
+
+    inline uint128_t mulhi(uint128_t lhs_, uint128_t rhs_) { return detail_delegate<>::mulhi(lhs_, rhs_); }
+
+    inline int128_t mulhi(int128_t lhs_, int128_t rhs_) { return mul_wide(lhs_, rhs_).high; }
+
+    namespace detail_ {
+        // low 128 bits of (high_, low_) / div_
+        inline uint128_t div_256_128_(uint128_t high_, uint128_t low_, uint128_t div_, uint128_t &rem_) {
+            if (!div_) return {!!div_ / !!div_}; // raise signal SIGFPE
+            uint64_t u_[4] = {static_cast<uint64_t>(low_), hi64_(low_), static_cast<uint64_t>(high_), hi64_(high_)};
+            uint64_t v_[2] = {static_cast<uint64_t>(div_), hi64_(div_)}, q_[4], r_[2] = {0, 0};
+            knuth_div_<4>(u_, v_, v_[1] ? 2 : 1, q_, r_);
+            rem_ = uint128_t(r_[1]) << 64 | uint128_t(r_[0]);
+            return uint128_t(q_[1]) << 64 | uint128_t(q_[0]);
+        }
+
+        // whether quot_ with remainder rem_ of a division by div_ moves one away from zero
+        inline bool round_away_(rounding mode_, bool neg_, uint128_t quot_, uint128_t rem_, uint128_t div_) {
+            if (!rem_) return false;
+            switch (mode_) {
+                case rounding::floor:
+                    return neg_;
+                case rounding::ceil:
+                    return !neg_;
+                case rounding::half_up:
+                    return rem_ >= div_ - rem_;
+                case rounding::half_even:
+                    return rem_ > div_ - rem_ || (rem_ == div_ - rem_ && (static_cast<unsigned>(quot_) & 1U));
+                default:
+                    return false;
+            }
+        }
+    }
+
+    // lhs_ * rhs_ / div_ with a 256 bits intermediate. The quotient must fit, otherwise its low 128 bits return.
+    inline uint128_t muldiv(uint128_t lhs_, uint128_t rhs_, uint128_t div_, rounding mode_ = rounding::toward_zero) {
+        auto prod_ = mul_wide(lhs_, rhs_);
+        uint128_t rem_;
+        auto quot_ = detail_::div_256_128_(prod_.high, prod_.low, div_, rem_);
+        return quot_ + uint128_t(detail_::round_away_(mode_, false, quot_, rem_, div_));
+    }
+
+    inline int128_t muldiv(int128_t lhs_, int128_t rhs_, int128_t div_, rounding mode_ = rounding::toward_zero) {
+        bool lneg_ = lhs_ < int128_t(0), rneg_ = rhs_ < int128_t(0), dneg_ = div_ < int128_t(0);
+        auto mag_ = uint128_t(dneg_ ? -div_ : div_);
+        auto prod_ = mul_wide(uint128_t(lneg_ ? -lhs_ : lhs_), uint128_t(rneg_ ? -rhs_ : rhs_));
+        uint128_t rem_;
+        auto quot_ = detail_::div_256_128_(prod_.high, prod_.low, mag_, rem_);
+        bool neg_ = lneg_ ^ rneg_ ^ dneg_;
+        quot_ += uint128_t(detail_::round_away_(mode_, neg_, quot_, rem_, mag_));
+        return int128_t(neg_ ? -quot_ : quot_);
+    }
+
+    namespace detail_ {
+        // both halves of the 64x64 product folded together
+        inline uint64_t mul_fold_(uint64_t lhs_, uint64_t rhs_) {
+            auto prod_ = detail_delegate<>::mul64_(lhs_, rhs_);
+            return static_cast<uint64_t>(prod_) ^ hi64_(prod_);
+        }
+    }
+
+    // two multiply-fold rounds, the second one mixes both halves again so a zero factor in the first round does
+    // not drop the high half. Not for adversarial keys, vary seed_ for that.
+    inline uint64_t hash128(uint128_t value_, uint64_t seed_ = 0) {
+        auto low_ = static_cast<uint64_t>(value_), high_ = detail_::hi64_(value_);
+        auto mix_ = detail_::mul_fold_(low_ ^ UINT64_C(0xa0761d6478bd642f), high_ ^ seed_ ^ UINT64_C(0xe7037ed1a0b428db));
+        return detail_::mul_fold_(mix_ ^ UINT64_C(0x8ebc6af09c88c6e3), low_ ^ high_ ^ UINT64_C(0x589965cc75374cc3));
+    }
+
+    inline uint64_t hash128(int128_t value_, uint64_t seed_ = 0) { return hash128(uint128_t(value_), seed_); }
+
+    // divisor with precomputed reciprocal, for dividing many values by the same runtime divisor
+    class uint128_divider {
+        enum kind_t_ : unsigned char {
+            shift_kind_, // power of two
+            limb_kind_, // divisor fits in 64 bits, 2-by-1 division by the normalized divisor with its reciprocal
+            magic_kind_, // multiply high by magic_, then shift
+            magic_add_kind_ // magic_ needs 129 bits, the top bit is added back
+        };
+
+        uint128_t div_, magic_;
+        unsigned shift_;
+        kind_t_ kind_;
+
+        // (high_, low_) / (div_.low_ << shift_), requires high_ < the normalized divisor
+        uint64_t div_limb_(uint64_t high_, uint64_t low_, uint64_t &rem_) const {
+            auto d_ = div_.low_ << shift_;
+            auto q_ = detail_delegate<>::mul64_(magic_.low_, high_) + uint128_t(high_, low_);
+            auto q1_ = q_.high_ + 1, r_ = low_ - q1_ * d_;
+            auto mask_ = -static_cast<uint64_t>(r_ > q_.low_);
+            q1_ += mask_;
+            r_ += mask_ & d_;
+            if (__builtin_expect(r_ >= d_, 0)) {
+                ++q1_;
+                r_ -= d_;
+            }
+            rem_ = r_;
+            return q1_;
+        }
+
+        uint128_t limb_divmod_(uint128_t value_, uint64_t &rem_) const {
+            auto high_ = div_limb_(value_.high_ >> 1U >> (63 - shift_),
+                                   value_.high_ << shift_ | value_.low_ >> 1U >> (63 - shift_), rem_);
+            auto low_ = div_limb_(rem_, value_.low_ << shift_, rem_);
+            rem_ >>= shift_;
+            return {high_, low_};
+        }
+
+    public:
+        explicit uint128_divider(uint128_t divisor_) : div_(divisor_), magic_(0), shift_(0), kind_(shift_kind_) {
+            if (!divisor_) {
+                div_ = uint128_t(!!divisor_ / !!divisor_); // raise signal SIGFPE
+                return;
+            }
+            if (!(divisor_ & (divisor_ - uint128_t(1)))) {
+                shift_ = 127 - clz_helper<uint128_t>::clz(divisor_);
+                return;
+            }
+            if (!divisor_.high_) {
+                kind_ = limb_kind_;
+                shift_ = clz_helper<uint64_t>::clz(divisor_.low_);
+                auto d_ = divisor_.low_ << shift_;
+                uint64_t rem_;
+                // floor((2^128 - 1) / d_) - 2^64
+                magic_ = uint128_t(detail_delegate<>::div_128_64_(~d_, ~UINT64_C(0), d_, rem_));
+                return;
+            }
+            // floor(2^(128 + k) / divisor_) with k = floor(log2(divisor_)), k >= 64
+            shift_ = 127 - clz_helper<uint128_t>::clz(divisor_);
+            uint64_t u_[4] = {0, 0, 0, UINT64_C(1) << (shift_ - 64)}, v_[2] = {divisor_.low_, divisor_.high_};
+            uint64_t q_[3], r_[2];
+            detail_::knuth_div_<4>(u_, v_, 2, q_, r_);
+            uint128_t proposed_(q_[1], q_[0]), rem_(r_[1], r_[0]);
+            if (divisor_ - rem_ < uint128_t(1) << shift_) {
+                kind_ = magic_kind_;
+            } else {
+                kind_ = magic_add_kind_;
+                proposed_ += proposed_;
+                auto twice_rem_ = rem_ + rem_;
+                if (twice_rem_ >= divisor_ || twice_rem_ < rem_) proposed_ += uint128_t(1);
+            }
+            magic_ = proposed_ + uint128_t(1);
+        }
+
+        uint128_t divisor() const { return div_; }
+
+        uint128_t divide(uint128_t value_) const {
+            switch (kind_) {
+                case shift_kind_:
+                    return value_ >> shift_;
+                case limb_kind_: {
+                    uint64_t rem_;
+                    return limb_divmod_(value_, rem_);
                 }
+                case magic_kind_:
+                    return detail_delegate<>::mulhi(magic_, value_) >> shift_;
+                default: {
+                    auto q_ = detail_delegate<>::mulhi(magic_, value_);
+                    return (((value_ - q_) >> 1) + q_) >> shift_;
+                }
+            }
+        }
+
+        divmod_result<uint128_t> divmod(uint128_t value_) const {
+            divmod_result<uint128_t> res_;
+            if (kind_ == limb_kind_) {
+                uint64_t rem_;
+                res_.quot = limb_divmod_(value_, rem_);
+                res_.rem = uint128_t(rem_);
+            } else {
+                res_.quot = divide(value_);
+                res_.rem = value_ - res_.quot * div_;
+            }
+            return res_;
+        }
+
+        // value_ = (high_ * divisor + mid_) * divisor + low_, requires a divisor fits in 64 bits and value_ / divisor^2 too
+        void part_div(uint128_t value_, uint64_t &high_, uint64_t &mid_, uint64_t &low_) const {
+            INT128_TIMER_(timer_, instrument_op::part_div);
+            if (kind_ == limb_kind_) {
+                high_ = limb_divmod_(limb_divmod_(value_, low_), mid_).low_;
+            } else {
+                auto rest_ = divmod(value_);
+                low_ = rest_.rem.low_;
+                rest_ = divmod(rest_.quot);
+                mid_ = rest_.rem.low_;
+                high_ = rest_.quot.low_;
+            }
+        }
+
+        friend uint128_t operator/(uint128_t lhs_, const uint128_divider &rhs_) { return rhs_.divide(lhs_); }
+
+        friend uint128_t operator%(uint128_t lhs_, const uint128_divider &rhs_) { return rhs_.divmod(lhs_).rem; }
+
+        friend uint128_t &operator/=(uint128_t &lhs_, const uint128_divider &rhs_) { return lhs_ = rhs_.divide(lhs_); }
+
+        friend uint128_t &operator%=(uint128_t &lhs_, const uint128_divider &rhs_) {
+            return lhs_ = rhs_.divmod(lhs_).rem;
+        }
+
+        friend divmod_result<uint128_t> divmod(uint128_t lhs_, const uint128_divider &rhs_) { return rhs_.divmod(lhs_); }
+    };
+
+    // signed divisor, truncates toward zero as operator/ does
+    class int128_divider {
+        uint128_divider abs_;
+        int128_t div_;
+
+        static uint128_t sign_mask_(int128_t val_) { return uint128_t(-uint64_t(val_.high_ < 0), -uint64_t(val_.high_ < 0)); }
+
+    public:
+        explicit int128_divider(int128_t divisor_) :
+                abs_(uint128_t(divisor_.high_ < 0 ? -divisor_ : divisor_)), div_(divisor_) {}
+
+        int128_t divisor() const { return div_; }
+
+        int128_t divide(int128_t value_) const {
+            auto mask_ = sign_mask_(value_), quot_mask_ = mask_ ^ sign_mask_(div_);
+            auto quot_ = abs_.divide((uint128_t(value_) ^ mask_) - mask_);
+            return int128_t((quot_ ^ quot_mask_) - quot_mask_);
+        }
+
+        divmod_result<int128_t> divmod(int128_t value_) const {
+            auto mask_ = sign_mask_(value_), quot_mask_ = mask_ ^ sign_mask_(div_);
+            auto res_ = abs_.divmod((uint128_t(value_) ^ mask_) - mask_);
+            divmod_result<int128_t> ret_;
+            ret_.quot = int128_t((res_.quot ^ quot_mask_) - quot_mask_);
+            ret_.rem = int128_t((res_.rem ^ mask_) - mask_);
+            return ret_;
+        }
+
+        friend int128_t operator/(int128_t lhs_, const int128_divider &rhs_) { return rhs_.divide(lhs_); }
+
+        friend int128_t operator%(int128_t lhs_, const int128_divider &rhs_) { return rhs_.divmod(lhs_).rem; }
+
+        friend int128_t &operator/=(int128_t &lhs_, const int128_divider &rhs_) { return lhs_ = rhs_.divide(lhs_); }
+
+        friend int128_t &operator%=(int128_t &lhs_, const int128_divider &rhs_) { return lhs_ = rhs_.divmod(lhs_).rem; }
+
+        friend divmod_result<int128_t> divmod(int128_t lhs_, const int128_divider &rhs_) { return rhs_.divmod(lhs_); }
+    };
+
+    namespace detail_ {
+        inline const char *lower_digits_() { return "0123456789abcdefghijklmnopqrstuvwxyz"; }
+
+        inline const char *upper_digits_() { return "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ"; }
+
+        inline const uint128_divider &ten19_divider_() {
+            static const uint128_divider ten19_(UINT64_C(10000000000000000000));
+            return ten19_;
+        }
+
+        inline const char *digit_pairs_() {
+            return "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+                   "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+                   "8081828384858687888990919293949596979899";
+        }
+
+        constexpr uint128_t pow10_(unsigned n_) { return n_ ? uint128_t(10) * pow10_(n_ - 1) : uint128_t(1); }
+
+        // 10^0 .. 10^19, then 10^19 .. 10^38, constants so count_digits_ is constexpr
+        template<class = void>
+        struct pow10_table_ {
+            static constexpr uint64_t low[20] = {
+                    UINT64_C(1), UINT64_C(10), UINT64_C(100), UINT64_C(1000), UINT64_C(10000), UINT64_C(100000),
+                    UINT64_C(1000000), UINT64_C(10000000), UINT64_C(100000000), UINT64_C(1000000000),
+                    UINT64_C(10000000000), UINT64_C(100000000000), UINT64_C(1000000000000),
+                    UINT64_C(10000000000000), UINT64_C(100000000000000), UINT64_C(1000000000000000),
+                    UINT64_C(10000000000000000), UINT64_C(100000000000000000), UINT64_C(1000000000000000000),
+                    UINT64_C(10000000000000000000)};
+            static constexpr uint128_t high[20] = {
+                    pow10_(19), pow10_(20), pow10_(21), pow10_(22), pow10_(23), pow10_(24), pow10_(25), pow10_(26),
+                    pow10_(27), pow10_(28), pow10_(29), pow10_(30), pow10_(31), pow10_(32), pow10_(33), pow10_(34),
+                    pow10_(35), pow10_(36), pow10_(37), pow10_(38)};
+        };
+
+        template<class _Tp>
+        constexpr uint64_t pow10_table_<_Tp>::low[20];
+
+        template<class _Tp>
+        constexpr uint128_t pow10_table_<_Tp>::high[20];
+
+        // t_ is the bit width times log10(2), the digits are t_ or one more
+        constexpr int count_digits_at_(uint64_t value_, int t_) { return t_ + (value_ >= pow10_table_<>::low[t_]); }
+
+        constexpr int count_digits_at_(uint128_t value_, int t_) {
+            return t_ + (value_ >= pow10_table_<>::high[t_ - 19]);
+        }
+
+        // 0 counts as one digit
+        constexpr int count_digits_(uint64_t value_) {
+            return count_digits_at_(value_ | 1U, (64 - clz_helper<uint64_t>::clz(value_ | 1U)) * 1233 >> 12);
+        }
+
+        constexpr int count_digits_(uint128_t value_) {
+            return !(value_ >> 64) ? count_digits_(static_cast<uint64_t>(value_))
+                                   : count_digits_at_(value_, (128 - clz_helper<uint128_t>::clz(value_)) * 1233 >> 12);
+        }
+
+        // digits of value_ in base 2^bits_, one for 0
+        constexpr int count_digits_pow2_(uint128_t value_, int bits_) {
+            return (bit_width(value_ | uint128_t(1)) + bits_ - 1) / bits_;
+        }
+
+        // decimal digits of value_ ending at last_, two digits per step, zero padded to width_
+        inline char *write_dec64_(char *last_, uint64_t value_, int width_) {
+            auto first_ = last_ - width_;
+            auto pairs_ = digit_pairs_();
+            while (value_ >= 100) {
+                auto idx_ = static_cast<unsigned>(value_ % 100) * 2;
+                value_ /= 100;
+                *--last_ = pairs_[idx_ + 1];
+                *--last_ = pairs_[idx_];
+            }
+            if (value_ >= 10) {
+                *--last_ = pairs_[value_ * 2 + 1];
+                *--last_ = pairs_[value_ * 2];
+            } else {
+                *--last_ = static_cast<char>('0' + value_);
+            }
+            while (last_ > first_) *--last_ = '0';
+            return last_;
+        }
+
+        // value_ written as exactly count_digits_(value_) decimal digits ending at last_
+        inline char *write_dec_(char *last_, uint128_t value_) {
+            if (!(value_ >> 64)) return write_dec64_(last_, static_cast<uint64_t>(value_), 0);
+            uint64_t high_, mid_, low_;
+            ten19_divider_().part_div(value_, high_, mid_, low_);
+            if (high_) return write_dec64_(write_dec64_(write_dec64_(last_, low_, 19), mid_, 19), high_, 0);
+            if (mid_) return write_dec64_(write_dec64_(last_, low_, 19), mid_, 0);
+            return write_dec64_(last_, low_, 0);
+        }
+
+        // digits of value_ in radix_ ending at last_, returns the first digit. No tables and no divider, so it works
+        // in constant expressions
+        INT128_CXX14_CONSTEXPR char *
+        write_chunked_(char *last_, uint128_t value_, unsigned radix_, const char *digits_) {
+            if (!(radix_ & (radix_ - 1))) {
+                auto bits_ = __builtin_ctz(radix_);
+                do {
+                    *--last_ = digits_[static_cast<unsigned>(value_) & (radix_ - 1)];
+                    value_ >>= bits_;
+                } while (value_);
+                return last_;
+            }
+            // peel chunks of the largest power of radix_ fits in 64 bits, then go on in 64-bit
+            uint64_t chunk_mul_ = radix_;
+            int chunk_len_ = 1;
+            while (chunk_mul_ <= ~UINT64_C(0) / radix_) chunk_mul_ *= radix_, ++chunk_len_;
+            while (value_ >> 64) {
+                auto qr_ = divmod(value_, uint128_t(chunk_mul_));
+                auto part_ = static_cast<uint64_t>(qr_.rem);
+                for (int i_ = 0; i_ < chunk_len_; ++i_, part_ /= radix_) *--last_ = digits_[part_ % radix_];
+                value_ = qr_.quot;
+            }
+            auto low_ = static_cast<uint64_t>(value_);
+            do {
+                *--last_ = digits_[low_ % radix_];
+                low_ /= radix_;
+            } while (low_);
+            return last_;
+        }
+
+        // decimal digits of value_ from buf_, zero padded to at least scale_ + 1 so the fixed point has an integer
+        // digit, returns how many
+        inline int write_fixed_(char *buf_, uint128_t value_, int scale_) {
+            auto len_ = count_digits_(value_);
+            if (len_ <= scale_) len_ = scale_ + 1;
+            for (auto p_ = write_dec_(buf_ + len_, value_); p_ != buf_;) *--p_ = '0';
+            return len_;
+        }
+
+        inline char *write_digits_(char *last_, uint128_t value_, unsigned radix_, const char *digits_) {
+            return radix_ == 10 ? write_dec_(last_, value_) : write_chunked_(last_, value_, radix_, digits_);
+        }
+
+        inline to_chars_result to_chars_(char *first_, char *last_, uint128_t value_, bool neg_, int base_,
+                                         const char *digits_) {
+            if (base_ == 10) { // exact size, written in place
+                auto len_ = count_digits_(value_) + neg_;
+                if (last_ - first_ < len_) return {last_, std::errc::value_too_large};
+                if (neg_) *first_ = '-';
+                write_dec_(first_ + len_, value_);
+                return {first_ + len_, std::errc()};
+            }
+            if (!(base_ & (base_ - 1))) { // exact size from the bit width too
+                auto len_ = count_digits_pow2_(value_, __builtin_ctz(static_cast<unsigned>(base_))) + neg_;
+                if (last_ - first_ < len_) return {last_, std::errc::value_too_large};
+                if (neg_) *first_ = '-';
+                write_chunked_(first_ + len_, value_, static_cast<unsigned>(base_), digits_);
+                return {first_ + len_, std::errc()};
+            }
+            char buf_[81]; // 81 ternary digits
+            auto end_ = buf_ + sizeof(buf_);
+            auto begin_ = write_digits_(end_, value_, static_cast<unsigned>(base_), digits_);
+            if (last_ - first_ < end_ - begin_ + neg_) return {last_, std::errc::value_too_large};
+            if (neg_) *first_++ = '-';
+            memcpy(first_, begin_, static_cast<std::size_t>(end_ - begin_));
+            return {first_ + (end_ - begin_), std::errc()};
+        }
+
+        INT128_CXX14_CONSTEXPR to_chars_result
+        to_chars_constexpr_(char *first_, char *last_, uint128_t value_, bool neg_, int base_) {
+            char buf_[128]{};
+            auto end_ = buf_ + sizeof(buf_);
+            auto begin_ = write_chunked_(end_, value_, static_cast<unsigned>(base_),
+                                         "0123456789abcdefghijklmnopqrstuvwxyz");
+            if (last_ - first_ < end_ - begin_ + neg_) return {last_, std::errc::value_too_large};
+            if (neg_) *first_++ = '-';
+            while (begin_ != end_) *first_++ = *begin_++;
+            return {first_, std::errc()};
+        }
+    }
+
+    // locale free, lower case digits, base_ in [2, 36]. Returns value_too_large and last_ if the buffer is short.
+    inline to_chars_result to_chars(char *first_, char *last_, uint128_t value_, int base_ = 10) {
+        return detail_::to_chars_(first_, last_, value_, false, base_, detail_::lower_digits_());
+    }
+
+    inline to_chars_result to_chars(char *first_, char *last_, int128_t value_, int base_ = 10) {
+        bool neg_ = value_ < int128_t(0);
+        return detail_::to_chars_(first_, last_, uint128_t(neg_ ? -value_ : value_), neg_, base_,
+                                  detail_::lower_digits_());
+    }
+
+    // to_chars for constant expressions under C++14, tables of names or keys built at compile time. Slower than
+    // to_chars at run time.
+    INT128_CXX14_CONSTEXPR to_chars_result
+    to_chars_constexpr(char *first_, char *last_, uint128_t value_, int base_ = 10) {
+        return detail_::to_chars_constexpr_(first_, last_, value_, false, base_);
+    }
+
+    INT128_CXX14_CONSTEXPR to_chars_result
+    to_chars_constexpr(char *first_, char *last_, int128_t value_, int base_ = 10) {
+        bool neg_ = value_ < int128_t(0);
+        return detail_::to_chars_constexpr_(first_, last_, neg_ ? -uint128_t(value_) : uint128_t(value_), neg_, base_);
+    }
+
+    // number of characters to_chars writes for value_ in decimal
+    constexpr int to_chars_size(uint128_t value_) { return detail_::count_digits_(value_); }
+
+    constexpr int to_chars_size(int128_t value_) {
+        return value_ < int128_t(0) ? 1 + detail_::count_digits_(-uint128_t(value_)) : detail_::count_digits_(uint128_t(value_));
+    }
+
+    namespace detail_ {
+        // the double estimate is within one of the root below 2^64, above it one Newton step takes its 52 good bits
+        // there, exact squares settle the last unit
+        inline uint64_t isqrt_float_(uint128_t value_) {
+            auto est_ = std::sqrt(static_cast<double>(value_));
+            auto root_ = est_ < two64_<double>() ? static_cast<uint64_t>(est_) : ~UINT64_C(0);
+            if (value_ >> 64) {
+                auto next_ = (uint128_t(root_) + value_ / uint128_t(root_)) >> 1;
+                root_ = next_ >> 64 ? ~UINT64_C(0) : static_cast<uint64_t>(next_);
+            }
+            while (detail_delegate<>::mul64_(root_, root_) > value_) --root_;
+            while (value_ - detail_delegate<>::mul64_(root_, root_) > uint128_t(root_) << 1) ++root_;
+            return root_;
+        }
+
+        // Newton from a power of two above the root comes down to its floor
+        INT128_CXX14_CONSTEXPR uint64_t isqrt_newton_(uint128_t value_) {
+            if (value_ < uint128_t(2)) return static_cast<uint64_t>(value_);
+            auto root_ = uint128_t(1) << ((bit_width(value_) + 1) / 2);
+            for (auto next_ = (root_ + value_ / root_) >> 1; next_ < root_; next_ = (root_ + value_ / root_) >> 1) {
+                root_ = next_;
+            }
+            return static_cast<uint64_t>(root_);
+        }
+
+        // floor(cbrt(2^128 - 1)), the largest root whose cube fits
+        constexpr uint64_t icbrt_max_() { return UINT64_C(6981463658331); }
+
+        inline uint128_t cube_(uint64_t root_) { return detail_delegate<>::mul64_(root_, root_) * uint128_t(root_); }
+
+        inline uint64_t icbrt_float_(uint128_t value_) {
+            auto root_ = static_cast<uint64_t>(std::cbrt(static_cast<double>(value_)));
+            if (root_ > icbrt_max_()) root_ = icbrt_max_();
+            while (cube_(root_) > value_) --root_;
+            while (root_ < icbrt_max_() && cube_(root_ + 1) <= value_) ++root_;
+            return root_;
+        }
+
+        INT128_CXX14_CONSTEXPR uint64_t icbrt_newton_(uint128_t value_) {
+            if (value_ < uint128_t(2)) return static_cast<uint64_t>(value_);
+            auto root_ = uint128_t(1) << ((bit_width(value_) + 2) / 3);
+            for (auto next_ = (root_ * uint128_t(2) + value_ / (root_ * root_)) / uint128_t(3); next_ < root_;
+                 next_ = (root_ * uint128_t(2) + value_ / (root_ * root_)) / uint128_t(3)) {
+                root_ = next_;
+            }
+            return static_cast<uint64_t>(root_);
+        }
+    }
+
+    // floor(sqrt(value_)), exact. Constant expressions take Newton's iteration, run time a double estimate and at
+    // most one 128-by-64 division.
+    INT128_CXX14_CONSTEXPR uint64_t isqrt(uint128_t value_) {
+#ifdef INT128_RUNTIME_PATHS
+#if __cplusplus >= 201402L
+        if (!__builtin_is_constant_evaluated())
+#endif
+            return detail_::isqrt_float_(value_);
+#endif
+        return detail_::isqrt_newton_(value_);
+    }
+
+    // floor(cbrt(value_)), exact, the same way with cbrt
+    INT128_CXX14_CONSTEXPR uint64_t icbrt(uint128_t value_) {
+#ifdef INT128_RUNTIME_PATHS
+#if __cplusplus >= 201402L
+        if (!__builtin_is_constant_evaluated())
+#endif
+            return detail_::icbrt_float_(value_);
+#endif
+        return detail_::icbrt_newton_(value_);
+    }
+
+    // floor(log2(value_)), -1 for 0
+    constexpr int ilog2(uint128_t value_) { return 127 - countl_zero(value_); }
+
+    // decimal digits, 1 for 0, from the bit width and one compare against a power of ten
+    constexpr int num_digits(uint128_t value_) { return detail_::count_digits_(value_); }
+
+    // floor(log10(value_)), -1 for 0
+    constexpr int ilog10(uint128_t value_) { return value_ ? detail_::count_digits_(value_) - 1 : -1; }
+
+    // digits in base_ in [2, 36], 1 for 0. Powers of two need the bit width only, others one division, then a
+    // product per digit.
+    INT128_CXX14_CONSTEXPR int num_digits(uint128_t value_, int base_) {
+        if (base_ == 10) return detail_::count_digits_(value_);
+        if (!(base_ & (base_ - 1))) return detail_::count_digits_pow2_(value_, __builtin_ctz(static_cast<unsigned>(base_)));
+        int len_ = 1;
+        for (uint128_t pow_(1), limit_ = value_ / uint128_t(base_); pow_ <= limit_; pow_ *= uint128_t(base_)) ++len_;
+        return len_;
+    }
+
+    // base_^exp_ wrapped to 128 bits, by squaring
+    constexpr uint128_t ipow(uint128_t base_, unsigned exp_) {
+        return exp_ ? (exp_ & 1U ? base_ : uint128_t(1)) * ipow(base_ * base_, exp_ >> 1U) : uint128_t(1);
+    }
+
+    constexpr int128_t ipow(int128_t base_, unsigned exp_) { return int128_t(ipow(uint128_t(base_), exp_)); }
+
+    // wrapped result in res_, returns true if base_^exp_ does not fit. A square that overflows counts only when a
+    // higher bit of exp_ still needs it.
+    inline bool ipow_overflow(uint128_t base_, unsigned exp_, uint128_t &res_) {
+        bool over_ = false;
+        res_ = uint128_t(1);
+        for (;;) {
+            if (exp_ & 1U) over_ |= mul_overflow(res_, base_, res_);
+            if (!(exp_ >>= 1U)) return over_;
+            over_ |= mul_overflow(base_, base_, base_);
+        }
+    }
+
+    inline bool ipow_overflow(int128_t base_, unsigned exp_, int128_t &res_) {
+        bool neg_ = base_ < int128_t(0) && (exp_ & 1U);
+        uint128_t mag_;
+        bool over_ = ipow_overflow(base_ < int128_t(0) ? -uint128_t(base_) : uint128_t(base_), exp_, mag_);
+        res_ = int128_t(neg_ ? -mag_ : mag_);
+        return over_ || mag_ > (uint128_t(1) << 127) - uint128_t(!neg_);
+    }
+
+    namespace detail_ {
+        // Stein on 64 bits for an odd lhs_. The smaller one and the difference come from a borrow mask, a branch
+        // there would be mispredicted half the time.
+        INT128_CXX14_CONSTEXPR uint64_t gcd64_(uint64_t lhs_, uint64_t rhs_) {
+            while (rhs_) {
+                rhs_ >>= __builtin_ctzll(rhs_);
+                auto mask_ = UINT64_C(0) - uint64_t(rhs_ < lhs_);
+                rhs_ -= lhs_;
+                lhs_ += rhs_ & mask_;
+                rhs_ = (rhs_ ^ mask_) - mask_;
+            }
+            return lhs_;
+        }
+
+        INT128_CXX14_CONSTEXPR uint128_t abs_(int128_t val_) {
+            return val_ < int128_t(0) ? -uint128_t(val_) : uint128_t(val_);
+        }
+    }
+
+    // Stein's binary gcd, shifts by the trailing zeros and subtractions, no division. 0 with 0 is 0.
+    INT128_CXX14_CONSTEXPR uint128_t gcd(uint128_t lhs_, uint128_t rhs_) {
+        if (!lhs_ || !rhs_) return lhs_ | rhs_;
+        auto shift_ = countr_zero(lhs_ | rhs_);
+        lhs_ >>= countr_zero(lhs_);
+        do {
+            rhs_ >>= countr_zero(rhs_);
+            auto mask_ = -uint128_t(rhs_ < lhs_);
+            rhs_ -= lhs_;
+            lhs_ += rhs_ & mask_;
+            rhs_ = (rhs_ ^ mask_) - mask_;
+            if (!((lhs_ | rhs_) >> 64)) { // the rest on 64 bits
+                return uint128_t(detail_::gcd64_(static_cast<uint64_t>(lhs_), static_cast<uint64_t>(rhs_))) << shift_;
+            }
+        } while (rhs_);
+        return lhs_ << shift_;
+    }
+
+    // of the magnitudes, as std::gcd, except that 2^127 wraps to INT128_MIN
+    INT128_CXX14_CONSTEXPR int128_t gcd(int128_t lhs_, int128_t rhs_) {
+        return int128_t(gcd(detail_::abs_(lhs_), detail_::abs_(rhs_)));
+    }
+
+    // wrapped to 128 bits, 0 if either is 0
+    INT128_CXX14_CONSTEXPR uint128_t lcm(uint128_t lhs_, uint128_t rhs_) {
+        return !lhs_ || !rhs_ ? uint128_t(0) : lhs_ / gcd(lhs_, rhs_) * rhs_;
+    }
+
+    INT128_CXX14_CONSTEXPR int128_t lcm(int128_t lhs_, int128_t rhs_) {
+        return int128_t(lcm(detail_::abs_(lhs_), detail_::abs_(rhs_)));
+    }
+
+    // wrapped result in res_, returns true if the lcm does not fit
+    inline bool lcm_overflow(uint128_t lhs_, uint128_t rhs_, uint128_t &res_) {
+        if (!lhs_ || !rhs_) {
+            res_ = uint128_t(0);
+            return false;
+        }
+        return mul_overflow(lhs_ / gcd(lhs_, rhs_), rhs_, res_);
+    }
+
+    inline bool lcm_overflow(int128_t lhs_, int128_t rhs_, int128_t &res_) {
+        uint128_t mag_;
+        bool over_ = lcm_overflow(detail_::abs_(lhs_), detail_::abs_(rhs_), mag_);
+        res_ = int128_t(mag_);
+        return over_ || mag_ >> 127;
+    }
+
+    // lhs_ * x + rhs_ * y == gcd. The coefficients are Euclid's, |x| <= rhs_ / (2 gcd) and |y| <= lhs_ / (2 gcd)
+    // unless one of them is 0 or divides the other, so they fit in int128_t for any uint128_t operands.
+    struct gcd_result {
+        uint128_t gcd;
+        int128_t x;
+        int128_t y;
+    };
+
+    // Euclid, a subtraction for a quotient of 1 and 64-bit divisions once both remainders fit, the coefficients
+    // wrapped to 128 bits on the way since only the last ones are bounded
+    INT128_CXX14_CONSTEXPR gcd_result extended_gcd(uint128_t lhs_, uint128_t rhs_) {
+        uint128_t r0_ = lhs_, r1_ = rhs_, s0_(1), s1_(0), t0_(0), t1_(1);
+        while (r1_) {
+            uint128_t q_(1), r2_ = r0_ - r1_;
+            if (!((r0_ | r1_) >> 64)) {
+                auto num_ = static_cast<uint64_t>(r0_), den_ = static_cast<uint64_t>(r1_);
+                q_ = uint128_t(num_ / den_);
+                r2_ = uint128_t(num_ % den_);
+            } else if (r0_ < r1_ || !(r2_ < r1_)) {
+                auto qr_ = divmod(r0_, r1_);
+                q_ = qr_.quot;
+                r2_ = qr_.rem;
+            }
+            auto s2_ = s0_ - q_ * s1_, t2_ = t0_ - q_ * t1_;
+            r0_ = r1_;
+            r1_ = r2_;
+            s0_ = s1_;
+            s1_ = s2_;
+            t0_ = t1_;
+            t1_ = t2_;
+        }
+        return {r0_, int128_t(s0_), int128_t(t0_)};
+    }
+
+    // of the magnitudes, the signs of the coefficients follow the operands. A gcd of 2^127 has no room for a
+    // coefficient of -1, which wraps.
+    INT128_CXX14_CONSTEXPR gcd_result extended_gcd(int128_t lhs_, int128_t rhs_) {
+        auto res_ = extended_gcd(detail_::abs_(lhs_), detail_::abs_(rhs_));
+        if (lhs_ < int128_t(0)) res_.x = -res_.x;
+        if (rhs_ < int128_t(0)) res_.y = -res_.y;
+        return res_;
+    }
+
+    // x in [0, mod_) with val_ * x = 1 mod mod_, 0 when there is none (val_ and mod_ share a factor, or mod_ is 1).
+    // A mod_ of 0 raises SIGFPE.
+    INT128_CXX14_CONSTEXPR uint128_t mod_inverse(uint128_t val_, uint128_t mod_) {
+        if (!mod_) return {!!mod_ / !!mod_}; // raise signal SIGFPE
+        auto res_ = extended_gcd(val_ % mod_, mod_);
+        if (res_.gcd != uint128_t(1)) return uint128_t(0);
+        return res_.x < int128_t(0) ? uint128_t(res_.x) + mod_ : uint128_t(res_.x);
+    }
+
+    namespace detail_ {
+        template<class _Hi, class _Low>
+        inline to_chars_result to_chars_batch_(char *first_, char *last_, const int128_base<_Hi, _Low> *values_,
+                                               std::size_t count_, char delim_) {
+            for (std::size_t i_ = 0; i_ < count_; ++i_) {
+                if (i_) {
+                    if (first_ == last_) return {last_, std::errc::value_too_large};
+                    *first_++ = delim_;
+                }
+                auto res_ = to_chars(first_, last_, values_[i_]);
+                if (res_.ec != std::errc()) return res_;
+                first_ = res_.ptr;
+            }
+            return {first_, std::errc()};
+        }
+    }
+
+    // decimal values_[0, count_) separated by delim_ into one buffer, which needs at most 40 characters per value plus
+    // one per delimiter. Returns value_too_large and last_ if the buffer is short.
+    inline to_chars_result to_chars_batch(char *first_, char *last_, const uint128_t *values_, std::size_t count_,
+                                          char delim_ = ',') {
+        return detail_::to_chars_batch_(first_, last_, values_, count_, delim_);
+    }
+
+    inline to_chars_result to_chars_batch(char *first_, char *last_, const int128_t *values_, std::size_t count_,
+                                          char delim_ = ',') {
+        return detail_::to_chars_batch_(first_, last_, values_, count_, delim_);
+    }
+
+    inline std::string to_string(uint128_t value_, int base_ = 10) {
+        char buf_[128];
+        return std::string(buf_, to_chars(buf_, buf_ + sizeof(buf_), value_, base_).ptr);
+    }
+
+    inline std::string to_string(int128_t value_, int base_ = 10) {
+        char buf_[129];
+        return std::string(buf_, to_chars(buf_, buf_ + sizeof(buf_), value_, base_).ptr);
+    }
+
+    namespace detail_ {
+        // widens the digits [buf_, buf_ + offset_) with grouping of the stream locale, the last frac_ of them after its
+        // decimal point, then prefix_ and padding
+        template<std::size_t _Size, class _CharT, class _Traits>
+        inline std::basic_ostream<_CharT, _Traits> &
+        put_digits_(std::basic_ostream<_CharT, _Traits> &out_, const char *buf_, int offset_, const char *prefix_,
+                    int frac_ = 0) {
+            INT128_TIMER_(timer_, instrument_op::put_plain);
+            auto adjust_field_ = out_.flags() & std::ios::adjustfield;
+            auto ns_ = out_.width(0);
+            auto fl_ = out_.fill();
+
+            _CharT o_[2 * _Size - 3];
+            _CharT *os_;
+            _CharT *op_;  // prefix here
+            _CharT *oe_ = o_ + (sizeof(o_) / sizeof(o_[0]));  // end of output
+
+            auto loc_ = out_.getloc();
+            auto &ct_ = std::use_facet<std::ctype<_CharT> >(loc_);
+            auto &npt_ = std::use_facet<std::numpunct<_CharT> >(loc_);
+            std::string grouping_ = npt_.grouping();
+
+            _CharT *ie_ = oe_; // end of the integer part
+            if (frac_) {
+                offset_ -= frac_;
+                ie_ -= frac_ + 1;
+                *ie_ = npt_.decimal_point();
+                ct_.widen(buf_ + offset_, buf_ + offset_ + frac_, ie_ + 1);
+            }
+
+            // no worry group is not empty
+            auto limit_ = grouping_.size();
+            if (limit_ == 0) {
+                op_ = ie_ - offset_;
+                ct_.widen(buf_, buf_ + offset_, op_);
+            } else {
+                INT128_TIMER_OP_(timer_, instrument_op::put_grouped);
+                auto thousands_sep_ = npt_.thousands_sep();
+                decltype(limit_) dg_ = 0;
+                auto cnt_ = static_cast<unsigned char>(grouping_[dg_]);
+                unsigned char dc_ = 0;
+                --limit_;
+                op_ = ie_;
+                for (auto p_ = buf_ + offset_; p_ != buf_; ++dc_) {
+                    if (cnt_ > 0 && dc_ == cnt_) {
+                        *--op_ = thousands_sep_;
+                        dc_ = 0;
+                        if (dg_ < limit_) cnt_ = static_cast<unsigned char>(grouping_[++dg_]);
+                    }
+                    *--op_ = ct_.widen(*--p_);
+                }
+            }
+
+            if (prefix_) {
+                auto prefix_len_ = strlen(prefix_);
+                os_ = op_ - prefix_len_;
+                ct_.widen(prefix_, prefix_ + prefix_len_, os_);
+            } else {
+                os_ = op_;
+            }
+
+            auto sz_ = static_cast<std::streamsize>(oe_ - os_);
+            INT128_TIMER_STOP_(timer_);
+            // assert(sz_ <= (sizeof(o_) / sizeof(o_[0])));
+
+            if (ns_ > sz_) {
+                ns_ -= sz_;
+                std::basic_string<_CharT, _Traits> sp_(ns_, fl_);
+                switch (adjust_field_) {
+                    case std::ios::left:
+                        return out_.write(os_, sz_).write(sp_.data(), ns_);
+                    case std::ios::internal:
+                        return out_.write(os_, static_cast<std::streamsize>(op_ - os_))
+                                .write(sp_.data(), ns_)
+                                .write(op_, static_cast<std::streamsize>(oe_ - op_));
+                    default:
+                        return out_.write(sp_.data(), ns_).write(os_, sz_);
+                }
+            }
+            return out_.write(os_, sz_);
+        }
+    }
+
+    // scale_ > 0 prints value_ / 10^scale_ in decimal whatever the basefield, the point from the stream locale
+    template<class _CharT, class _Traits>
+    inline std::basic_ostream<_CharT, _Traits> &
+    print_value(std::basic_ostream<_CharT, _Traits> &out_, bool signed_integral_, uint128_t value_, int scale_ = 0) {
+        constexpr std::size_t buf_size_ = 45;
+
+        typename std::basic_ostream<_CharT, _Traits>::sentry sentry_(out_);
+        if (!sentry_) return out_;
+        auto flags_ = out_.flags(), base_flag_ = flags_ & std::ios::basefield;
+        INT128_TIMER_(timer_, scale_ ? instrument_op::print_fixed : base_flag_ == std::ios::hex ? instrument_op::print_hex :
+                              base_flag_ == std::ios::oct ? instrument_op::print_oct : instrument_op::print_dec);
+        auto show_base_ = bool(flags_ & std::ios::showbase); // work not dec
+        auto show_pos_ = bool(flags_ & std::ios::showpos); // work only dec
+        auto upper_case_ = bool(flags_ & std::ios::uppercase); // work only hex
+
+        char buf_[buf_size_];
+        char const *prefix_ = nullptr;
+        int offset_ = 0;
+
+        switch (scale_ ? std::ios::fmtflags(std::ios::dec) : base_flag_) {
+            case std::ios::hex: {
+                if (show_base_ && value_) prefix_ = upper_case_ ? "0X" : "0x";
+                offset_ = static_cast<int>(detail_::to_chars_(buf_, buf_ + buf_size_, value_, false, 16,
+                                                              upper_case_ ? detail_::upper_digits_()
+                                                                          : detail_::lower_digits_()).ptr - buf_);
+                break;
+            }
+            case std::ios::oct: {
+                if (show_base_ && value_) buf_[offset_++] = '0';
+                offset_ = static_cast<int>(to_chars(buf_ + offset_, buf_ + buf_size_, value_, 8).ptr - buf_);
                 break;
             }
             default: {
@@ -641,89 +2432,220 @@ namespace large_int {
                         prefix_ = "+";
                     }
                 }
-                uint64_t high_, mid_, low_;
-                detail_delegate<>::part_div(value_, UINT64_C(10000000000000000000), high_, mid_, low_);
-                if (high_) {
-                    offset_ = snprintf(buf_, buf_size_, "%" PRIu64 "%019" PRIu64 "%019" PRIu64,
-                                       high_, mid_, low_);
-                } else if (mid_) {
-                    offset_ = snprintf(buf_, buf_size_, "%" PRIu64 "%019" PRIu64,
-                                       mid_, low_);
-                } else {
-                    offset_ = snprintf(buf_, buf_size_, "%" PRIu64, low_);
-                }
+                offset_ = scale_ ? detail_::write_fixed_(buf_, value_, scale_)
+                                 : static_cast<int>(to_chars(buf_, buf_ + buf_size_, value_).ptr - buf_);
                 break;
             }
         }
 
-        _CharT o_[2 * buf_size_ - 3];
-        _CharT *os_;
-        _CharT *op_;  // prefix here
-        _CharT *oe_ = o_ + (sizeof(o_) / sizeof(o_[0]));  // end of output
+        INT128_TIMER_STOP_(timer_);
+        return detail_::put_digits_<buf_size_>(out_, buf_, offset_, prefix_, scale_);
+    }
 
-        auto loc_ = out_.getloc();
-        auto &ct_ = std::use_facet<std::ctype<_CharT> >(loc_);
-        auto &npt_ = std::use_facet<std::numpunct<_CharT> >(loc_);
-        std::string grouping_ = npt_.grouping();
+    template<class _CharT, class _Traits>
+    inline std::basic_ostream<_CharT, _Traits> &operator<<(std::basic_ostream<_CharT, _Traits> &out, uint128_t _Val) {
+        return print_value(out, false, _Val);
+    }
 
-        // no worry group is not empty
-        auto limit_ = grouping_.size();
-        if (limit_ == 0) {
-            op_ = oe_ - offset_;
-            ct_.widen(buf_, buf_ + offset_, op_);
-        } else {
-            auto thousands_sep_ = npt_.thousands_sep();
-            decltype(limit_) dg_ = 0;
-            auto cnt_ = static_cast<unsigned char>(grouping_[dg_]);
-            unsigned char dc_ = 0;
-            --limit_;
-            op_ = oe_;
-            for (char *p_ = buf_ + offset_; p_ != buf_; ++dc_) {
-                if (cnt_ > 0 && dc_ == cnt_) {
-                    *--op_ = thousands_sep_;
-                    dc_ = 0;
-                    if (dg_ < limit_) cnt_ = static_cast<unsigned char>(grouping_[++dg_]);
+    template<class _CharT, class _Traits>
+    inline std::basic_ostream<_CharT, _Traits> &operator<<(std::basic_ostream<_CharT, _Traits> &out, int128_t _Val) {
+        return print_value(out, true, uint128_t(_Val));
+    }
+
+    namespace detail_ {
+        // digit value of ch_ in base 36, or 36 if not a digit
+        inline unsigned digit_value_(char ch_) {
+            auto dec_ = static_cast<unsigned>(static_cast<unsigned char>(ch_) - '0');
+            auto alpha_ = static_cast<unsigned>((static_cast<unsigned char>(ch_) | 0x20U) - 'a');
+            return dec_ < 10 ? dec_ : alpha_ < 26 ? alpha_ + 10 : 36;
+        }
+
+        inline uint64_t load8_(const char *ptr_) {
+            uint64_t val_;
+            memcpy(&val_, ptr_, sizeof(val_));
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+            val_ = __builtin_bswap64(val_);
+#endif
+            return val_; // first character in the lowest byte
+        }
+
+        inline bool is_eight_digits_(uint64_t val_) {
+            return ((val_ & UINT64_C(0xF0F0F0F0F0F0F0F0)) |
+                    (((val_ + UINT64_C(0x0606060606060606)) & UINT64_C(0xF0F0F0F0F0F0F0F0)) >> 4U)) ==
+                   UINT64_C(0x3333333333333333);
+        }
+
+        inline uint64_t parse_eight_digits_(uint64_t val_) {
+            val_ = (val_ & UINT64_C(0x0F0F0F0F0F0F0F0F)) * 2561 >> 8U;
+            val_ = (val_ & UINT64_C(0x00FF00FF00FF00FF)) * 6553601 >> 16U;
+            return (val_ & UINT64_C(0x0000FFFF0000FFFF)) * UINT64_C(42949672960001) >> 32U;
+        }
+
+        // decimal digits [first_, last_), at most 19 of them
+        inline uint64_t parse_chunk_(const char *first_, const char *last_) {
+            uint64_t val_ = 0;
+            for (auto head_ = first_ + (last_ - first_) % 8; first_ != head_; ++first_) val_ = val_ * 10 + (*first_ - '0');
+            for (; first_ != last_; first_ += 8) val_ = val_ * 100000000 + parse_eight_digits_(load8_(first_));
+            return val_;
+        }
+
+        // value_ = value_ * mul_ + add_, returns true on overflow and leaves value_ unchanged
+        inline bool mul_add_overflow_(uint128_t &value_, uint64_t mul_, uint64_t add_) {
+            auto low_ = detail_delegate<>::mul64_(static_cast<uint64_t>(value_), mul_) + uint128_t(add_);
+            auto high_ = detail_delegate<>::mul64_(hi64_(value_), mul_) + uint128_t(hi64_(low_));
+            if (hi64_(high_)) return true;
+            value_ = high_ << 64 | uint128_t(static_cast<uint64_t>(low_));
+            return false;
+        }
+
+        inline const char *parse_decimal_(const char *first_, const char *last_, uint128_t &value_, bool &overflow_) {
+            constexpr uint64_t ten19_ = UINT64_C(10000000000000000000);
+            auto begin_ = first_;
+            while (begin_ != last_ && *begin_ == '0') ++begin_;
+            auto end_ = begin_;
+            while (last_ - end_ >= 8 && is_eight_digits_(load8_(end_))) end_ += 8;
+            while (end_ != last_ && static_cast<unsigned>(*end_ - '0') < 10) ++end_;
+            auto count_ = end_ - begin_;
+            // "340282366920938463463374607431768211455" has 39 digits
+            overflow_ = count_ > 39 || (count_ == 39 && memcmp(begin_, "340282366920938463463374607431768211455", 39) > 0);
+            if (end_ == first_ || overflow_) return end_;
+            // value_ = (high_ * 10^19 + mid_) * 10^19 + low_, as part_div splits it for output
+            auto low_begin_ = count_ > 19 ? end_ - 19 : begin_, mid_begin_ = count_ > 38 ? end_ - 38 : begin_;
+            uint64_t low_ = parse_chunk_(low_begin_, end_);
+            uint64_t mid_ = parse_chunk_(mid_begin_, low_begin_);
+            uint64_t high_ = parse_chunk_(begin_, mid_begin_);
+            value_ = (detail_delegate<>::mul64_(high_, ten19_) + uint128_t(mid_)) * uint128_t(ten19_) + uint128_t(low_);
+            return end_;
+        }
+
+        // digits of base_ without sign or prefix, returns the end of the digits, first_ if there is none
+        inline const char *parse_digits_(const char *first_, const char *last_, int base_, uint128_t &value_,
+                                         bool &overflow_) {
+            if (base_ == 10) return parse_decimal_(first_, last_, value_, overflow_);
+            auto radix_ = static_cast<unsigned>(base_);
+            // largest power of base_ fits in 64 bits, chunk of digits are collected in 64-bit first
+            uint64_t chunk_mul_ = radix_;
+            int chunk_len_ = 1;
+            while (chunk_mul_ <= ~UINT64_C(0) / radix_) chunk_mul_ *= radix_, ++chunk_len_;
+
+            uint128_t acc_(0);
+            overflow_ = false;
+            auto ptr_ = first_;
+            while (ptr_ != last_ && detail_::digit_value_(*ptr_) < radix_) {
+                uint64_t chunk_ = 0, mul_ = 1;
+                for (int i_ = 0; i_ < chunk_len_ && ptr_ != last_; ++i_, ++ptr_, mul_ *= radix_) {
+                    auto digit_ = detail_::digit_value_(*ptr_);
+                    if (digit_ >= radix_) break;
+                    chunk_ = chunk_ * radix_ + digit_;
                 }
-                *--op_ = ct_.widen(*--p_);
+                overflow_ = overflow_ || mul_add_overflow_(acc_, mul_, chunk_);
             }
+            if (ptr_ != first_ && !overflow_) value_ = acc_;
+            return ptr_;
         }
 
-        if (prefix_) {
-            auto prefix_len_ = strlen(prefix_);
-            os_ = op_ - prefix_len_;
-            ct_.widen(prefix_, prefix_ + prefix_len_, os_);
-        } else {
-            os_ = op_;
-        }
-
-        auto sz_ = static_cast<std::streamsize>(oe_ - os_);
-        // assert(sz_ <= (sizeof(o_) / sizeof(o_[0])));
-
-        if (ns_ > sz_) {
-            ns_ -= sz_;
-            std::basic_string<_CharT, _Traits> sp_(ns_, fl_);
-            switch (adjust_field_) {
-                case std::ios::left:
-                    return out_.write(os_, sz_).write(sp_.data(), ns_);
-                case std::ios::internal:
-                    return out_.write(os_, static_cast<std::streamsize>(op_ - os_))
-                            .write(sp_.data(), ns_)
-                            .write(op_, static_cast<std::streamsize>(oe_ - op_));
-                default:
-                    return out_.write(sp_.data(), ns_).write(os_, sz_);
+        inline from_chars_result from_chars_(const char *first_, const char *last_, bool signed_integral_,
+                                             uint128_t &value_, int base_) {
+            auto neg_ = signed_integral_ && first_ != last_ && *first_ == '-';
+            uint128_t mag_(0);
+            bool overflow_;
+            auto end_ = parse_digits_(first_ + neg_, last_, base_, mag_, overflow_);
+            if (end_ == first_ + neg_) return {first_, std::errc::invalid_argument};
+            if (signed_integral_ && mag_ > (uint128_t(1) << 127) - uint128_t(!neg_)) overflow_ = true;
+            if (overflow_) return {end_, std::errc::result_out_of_range};
+            value_ = neg_ ? -mag_ : mag_;
+            return {end_, std::errc()};
+        }
+    }
+
+    // locale free, base_ in [2, 36], no base prefix or leading spaces, '-' only for signed type.
+    // On failure value_ is unchanged, ec reports invalid_argument or result_out_of_range.
+    inline from_chars_result from_chars(const char *first_, const char *last_, uint128_t &value_, int base_ = 10) {
+        return detail_::from_chars_(first_, last_, false, value_, base_);
+    }
+
+    inline from_chars_result from_chars(const char *first_, const char *last_, int128_t &value_, int base_ = 10) {
+        uint128_t res_(value_);
+        auto ret_ = detail_::from_chars_(first_, last_, true, res_, base_);
+        value_ = int128_t(res_);
+        return ret_;
+    }
+
+    template<class _CharT, class _Traits>
+    inline std::basic_istream<_CharT, _Traits> &
+    scan_value(std::basic_istream<_CharT, _Traits> &in_, bool signed_integral_, uint128_t &value_) {
+        constexpr std::size_t buf_size_ = 48; // 43 octal digits and sign
+
+        typename std::basic_istream<_CharT, _Traits>::sentry sentry_(in_);
+        if (!sentry_) return in_;
+        auto base_flag_ = in_.flags() & std::ios::basefield;
+        int base_ = base_flag_ == std::ios::hex ? 16 : base_flag_ == std::ios::oct ? 8 : base_flag_ == std::ios::dec ? 10 : 0;
+        auto &ct_ = std::use_facet<std::ctype<_CharT> >(in_.getloc());
+        auto *sb_ = in_.rdbuf();
+        auto ch_ = sb_->sgetc();
+        auto state_ = std::ios::goodbit;
+
+        char buf_[buf_size_];
+        std::size_t len_ = 0;
+        bool neg_ = false, zero_ = false, too_long_ = false;
+        auto peek_ = [&]() -> char {
+            return _Traits::eq_int_type(ch_, _Traits::eof()) ? '\0' : ct_.narrow(_Traits::to_char_type(ch_), '\0');
+        };
+
+        if (peek_() == '-' || peek_() == '+') {
+            neg_ = peek_() == '-';
+            ch_ = sb_->snextc();
+        }
+        if (peek_() == '0') { // leading zero, or base prefix
+            zero_ = true;
+            ch_ = sb_->snextc();
+            if ((base_ == 16 || base_ == 0) && (peek_() == 'x' || peek_() == 'X')) {
+                base_ = 16;
+                zero_ = false;
+                ch_ = sb_->snextc();
+            } else if (base_ == 0) {
+                base_ = 8;
             }
         }
-        return out_.write(os_, sz_);
+        if (base_ == 0) base_ = 10;
+        for (char c_; (c_ = peek_()) && detail_::digit_value_(c_) < static_cast<unsigned>(base_); ch_ = sb_->snextc()) {
+            if (len_ == 0 && c_ == '0') {
+                zero_ = true;
+            } else if (len_ < buf_size_) {
+                buf_[len_++] = c_;
+            } else {
+                too_long_ = true;
+            }
+        }
+        if (_Traits::eq_int_type(ch_, _Traits::eof())) state_ |= std::ios::eofbit;
+
+        uint128_t mag_(0);
+        if (len_ == 0) {
+            if (!zero_) state_ |= std::ios::failbit;
+            value_ = uint128_t(0);
+        } else if (too_long_ || detail_::from_chars_(buf_, buf_ + len_, false, mag_, base_).ec != std::errc() ||
+                   (signed_integral_ && mag_ > (uint128_t(1) << 127) - uint128_t(!neg_))) {
+            // out of range, same as num_get
+            state_ |= std::ios::failbit;
+            value_ = !signed_integral_ ? ~uint128_t(0) : (uint128_t(1) << 127) - uint128_t(!neg_);
+        } else {
+            value_ = neg_ ? -mag_ : mag_;
+        }
+        in_.setstate(state_);
+        return in_;
     }
 
     template<class _CharT, class _Traits>
-    inline std::basic_ostream<_CharT, _Traits> &operator<<(std::basic_ostream<_CharT, _Traits> &out, uint128_t _Val) {
-        return print_value(out, false, _Val);
+    inline std::basic_istream<_CharT, _Traits> &operator>>(std::basic_istream<_CharT, _Traits> &in, uint128_t &_Val) {
+        return scan_value(in, false, _Val);
     }
 
     template<class _CharT, class _Traits>
-    inline std::basic_ostream<_CharT, _Traits> &operator<<(std::basic_ostream<_CharT, _Traits> &out, int128_t _Val) {
-        return print_value(out, true, uint128_t(_Val));
+    inline std::basic_istream<_CharT, _Traits> &operator>>(std::basic_istream<_CharT, _Traits> &in, int128_t &_Val) {
+        uint128_t val_(_Val);
+        scan_value(in, true, val_);
+        _Val = int128_t(val_);
+        return in;
     }
 }
 
@@ -749,6 +2671,13 @@ template<> struct outter<const volatile large_int::inner> { typedef const volati
     MAKE_TYPE(make_unsigned, int128_t, uint128_t)
 #pragma pop_macro("MAKE_TYPE")
 
+    template<class _Hi, class _Low>
+    struct hash<large_int::int128_base<_Hi, _Low> > {
+        size_t operator()(large_int::int128_base<_Hi, _Low> val_) const noexcept {
+            return static_cast<size_t>(large_int::hash128(val_));
+        }
+    };
+
     template<class _Hi, class _Low>
     struct numeric_limits<large_int::int128_base<_Hi, _Low> > {
     private:
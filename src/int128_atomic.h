@@ -0,0 +1,231 @@
+#pragma once
+
+#include "int128.h"
+
+#include <atomic>
+
+#if defined(__x86_64__) && defined(__GNUC__) && !defined(INT128_ATOMIC_LOCKED)
+#define INT128_ATOMIC_CX16 1
+#endif
+
+// atomic int128_t/uint128_t, lock free on x86-64 through cmpxchg16b without -mcx16 or libatomic, elsewhere (or with
+// INT128_ATOMIC_LOCKED) each access takes one of 64 spin locks picked by the address
+namespace large_int {
+    namespace detail_ {
+#ifdef INT128_ATOMIC_CX16
+
+        struct alignas(16) cas16_block_ {
+            uint64_t low, high;
+        };
+
+        // a full barrier, so it serves every memory order. The memory is written even when the compare fails,
+        // which is why a load needs a writable object too
+        inline bool cas16_(volatile void *addr_, uint128_t &expected_, uint128_t desired_) {
+            auto low_ = static_cast<uint64_t>(expected_), high_ = hi64_(expected_);
+            bool ok_;
+            __asm__ __volatile__("lock cmpxchg16b %1"
+            : "=@ccz"(ok_), "+m"(*static_cast<volatile cas16_block_ *>(addr_)), "+a"(low_), "+d"(high_)
+            : "b"(static_cast<uint64_t>(desired_)), "c"(hi64_(desired_))
+            : "memory");
+            if (!ok_) expected_ = uint128_t(high_) << 64 | uint128_t(low_);
+            return ok_;
+        }
+
+        // two plain loads, may be torn, only a first guess for a compare and swap loop
+        inline uint128_t peek16_(const volatile void *addr_) {
+            auto block_ = static_cast<const volatile cas16_block_ *>(addr_);
+            return uint128_t(block_->high) << 64 | uint128_t(block_->low);
+        }
+
+#else
+
+        struct alignas(64) atomic_stripe_ {
+            std::atomic_flag flag;
+        };
+
+        inline std::atomic_flag &atomic_lock_(const volatile void *addr_) {
+            static atomic_stripe_ stripes_[64]; // zero initialized, so clear
+            return stripes_[(reinterpret_cast<uintptr_t>(addr_) >> 4U) % 64].flag;
+        }
+
+        class atomic_guard_ {
+            std::atomic_flag &flag_;
+
+        public:
+            explicit atomic_guard_(const volatile void *addr_) : flag_(atomic_lock_(addr_)) {
+                while (flag_.test_and_set(std::memory_order_acquire)) {}
+            }
+
+            atomic_guard_(const atomic_guard_ &) = delete;
+
+            atomic_guard_ &operator=(const atomic_guard_ &) = delete;
+
+            ~atomic_guard_() { flag_.clear(std::memory_order_release); }
+        };
+
+#endif
+    }
+
+    template<class _Tp>
+    class atomic128 {
+        mutable _Tp value_; // cmpxchg16b writes even to load
+
+        bool cas_(_Tp &expected_, _Tp desired_) const volatile noexcept {
+#ifdef INT128_ATOMIC_CX16
+            auto exp_ = uint128_t(expected_);
+            auto ok_ = detail_::cas16_(&value_, exp_, uint128_t(desired_));
+            expected_ = _Tp(exp_);
+            return ok_;
+#else
+            detail_::atomic_guard_ guard_(&value_);
+            auto cur_ = const_cast<const _Tp &>(value_);
+            if (cur_ != expected_) {
+                expected_ = cur_;
+                return false;
+            }
+            const_cast<_Tp &>(value_) = desired_;
+            return true;
+#endif
+        }
+
+        template<class _Fn>
+        _Tp update_(_Fn fn_) volatile noexcept {
+#ifdef INT128_ATOMIC_CX16
+            auto cur_ = _Tp(detail_::peek16_(&value_));
+#else
+            auto cur_ = load(std::memory_order_relaxed);
+#endif
+            while (!cas_(cur_, fn_(cur_))) {}
+            return cur_;
+        }
+
+    public:
+        typedef _Tp value_type;
+
+#ifdef INT128_ATOMIC_CX16
+        static constexpr bool is_always_lock_free = true;
+#else
+        static constexpr bool is_always_lock_free = false;
+#endif
+
+        atomic128() noexcept = default;
+
+        constexpr atomic128(_Tp desired_) noexcept : value_(desired_) {} // NOLINT explicit
+
+        atomic128(const atomic128 &) = delete;
+
+        atomic128 &operator=(const atomic128 &) = delete;
+
+        atomic128 &operator=(const atomic128 &) volatile = delete;
+
+        bool is_lock_free() const volatile noexcept { return is_always_lock_free; }
+
+        _Tp load(std::memory_order = std::memory_order_seq_cst) const volatile noexcept {
+            _Tp cur_(0);
+            cas_(cur_, cur_); // writes back what is there, or 0 over 0
+            return cur_;
+        }
+
+        void store(_Tp desired_, std::memory_order order_ = std::memory_order_seq_cst) volatile noexcept {
+            exchange(desired_, order_);
+        }
+
+        _Tp exchange(_Tp desired_, std::memory_order = std::memory_order_seq_cst) volatile noexcept {
+            return update_([desired_](_Tp) { return desired_; });
+        }
+
+        // cmpxchg16b does not fail spuriously, weak and strong are the same
+        bool compare_exchange_strong(_Tp &expected_, _Tp desired_, std::memory_order,
+                                     std::memory_order) volatile noexcept {
+            return cas_(expected_, desired_);
+        }
+
+        bool compare_exchange_strong(_Tp &expected_, _Tp desired_,
+                                     std::memory_order = std::memory_order_seq_cst) volatile noexcept {
+            return cas_(expected_, desired_);
+        }
+
+        bool compare_exchange_weak(_Tp &expected_, _Tp desired_, std::memory_order,
+                                   std::memory_order) volatile noexcept {
+            return cas_(expected_, desired_);
+        }
+
+        bool compare_exchange_weak(_Tp &expected_, _Tp desired_,
+                                   std::memory_order = std::memory_order_seq_cst) volatile noexcept {
+            return cas_(expected_, desired_);
+        }
+
+        // the fetch_ ones return the previous value
+        _Tp fetch_add(_Tp arg_, std::memory_order = std::memory_order_seq_cst) volatile noexcept {
+            return update_([arg_](_Tp cur_) { return cur_ + arg_; });
+        }
+
+        _Tp fetch_sub(_Tp arg_, std::memory_order = std::memory_order_seq_cst) volatile noexcept {
+            return update_([arg_](_Tp cur_) { return cur_ - arg_; });
+        }
+
+        _Tp fetch_and(_Tp arg_, std::memory_order = std::memory_order_seq_cst) volatile noexcept {
+            return update_([arg_](_Tp cur_) { return cur_ & arg_; });
+        }
+
+        _Tp fetch_or(_Tp arg_, std::memory_order = std::memory_order_seq_cst) volatile noexcept {
+            return update_([arg_](_Tp cur_) { return cur_ | arg_; });
+        }
+
+        _Tp fetch_xor(_Tp arg_, std::memory_order = std::memory_order_seq_cst) volatile noexcept {
+            return update_([arg_](_Tp cur_) { return cur_ ^ arg_; });
+        }
+
+        operator _Tp() const volatile noexcept { return load(); } // NOLINT explicit
+
+        // the non-volatile one too, otherwise a plain object picks between this and the deleted copy assignment
+        _Tp operator=(_Tp desired_) noexcept {
+            store(desired_);
+            return desired_;
+        }
+
+        _Tp operator=(_Tp desired_) volatile noexcept {
+            store(desired_);
+            return desired_;
+        }
+
+        _Tp operator++() volatile noexcept { return fetch_add(_Tp(1)) + _Tp(1); }
+
+        _Tp operator--() volatile noexcept { return fetch_sub(_Tp(1)) - _Tp(1); }
+
+        _Tp operator++(int) volatile noexcept { return fetch_add(_Tp(1)); }
+
+        _Tp operator--(int) volatile noexcept { return fetch_sub(_Tp(1)); }
+
+        _Tp operator+=(_Tp arg_) volatile noexcept { return fetch_add(arg_) + arg_; }
+
+        _Tp operator-=(_Tp arg_) volatile noexcept { return fetch_sub(arg_) - arg_; }
+
+        _Tp operator&=(_Tp arg_) volatile noexcept { return fetch_and(arg_) & arg_; }
+
+        _Tp operator|=(_Tp arg_) volatile noexcept { return fetch_or(arg_) | arg_; }
+
+        _Tp operator^=(_Tp arg_) volatile noexcept { return fetch_xor(arg_) ^ arg_; }
+    };
+
+    template<class _Tp>
+    constexpr bool atomic128<_Tp>::is_always_lock_free;
+
+    typedef atomic128<int128_t> atomic_int128;
+    typedef atomic128<uint128_t> atomic_uint128;
+}
+
+#ifdef INT128_SPECIALIZATION
+namespace std {
+    template<class _Hi, class _Low>
+    struct atomic<large_int::int128_base<_Hi, _Low> > : large_int::atomic128<large_int::int128_base<_Hi, _Low> > {
+        typedef large_int::atomic128<large_int::int128_base<_Hi, _Low> > _Base;
+
+        atomic() noexcept = default;
+
+        constexpr atomic(large_int::int128_base<_Hi, _Low> desired_) noexcept : _Base(desired_) {} // NOLINT explicit
+
+        using _Base::operator=;
+    };
+}
+#endif /* INT128_SPECIALIZATION */
@@ -0,0 +1,252 @@
+#pragma once
+
+#include "int128.h"
+
+#include <iterator>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define INT128_BINARY_MMAP 1
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// int128_t/uint128_t as bytes: fixed 16 bytes in either byte order whatever the host is, LEB128 varints (zigzag for
+// int128_t) of 1 to 19 bytes, and a read-only view of a mapped file of packed little-endian values
+namespace large_int {
+    namespace detail_ {
+        inline void store8_(char *ptr_, uint64_t val_) {
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+            val_ = __builtin_bswap64(val_);
+#endif
+            memcpy(ptr_, &val_, sizeof(val_)); // lowest byte first
+        }
+
+        // the low 7 bits of each byte of word_ packed together, 56 bits with the first byte lowest
+        inline uint64_t varint_pack7_(uint64_t word_) {
+#ifdef INT128_BMI2
+            return __builtin_ia32_pext_di(word_, UINT64_C(0x7f7f7f7f7f7f7f7f));
+#else
+            word_ &= UINT64_C(0x7f7f7f7f7f7f7f7f);
+            word_ = (word_ & UINT64_C(0x007f007f007f007f)) | (word_ & UINT64_C(0x7f007f007f007f00)) >> 1U;
+            word_ = (word_ & UINT64_C(0x00003fff00003fff)) | (word_ & UINT64_C(0x3fff00003fff0000)) >> 2U;
+            return (word_ & UINT64_C(0x000000000fffffff)) | (word_ & UINT64_C(0x0fffffff00000000)) >> 4U;
+#endif
+        }
+
+        // word_ up to and including the byte of stop_'s lowest bit, the last byte of the varint
+        inline uint64_t varint_head_(uint64_t word_, uint64_t stop_) { return word_ & (stop_ ^ (stop_ - 1)); }
+    }
+
+    // the 16 bytes at src_, least significant first, at any alignment
+    template<class _Tp = uint128_t>
+    inline typename std::enable_if<std::is_same<_Tp, uint128_t>::value || std::is_same<_Tp, int128_t>::value, _Tp>::type
+    load_le(const void *src_) {
+        auto bytes_ = static_cast<const char *>(src_);
+        return _Tp(uint128_t(detail_::load8_(bytes_ + 8)) << 64 | uint128_t(detail_::load8_(bytes_)));
+    }
+
+    // most significant first
+    template<class _Tp = uint128_t>
+    inline typename std::enable_if<std::is_same<_Tp, uint128_t>::value || std::is_same<_Tp, int128_t>::value, _Tp>::type
+    load_be(const void *src_) {
+        auto bytes_ = static_cast<const char *>(src_);
+        return _Tp(uint128_t(__builtin_bswap64(detail_::load8_(bytes_))) << 64 |
+                   uint128_t(__builtin_bswap64(detail_::load8_(bytes_ + 8))));
+    }
+
+    template<class _Hi, class _Low>
+    inline void store_le(void *dst_, int128_base<_Hi, _Low> value_) {
+        auto bytes_ = static_cast<char *>(dst_);
+        detail_::store8_(bytes_, static_cast<uint64_t>(value_));
+        detail_::store8_(bytes_ + 8, static_cast<uint64_t>(uint128_t(value_) >> 64));
+    }
+
+    template<class _Hi, class _Low>
+    inline void store_be(void *dst_, int128_base<_Hi, _Low> value_) {
+        auto bytes_ = static_cast<char *>(dst_);
+        detail_::store8_(bytes_, __builtin_bswap64(static_cast<uint64_t>(uint128_t(value_) >> 64)));
+        detail_::store8_(bytes_ + 8, __builtin_bswap64(static_cast<uint64_t>(value_)));
+    }
+
+    // small magnitudes of either sign to small values: 0, -1, 1, -2 to 0, 1, 2, 3
+    constexpr uint128_t zigzag_encode(int128_t value_) { return uint128_t(value_) << 1 ^ uint128_t(value_ >> 127); }
+
+    constexpr int128_t zigzag_decode(uint128_t value_) { return int128_t(value_ >> 1 ^ -(value_ & uint128_t(1))); }
+
+    // bytes varint_encode writes, 1 to 19
+    constexpr int varint_size(uint128_t value_) { return (bit_width(value_ | uint128_t(1)) + 6) / 7; }
+
+    constexpr int varint_size(int128_t value_) { return varint_size(zigzag_encode(value_)); }
+
+    // LEB128, 7 bits per byte from the lowest, the high bit set on all but the last. Returns value_too_large and
+    // last_ if the buffer is short.
+    inline to_chars_result varint_encode(char *first_, char *last_, uint128_t value_) {
+        auto len_ = varint_size(value_);
+        if (last_ - first_ < len_) return {last_, std::errc::value_too_large};
+        for (auto end_ = first_ + len_ - 1; first_ != end_; ++first_, value_ >>= 7) {
+            *first_ = static_cast<char>(static_cast<unsigned char>(value_) | 0x80U);
+        }
+        *first_++ = static_cast<char>(static_cast<unsigned char>(value_));
+        return {first_, std::errc()};
+    }
+
+    inline to_chars_result varint_encode(char *first_, char *last_, int128_t value_) {
+        return varint_encode(first_, last_, zigzag_encode(value_));
+    }
+
+    // one varint at first_, ptr is past it. An encoding cut off by last_ gives invalid_argument, one over 128 bits
+    // result_out_of_range, both with first_ and value_ unchanged. With 16 bytes to read, encodings of up to 16 bytes
+    // take one or two word loads instead of the byte loop.
+    inline from_chars_result varint_decode(const char *first_, const char *last_, uint128_t &value_) {
+        const auto high_bits_ = UINT64_C(0x8080808080808080);
+        if (last_ - first_ >= 16) {
+            auto low_ = detail_::load8_(first_), stop_ = ~low_ & high_bits_;
+            if (stop_) {
+                value_ = uint128_t(detail_::varint_pack7_(detail_::varint_head_(low_, stop_)));
+                return {first_ + __builtin_ctzll(stop_) / 8 + 1, std::errc()};
+            }
+            auto high_ = detail_::load8_(first_ + 8);
+            stop_ = ~high_ & high_bits_;
+            if (stop_) {
+                value_ = uint128_t(detail_::varint_pack7_(detail_::varint_head_(high_, stop_))) << 56 |
+                         uint128_t(detail_::varint_pack7_(low_));
+                return {first_ + __builtin_ctzll(stop_) / 8 + 9, std::errc()};
+            }
+        }
+        uint128_t res_(0);
+        for (int i_ = 0; first_ + i_ != last_; ++i_) {
+            auto byte_ = static_cast<unsigned char>(first_[i_]);
+            if (i_ == 18 && byte_ > 3) return {first_, std::errc::result_out_of_range}; // 18 * 7 + 2 bits
+            res_ = res_ | uint128_t(byte_ & 0x7fU) << (7 * i_);
+            if (!(byte_ & 0x80U)) {
+                value_ = res_;
+                return {first_ + i_ + 1, std::errc()};
+            }
+        }
+        return {first_, std::errc::invalid_argument};
+    }
+
+    inline from_chars_result varint_decode(const char *first_, const char *last_, int128_t &value_) {
+        uint128_t raw_;
+        auto res_ = varint_decode(first_, last_, raw_);
+        if (res_.ec == std::errc()) value_ = zigzag_decode(raw_);
+        return res_;
+    }
+
+#ifdef INT128_BINARY_MMAP
+
+    // a read-only view of a file of packed little-endian values, 16 bytes each. The file is mapped, not read, and
+    // each element is loaded where it lies, a plain load on a little-endian host.
+    template<class _Tp>
+    class mapped_array128 {
+        const char *data_ = nullptr;
+        std::size_t size_ = 0;
+
+    public:
+        typedef _Tp value_type;
+
+        class const_iterator {
+            const char *pos_ = nullptr;
+
+        public:
+            typedef std::input_iterator_tag iterator_category;
+            typedef _Tp value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef const _Tp *pointer;
+            typedef _Tp reference;
+
+            const_iterator() = default;
+
+            explicit const_iterator(const char *ptr_) : pos_(ptr_) {}
+
+            _Tp operator*() const { return load_le<_Tp>(pos_); }
+
+            const_iterator &operator++() {
+                pos_ += 16;
+                return *this;
+            }
+
+            const_iterator operator++(int) { // NOLINT returns non constant
+                auto tmp_ = *this;
+                pos_ += 16;
+                return tmp_;
+            }
+
+            friend bool operator==(const_iterator lhs_, const_iterator rhs_) { return lhs_.pos_ == rhs_.pos_; }
+
+            friend bool operator!=(const_iterator lhs_, const_iterator rhs_) { return lhs_.pos_ != rhs_.pos_; }
+        };
+
+        mapped_array128() = default;
+
+        mapped_array128(const mapped_array128 &) = delete;
+
+        mapped_array128 &operator=(const mapped_array128 &) = delete;
+
+        mapped_array128(mapped_array128 &&other_) noexcept : data_(other_.data_), size_(other_.size_) {
+            other_.data_ = nullptr;
+            other_.size_ = 0;
+        }
+
+        mapped_array128 &operator=(mapped_array128 &&other_) noexcept {
+            std::swap(data_, other_.data_);
+            std::swap(size_, other_.size_);
+            return *this;
+        }
+
+        ~mapped_array128() { close(); }
+
+        // maps path_ in place of what was mapped. Returns the errno of a failed open, fstat or mmap, or
+        // invalid_argument for a size that is not a multiple of 16, and leaves the view empty.
+        std::error_code open(const char *path_) {
+            close();
+            auto fd_ = ::open(path_, O_RDONLY);
+            if (fd_ < 0) return {errno, std::generic_category()};
+            struct stat st_{};
+            std::error_code ec_;
+            if (fstat(fd_, &st_) != 0) {
+                ec_.assign(errno, std::generic_category());
+            } else if (st_.st_size % 16) {
+                ec_ = std::make_error_code(std::errc::invalid_argument);
+            } else if (st_.st_size) { // an empty file has nothing to map
+                auto map_ = mmap(nullptr, static_cast<std::size_t>(st_.st_size), PROT_READ, MAP_SHARED, fd_, 0);
+                if (map_ == MAP_FAILED) {
+                    ec_.assign(errno, std::generic_category());
+                } else {
+                    data_ = static_cast<const char *>(map_);
+                    size_ = static_cast<std::size_t>(st_.st_size) / 16;
+                }
+            }
+            ::close(fd_); // the mapping holds its own reference
+            return ec_;
+        }
+
+        void close() {
+            if (data_) munmap(const_cast<char *>(data_), size_ * 16);
+            data_ = nullptr;
+            size_ = 0;
+        }
+
+        std::size_t size() const { return size_; }
+
+        bool empty() const { return !size_; }
+
+        _Tp operator[](std::size_t idx_) const { return load_le<_Tp>(data_ + idx_ * 16); }
+
+        const_iterator begin() const { return const_iterator(data_); }
+
+        const_iterator end() const { return const_iterator(data_ + size_ * 16); }
+
+        // the mapped bytes, 16 * size() of them
+        const char *bytes() const { return data_; }
+    };
+
+    typedef mapped_array128<int128_t> int128_mapped_array;
+    typedef mapped_array128<uint128_t> uint128_mapped_array;
+
+#endif
+}
@@ -0,0 +1,472 @@
+#pragma once
+
+#include "int128.h"
+
+#include <vector>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#define INT128_COLUMN_X86 1
+#include <immintrin.h>
+#endif
+
+// columns of int128_t/uint128_t with the high and low halves in separate arrays, so elementwise kernels run on
+// 4 (AVX2) or 8 (AVX-512) values at once
+namespace large_int {
+    template<class _Tp>
+    class column128 {
+        std::vector<uint64_t> high_, low_;
+
+    public:
+        typedef _Tp value_type;
+
+        column128() = default;
+
+        explicit column128(std::size_t size_) : high_(size_), low_(size_) {}
+
+        column128(const _Tp *values_, std::size_t size_) : high_(size_), low_(size_) {
+            for (std::size_t i_ = 0; i_ < size_; ++i_) set(i_, values_[i_]);
+        }
+
+        std::size_t size() const { return low_.size(); }
+
+        bool empty() const { return low_.empty(); }
+
+        void resize(std::size_t size_) {
+            high_.resize(size_);
+            low_.resize(size_);
+        }
+
+        void reserve(std::size_t size_) {
+            high_.reserve(size_);
+            low_.reserve(size_);
+        }
+
+        void clear() {
+            high_.clear();
+            low_.clear();
+        }
+
+        void push_back(_Tp value_) {
+            high_.push_back(static_cast<uint64_t>(uint128_t(value_) >> 64));
+            low_.push_back(static_cast<uint64_t>(value_));
+        }
+
+        _Tp operator[](std::size_t idx_) const { return _Tp(uint128_t(high_[idx_]) << 64 | uint128_t(low_[idx_])); }
+
+        void set(std::size_t idx_, _Tp value_) {
+            high_[idx_] = static_cast<uint64_t>(uint128_t(value_) >> 64);
+            low_[idx_] = static_cast<uint64_t>(value_);
+        }
+
+        uint64_t *high() { return high_.data(); }
+
+        const uint64_t *high() const { return high_.data(); }
+
+        uint64_t *low() { return low_.data(); }
+
+        const uint64_t *low() const { return low_.data(); }
+    };
+
+    typedef column128<int128_t> int128_column;
+    typedef column128<uint128_t> uint128_column;
+
+    namespace detail_ {
+        struct column_args_ {
+            const uint64_t *lhs_high, *lhs_low, *rhs_high, *rhs_low;
+            uint64_t *out_high, *out_low;
+            uint8_t *mask; // output of compares
+            const uint8_t *pick; // input of select
+        };
+
+        typedef void (*column_fn_)(const column_args_ &, std::size_t, std::size_t);
+
+        // the scalar kernels go through the operators, so every other kernel has to match them bit for bit
+
+        template<class _Tp>
+        inline _Tp column_load_(const uint64_t *high_, const uint64_t *low_, std::size_t idx_) {
+            return _Tp(uint128_t(high_[idx_]) << 64 | uint128_t(low_[idx_]));
+        }
+
+        template<class _Tp>
+        inline void column_store_(const column_args_ &args_, std::size_t idx_, _Tp value_) {
+            args_.out_high[idx_] = static_cast<uint64_t>(uint128_t(value_) >> 64);
+            args_.out_low[idx_] = static_cast<uint64_t>(value_);
+        }
+
+        inline void column_add_scalar_(const column_args_ &args_, std::size_t first_, std::size_t last_) {
+            for (auto i_ = first_; i_ < last_; ++i_) {
+                column_store_(args_, i_, column_load_<uint128_t>(args_.lhs_high, args_.lhs_low, i_) +
+                                         column_load_<uint128_t>(args_.rhs_high, args_.rhs_low, i_));
+            }
+        }
+
+        inline void column_sub_scalar_(const column_args_ &args_, std::size_t first_, std::size_t last_) {
+            for (auto i_ = first_; i_ < last_; ++i_) {
+                column_store_(args_, i_, column_load_<uint128_t>(args_.lhs_high, args_.lhs_low, i_) -
+                                         column_load_<uint128_t>(args_.rhs_high, args_.rhs_low, i_));
+            }
+        }
+
+        template<class _Tp>
+        inline void column_less_scalar_(const column_args_ &args_, std::size_t first_, std::size_t last_) {
+            for (auto i_ = first_; i_ < last_; ++i_) {
+                args_.mask[i_] = column_load_<_Tp>(args_.lhs_high, args_.lhs_low, i_) <
+                                 column_load_<_Tp>(args_.rhs_high, args_.rhs_low, i_);
+            }
+        }
+
+        inline void column_equal_scalar_(const column_args_ &args_, std::size_t first_, std::size_t last_) {
+            for (auto i_ = first_; i_ < last_; ++i_) {
+                args_.mask[i_] = column_load_<uint128_t>(args_.lhs_high, args_.lhs_low, i_) ==
+                                 column_load_<uint128_t>(args_.rhs_high, args_.rhs_low, i_);
+            }
+        }
+
+        template<class _Tp, bool _Max>
+        inline void column_minmax_scalar_(const column_args_ &args_, std::size_t first_, std::size_t last_) {
+            for (auto i_ = first_; i_ < last_; ++i_) {
+                auto lhs_ = column_load_<_Tp>(args_.lhs_high, args_.lhs_low, i_);
+                auto rhs_ = column_load_<_Tp>(args_.rhs_high, args_.rhs_low, i_);
+                column_store_(args_, i_, (lhs_ < rhs_) != _Max ? lhs_ : rhs_);
+            }
+        }
+
+        inline void column_select_scalar_(const column_args_ &args_, std::size_t first_, std::size_t last_) {
+            for (auto i_ = first_; i_ < last_; ++i_) {
+                column_store_(args_, i_, args_.pick[i_] ? column_load_<uint128_t>(args_.lhs_high, args_.lhs_low, i_)
+                                                        : column_load_<uint128_t>(args_.rhs_high, args_.rhs_low, i_));
+            }
+        }
+
+#ifdef INT128_COLUMN_X86
+
+        // the kernels below do the full blocks, then leave the tail to the scalar ones
+
+#define INT128_COLUMN_LOAD_(vec, load, ptr) vec ptr##_ = load(reinterpret_cast<const vec *>(args_.ptr + i_))
+#define INT128_COLUMN_LOAD4_(vec, load) INT128_COLUMN_LOAD_(vec, load, lhs_high); \
+INT128_COLUMN_LOAD_(vec, load, lhs_low); INT128_COLUMN_LOAD_(vec, load, rhs_high); INT128_COLUMN_LOAD_(vec, load, rhs_low)
+
+        __attribute__((target("avx2")))
+        inline __m256i column_ult_avx2_(__m256i lhs_, __m256i rhs_) {
+            auto sign_ = _mm256_set1_epi64x(INT64_MIN);
+            return _mm256_cmpgt_epi64(_mm256_xor_si256(rhs_, sign_), _mm256_xor_si256(lhs_, sign_));
+        }
+
+        // all ones in the lanes where lhs < rhs
+        template<bool _Signed>
+        __attribute__((target("avx2")))
+        inline __m256i column_lt_avx2_(__m256i lhs_high_, __m256i lhs_low_, __m256i rhs_high_, __m256i rhs_low_) {
+            auto high_less_ = _Signed ? _mm256_cmpgt_epi64(rhs_high_, lhs_high_) : column_ult_avx2_(lhs_high_, rhs_high_);
+            return _mm256_or_si256(high_less_, _mm256_and_si256(_mm256_cmpeq_epi64(lhs_high_, rhs_high_),
+                                                                column_ult_avx2_(lhs_low_, rhs_low_)));
+        }
+
+        __attribute__((target("avx2")))
+        inline void column_store_avx2_(const column_args_ &args_, std::size_t i_, __m256i high_, __m256i low_) {
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(args_.out_high + i_), high_);
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(args_.out_low + i_), low_);
+        }
+
+        __attribute__((target("avx2")))
+        inline void column_store_mask_avx2_(const column_args_ &args_, std::size_t i_, __m256i mask_) {
+            // one bit per lane, spread to one byte per lane
+            auto bits_ = static_cast<uint32_t>(_mm256_movemask_pd(_mm256_castsi256_pd(mask_)));
+            bits_ = (bits_ | bits_ << 7U | bits_ << 14U | bits_ << 21U) & 0x01010101U;
+            memcpy(args_.mask + i_, &bits_, 4);
+        }
+
+        __attribute__((target("avx2")))
+        inline void column_add_avx2_(const column_args_ &args_, std::size_t first_, std::size_t last_) {
+            auto i_ = first_;
+            for (; i_ + 4 <= last_; i_ += 4) {
+                INT128_COLUMN_LOAD4_(__m256i, _mm256_loadu_si256);
+                auto low_ = _mm256_add_epi64(lhs_low_, rhs_low_);
+                // carry is all ones, subtracting it adds one
+                auto high_ = _mm256_sub_epi64(_mm256_add_epi64(lhs_high_, rhs_high_), column_ult_avx2_(low_, lhs_low_));
+                column_store_avx2_(args_, i_, high_, low_);
+            }
+            column_add_scalar_(args_, i_, last_);
+        }
+
+        __attribute__((target("avx2")))
+        inline void column_sub_avx2_(const column_args_ &args_, std::size_t first_, std::size_t last_) {
+            auto i_ = first_;
+            for (; i_ + 4 <= last_; i_ += 4) {
+                INT128_COLUMN_LOAD4_(__m256i, _mm256_loadu_si256);
+                auto high_ = _mm256_add_epi64(_mm256_sub_epi64(lhs_high_, rhs_high_),
+                                              column_ult_avx2_(lhs_low_, rhs_low_));
+                column_store_avx2_(args_, i_, high_, _mm256_sub_epi64(lhs_low_, rhs_low_));
+            }
+            column_sub_scalar_(args_, i_, last_);
+        }
+
+        template<class _Tp>
+        __attribute__((target("avx2")))
+        inline void column_less_avx2_(const column_args_ &args_, std::size_t first_, std::size_t last_) {
+            auto i_ = first_;
+            for (; i_ + 4 <= last_; i_ += 4) {
+                INT128_COLUMN_LOAD4_(__m256i, _mm256_loadu_si256);
+                column_store_mask_avx2_(args_, i_, column_lt_avx2_<std::is_same<_Tp, int128_t>::value>(
+                        lhs_high_, lhs_low_, rhs_high_, rhs_low_));
+            }
+            column_less_scalar_<_Tp>(args_, i_, last_);
+        }
+
+        __attribute__((target("avx2")))
+        inline void column_equal_avx2_(const column_args_ &args_, std::size_t first_, std::size_t last_) {
+            auto i_ = first_;
+            for (; i_ + 4 <= last_; i_ += 4) {
+                INT128_COLUMN_LOAD4_(__m256i, _mm256_loadu_si256);
+                column_store_mask_avx2_(args_, i_, _mm256_and_si256(_mm256_cmpeq_epi64(lhs_high_, rhs_high_),
+                                                                    _mm256_cmpeq_epi64(lhs_low_, rhs_low_)));
+            }
+            column_equal_scalar_(args_, i_, last_);
+        }
+
+        template<class _Tp, bool _Max>
+        __attribute__((target("avx2")))
+        inline void column_minmax_avx2_(const column_args_ &args_, std::size_t first_, std::size_t last_) {
+            auto i_ = first_;
+            for (; i_ + 4 <= last_; i_ += 4) {
+                INT128_COLUMN_LOAD4_(__m256i, _mm256_loadu_si256);
+                auto less_ = column_lt_avx2_<std::is_same<_Tp, int128_t>::value>(
+                        lhs_high_, lhs_low_, rhs_high_, rhs_low_);
+                if (_Max) {
+                    column_store_avx2_(args_, i_, _mm256_blendv_epi8(lhs_high_, rhs_high_, less_),
+                                       _mm256_blendv_epi8(lhs_low_, rhs_low_, less_));
+                } else {
+                    column_store_avx2_(args_, i_, _mm256_blendv_epi8(rhs_high_, lhs_high_, less_),
+                                       _mm256_blendv_epi8(rhs_low_, lhs_low_, less_));
+                }
+            }
+            column_minmax_scalar_<_Tp, _Max>(args_, i_, last_);
+        }
+
+        __attribute__((target("avx2")))
+        inline void column_select_avx2_(const column_args_ &args_, std::size_t first_, std::size_t last_) {
+            auto i_ = first_;
+            for (; i_ + 4 <= last_; i_ += 4) {
+                INT128_COLUMN_LOAD4_(__m256i, _mm256_loadu_si256);
+                int32_t bytes_;
+                memcpy(&bytes_, args_.pick + i_, 4);
+                auto zero_ = _mm256_cmpeq_epi64(_mm256_cvtepu8_epi64(_mm_cvtsi32_si128(bytes_)), _mm256_setzero_si256());
+                column_store_avx2_(args_, i_, _mm256_blendv_epi8(lhs_high_, rhs_high_, zero_),
+                                   _mm256_blendv_epi8(lhs_low_, rhs_low_, zero_));
+            }
+            column_select_scalar_(args_, i_, last_);
+        }
+
+        template<bool _Signed>
+        __attribute__((target("avx512f")))
+        inline __mmask8 column_lt_avx512_(__m512i lhs_high_, __m512i lhs_low_, __m512i rhs_high_, __m512i rhs_low_) {
+            auto high_less_ = _Signed ? _mm512_cmplt_epi64_mask(lhs_high_, rhs_high_)
+                                      : _mm512_cmplt_epu64_mask(lhs_high_, rhs_high_);
+            return static_cast<__mmask8>(high_less_ | (_mm512_cmpeq_epi64_mask(lhs_high_, rhs_high_) &
+                                                       _mm512_cmplt_epu64_mask(lhs_low_, rhs_low_)));
+        }
+
+        __attribute__((target("avx512f")))
+        inline void column_store_avx512_(const column_args_ &args_, std::size_t i_, __m512i high_, __m512i low_) {
+            _mm512_storeu_si512(args_.out_high + i_, high_);
+            _mm512_storeu_si512(args_.out_low + i_, low_);
+        }
+
+        __attribute__((target("avx512f")))
+        inline void column_store_mask_avx512_(const column_args_ &args_, std::size_t i_, __mmask8 mask_) {
+            _mm_storel_epi64(reinterpret_cast<__m128i *>(args_.mask + i_),
+                             _mm512_maskz_cvtepi64_epi8(mask_, _mm512_set1_epi64(1)));
+        }
+
+        __attribute__((target("avx512f")))
+        inline void column_add_avx512_(const column_args_ &args_, std::size_t first_, std::size_t last_) {
+            auto one_ = _mm512_set1_epi64(1);
+            auto i_ = first_;
+            for (; i_ + 8 <= last_; i_ += 8) {
+                INT128_COLUMN_LOAD4_(__m512i, _mm512_loadu_si512);
+                auto low_ = _mm512_add_epi64(lhs_low_, rhs_low_);
+                auto high_ = _mm512_add_epi64(lhs_high_, rhs_high_);
+                high_ = _mm512_mask_add_epi64(high_, _mm512_cmplt_epu64_mask(low_, lhs_low_), high_, one_);
+                column_store_avx512_(args_, i_, high_, low_);
+            }
+            column_add_scalar_(args_, i_, last_);
+        }
+
+        __attribute__((target("avx512f")))
+        inline void column_sub_avx512_(const column_args_ &args_, std::size_t first_, std::size_t last_) {
+            auto one_ = _mm512_set1_epi64(1);
+            auto i_ = first_;
+            for (; i_ + 8 <= last_; i_ += 8) {
+                INT128_COLUMN_LOAD4_(__m512i, _mm512_loadu_si512);
+                auto high_ = _mm512_sub_epi64(lhs_high_, rhs_high_);
+                high_ = _mm512_mask_sub_epi64(high_, _mm512_cmplt_epu64_mask(lhs_low_, rhs_low_), high_, one_);
+                column_store_avx512_(args_, i_, high_, _mm512_sub_epi64(lhs_low_, rhs_low_));
+            }
+            column_sub_scalar_(args_, i_, last_);
+        }
+
+        template<class _Tp>
+        __attribute__((target("avx512f")))
+        inline void column_less_avx512_(const column_args_ &args_, std::size_t first_, std::size_t last_) {
+            auto i_ = first_;
+            for (; i_ + 8 <= last_; i_ += 8) {
+                INT128_COLUMN_LOAD4_(__m512i, _mm512_loadu_si512);
+                column_store_mask_avx512_(args_, i_, column_lt_avx512_<std::is_same<_Tp, int128_t>::value>(
+                        lhs_high_, lhs_low_, rhs_high_, rhs_low_));
+            }
+            column_less_scalar_<_Tp>(args_, i_, last_);
+        }
+
+        __attribute__((target("avx512f")))
+        inline void column_equal_avx512_(const column_args_ &args_, std::size_t first_, std::size_t last_) {
+            auto i_ = first_;
+            for (; i_ + 8 <= last_; i_ += 8) {
+                INT128_COLUMN_LOAD4_(__m512i, _mm512_loadu_si512);
+                column_store_mask_avx512_(args_, i_, static_cast<__mmask8>(
+                        _mm512_cmpeq_epi64_mask(lhs_high_, rhs_high_) & _mm512_cmpeq_epi64_mask(lhs_low_, rhs_low_)));
+            }
+            column_equal_scalar_(args_, i_, last_);
+        }
+
+        template<class _Tp, bool _Max>
+        __attribute__((target("avx512f")))
+        inline void column_minmax_avx512_(const column_args_ &args_, std::size_t first_, std::size_t last_) {
+            auto i_ = first_;
+            for (; i_ + 8 <= last_; i_ += 8) {
+                INT128_COLUMN_LOAD4_(__m512i, _mm512_loadu_si512);
+                auto less_ = column_lt_avx512_<std::is_same<_Tp, int128_t>::value>(
+                        lhs_high_, lhs_low_, rhs_high_, rhs_low_);
+                if (_Max) less_ = static_cast<__mmask8>(~less_);
+                column_store_avx512_(args_, i_, _mm512_mask_blend_epi64(less_, rhs_high_, lhs_high_),
+                                     _mm512_mask_blend_epi64(less_, rhs_low_, lhs_low_));
+            }
+            column_minmax_scalar_<_Tp, _Max>(args_, i_, last_);
+        }
+
+        __attribute__((target("avx512f")))
+        inline void column_select_avx512_(const column_args_ &args_, std::size_t first_, std::size_t last_) {
+            auto i_ = first_;
+            for (; i_ + 8 <= last_; i_ += 8) {
+                INT128_COLUMN_LOAD4_(__m512i, _mm512_loadu_si512);
+                // the maskz form keeps gcc from warning on the undefined source of the plain one
+                auto bytes_ = _mm512_maskz_cvtepu8_epi64(0xff, _mm_loadl_epi64(
+                        reinterpret_cast<const __m128i *>(args_.pick + i_)));
+                auto pick_ = _mm512_test_epi64_mask(bytes_, bytes_);
+                column_store_avx512_(args_, i_, _mm512_mask_blend_epi64(pick_, rhs_high_, lhs_high_),
+                                     _mm512_mask_blend_epi64(pick_, rhs_low_, lhs_low_));
+            }
+            column_select_scalar_(args_, i_, last_);
+        }
+
+#undef INT128_COLUMN_LOAD4_
+#undef INT128_COLUMN_LOAD_
+
+#endif
+
+        struct column_table_ {
+            column_fn_ add, sub, equal, select;
+            column_fn_ less[2], min[2], max[2]; // [unsigned, signed]
+        };
+
+        template<class _Tp>
+        inline std::size_t column_signed_() { return std::is_same<_Tp, int128_t>::value; }
+
+        inline const column_table_ &column_scalar_kernels_() {
+            static const column_table_ table_ = {
+                    column_add_scalar_, column_sub_scalar_, column_equal_scalar_, column_select_scalar_,
+                    {column_less_scalar_<uint128_t>, column_less_scalar_<int128_t>},
+                    {column_minmax_scalar_<uint128_t, false>, column_minmax_scalar_<int128_t, false>},
+                    {column_minmax_scalar_<uint128_t, true>, column_minmax_scalar_<int128_t, true>}};
+            return table_;
+        }
+
+#ifdef INT128_COLUMN_X86
+
+        // callable only where __builtin_cpu_supports says so, the tests pick them directly
+        inline const column_table_ &column_avx2_kernels_() {
+            static const column_table_ table_ = {
+                    column_add_avx2_, column_sub_avx2_, column_equal_avx2_, column_select_avx2_,
+                    {column_less_avx2_<uint128_t>, column_less_avx2_<int128_t>},
+                    {column_minmax_avx2_<uint128_t, false>, column_minmax_avx2_<int128_t, false>},
+                    {column_minmax_avx2_<uint128_t, true>, column_minmax_avx2_<int128_t, true>}};
+            return table_;
+        }
+
+        inline const column_table_ &column_avx512_kernels_() {
+            static const column_table_ table_ = {
+                    column_add_avx512_, column_sub_avx512_, column_equal_avx512_, column_select_avx512_,
+                    {column_less_avx512_<uint128_t>, column_less_avx512_<int128_t>},
+                    {column_minmax_avx512_<uint128_t, false>, column_minmax_avx512_<int128_t, false>},
+                    {column_minmax_avx512_<uint128_t, true>, column_minmax_avx512_<int128_t, true>}};
+            return table_;
+        }
+
+#endif
+
+        // best kernels of the running cpu, resolved once
+        inline const column_table_ &column_kernels_() {
+#ifdef INT128_COLUMN_X86
+            static const column_table_ &best_ = __builtin_cpu_supports("avx512f") ? column_avx512_kernels_() :
+                                                  __builtin_cpu_supports("avx2") ? column_avx2_kernels_()
+                                                                                 : column_scalar_kernels_();
+            return best_;
+#else
+            return column_scalar_kernels_();
+#endif
+        }
+
+        // elementwise over the shorter of lhs_ and rhs_, out_ may be one of them
+        template<class _Tp>
+        inline void column_apply_(column_fn_ fn_, const column128<_Tp> &lhs_, const column128<_Tp> &rhs_,
+                                  column128<_Tp> &out_, const uint8_t *pick_ = nullptr) {
+            auto size_ = lhs_.size() < rhs_.size() ? lhs_.size() : rhs_.size();
+            if (out_.size() < size_) out_.resize(size_);
+            fn_({lhs_.high(), lhs_.low(), rhs_.high(), rhs_.low(), out_.high(), out_.low(), nullptr, pick_}, 0, size_);
+        }
+
+        template<class _Tp>
+        inline void column_compare_(column_fn_ fn_, const column128<_Tp> &lhs_, const column128<_Tp> &rhs_,
+                                    uint8_t *mask_) {
+            auto size_ = lhs_.size() < rhs_.size() ? lhs_.size() : rhs_.size();
+            fn_({lhs_.high(), lhs_.low(), rhs_.high(), rhs_.low(), nullptr, nullptr, mask_, nullptr}, 0, size_);
+        }
+    }
+
+    // out_[i] = lhs_[i] + rhs_[i] wrapping like operator+, out_ is grown to fit
+    template<class _Tp>
+    inline void column_add(const column128<_Tp> &lhs_, const column128<_Tp> &rhs_, column128<_Tp> &out_) {
+        detail_::column_apply_(detail_::column_kernels_().add, lhs_, rhs_, out_);
+    }
+
+    template<class _Tp>
+    inline void column_sub(const column128<_Tp> &lhs_, const column128<_Tp> &rhs_, column128<_Tp> &out_) {
+        detail_::column_apply_(detail_::column_kernels_().sub, lhs_, rhs_, out_);
+    }
+
+    template<class _Tp>
+    inline void column_min(const column128<_Tp> &lhs_, const column128<_Tp> &rhs_, column128<_Tp> &out_) {
+        detail_::column_apply_(detail_::column_kernels_().min[detail_::column_signed_<_Tp>()], lhs_, rhs_, out_);
+    }
+
+    template<class _Tp>
+    inline void column_max(const column128<_Tp> &lhs_, const column128<_Tp> &rhs_, column128<_Tp> &out_) {
+        detail_::column_apply_(detail_::column_kernels_().max[detail_::column_signed_<_Tp>()], lhs_, rhs_, out_);
+    }
+
+    // out_[i] = mask_[i] ? lhs_[i] : rhs_[i]
+    template<class _Tp>
+    inline void column_select(const uint8_t *mask_, const column128<_Tp> &lhs_, const column128<_Tp> &rhs_,
+                              column128<_Tp> &out_) {
+        detail_::column_apply_(detail_::column_kernels_().select, lhs_, rhs_, out_, mask_);
+    }
+
+    // mask_[i] = lhs_[i] < rhs_[i] as 0 or 1, mask_ holds the shorter of the two sizes
+    template<class _Tp>
+    inline void column_less(const column128<_Tp> &lhs_, const column128<_Tp> &rhs_, uint8_t *mask_) {
+        detail_::column_compare_(detail_::column_kernels_().less[detail_::column_signed_<_Tp>()], lhs_, rhs_, mask_);
+    }
+
+    template<class _Tp>
+    inline void column_equal(const column128<_Tp> &lhs_, const column128<_Tp> &rhs_, uint8_t *mask_) {
+        detail_::column_compare_(detail_::column_kernels_().equal, lhs_, rhs_, mask_);
+    }
+}
@@ -0,0 +1,173 @@
+#pragma once
+
+#include "int128.h"
+
+#include <string>
+
+// fixed point decimal<Scale> on int128_t, the value times 10^Scale, up to 38 fraction digits. Rescaling down
+// multiplies by the cached reciprocal of a uint128_divider instead of dividing, products go through 256 bits and
+// round once.
+namespace large_int {
+    namespace detail_ {
+        template<unsigned _N>
+        inline const uint128_divider &pow10_divider_() {
+            static const uint128_divider div_(pow10_(_N));
+            return div_;
+        }
+
+        // mag_ / 10^_N rounded as mode_ for a value of sign neg_
+        template<unsigned _N>
+        inline uint128_t scale_down_(uint128_t mag_, bool neg_, rounding mode_) {
+            auto &div_ = pow10_divider_<_N>();
+            auto res_ = div_.divmod(mag_);
+            return res_.quot + uint128_t(round_away_(mode_, neg_, res_.quot, res_.rem, div_.divisor()));
+        }
+
+        template<unsigned _From, unsigned _To>
+        inline int128_t rescale_(int128_t raw_, rounding mode_, std::true_type /* down */) {
+            bool neg_ = raw_ < int128_t(0);
+            auto quot_ = scale_down_<_From - _To>(neg_ ? -uint128_t(raw_) : uint128_t(raw_), neg_, mode_);
+            return int128_t(neg_ ? -quot_ : quot_);
+        }
+
+        template<unsigned _From, unsigned _To>
+        constexpr int128_t rescale_(int128_t raw_, rounding, std::false_type) {
+            return raw_ * int128_t(pow10_(_To - _From));
+        }
+    }
+
+    template<unsigned _Scale>
+    class decimal {
+        static_assert(_Scale <= 38, "10^_Scale must fit in int128_t");
+
+        struct raw_tag_ {
+        };
+
+        int128_t value_; // the value times 10^_Scale
+
+        constexpr decimal(int128_t raw_, raw_tag_) : value_(raw_) {}
+
+    public:
+        static constexpr unsigned scale = _Scale;
+
+        constexpr decimal() : value_(0) {}
+
+        // int_ with a zero fraction, wraps if int_ * 10^_Scale does not fit
+        template<class _Tp, class = typename std::enable_if<std::is_integral<_Tp>::value>::type>
+        constexpr decimal(_Tp int_) : value_(int128_t(int_) * int128_t(detail_::pow10_(_Scale))) {} // NOLINT explicit
+
+        constexpr decimal(int128_t int_) : value_(int_ * int128_t(detail_::pow10_(_Scale))) {} // NOLINT explicit
+
+        // raw_ / 10^_Scale
+        static constexpr decimal from_raw(int128_t raw_) { return decimal(raw_, raw_tag_()); }
+
+        constexpr int128_t raw() const { return value_; }
+
+        // the same value with _To fraction digits, rounded as mode_ when digits drop, wraps when they are added and
+        // it does not fit
+        template<unsigned _To>
+        decimal<_To> rescale(rounding mode_ = rounding::half_even) const {
+            return decimal<_To>::from_raw(
+                    detail_::rescale_<_Scale, _To>(value_, mode_, std::integral_constant<bool, (_To < _Scale)>()));
+        }
+
+        int128_t to_integer(rounding mode_ = rounding::toward_zero) const { return rescale<0>(mode_).raw(); }
+
+        constexpr decimal operator+() const { return *this; }
+
+        constexpr decimal operator-() const { return from_raw(-value_); }
+
+        decimal &operator+=(decimal rhs_) {
+            value_ += rhs_.value_;
+            return *this;
+        }
+
+        decimal &operator-=(decimal rhs_) {
+            value_ -= rhs_.value_;
+            return *this;
+        }
+
+        decimal &operator*=(decimal rhs_) { return *this = *this * rhs_; }
+
+        decimal &operator/=(decimal rhs_) { return *this = *this / rhs_; }
+
+        friend constexpr decimal operator+(decimal lhs_, decimal rhs_) { return from_raw(lhs_.value_ + rhs_.value_); }
+
+        friend constexpr decimal operator-(decimal lhs_, decimal rhs_) { return from_raw(lhs_.value_ - rhs_.value_); }
+
+        // half_even, mul and div take the mode
+        friend decimal operator*(decimal lhs_, decimal rhs_) { return mul(lhs_, rhs_); }
+
+        friend decimal operator/(decimal lhs_, decimal rhs_) { return div(lhs_, rhs_); }
+
+        friend constexpr bool operator==(decimal lhs_, decimal rhs_) { return lhs_.value_ == rhs_.value_; }
+
+        friend constexpr bool operator!=(decimal lhs_, decimal rhs_) { return lhs_.value_ != rhs_.value_; }
+
+        friend constexpr bool operator<(decimal lhs_, decimal rhs_) { return lhs_.value_ < rhs_.value_; }
+
+        friend constexpr bool operator>(decimal lhs_, decimal rhs_) { return lhs_.value_ > rhs_.value_; }
+
+        friend constexpr bool operator<=(decimal lhs_, decimal rhs_) { return lhs_.value_ <= rhs_.value_; }
+
+        friend constexpr bool operator>=(decimal lhs_, decimal rhs_) { return lhs_.value_ >= rhs_.value_; }
+    };
+
+    template<unsigned _Scale>
+    constexpr unsigned decimal<_Scale>::scale;
+
+    // lhs_ * rhs_ rounded once to _Scale digits. The raw product is 256 bits, one under 2^128 takes the reciprocal of
+    // 10^_Scale, a wider one the long division. The result wraps if it does not fit.
+    template<unsigned _Scale>
+    inline decimal<_Scale> mul(decimal<_Scale> lhs_, decimal<_Scale> rhs_, rounding mode_ = rounding::half_even) {
+        bool lneg_ = lhs_.raw() < int128_t(0), rneg_ = rhs_.raw() < int128_t(0), neg_ = lneg_ ^ rneg_;
+        auto prod_ = mul_wide(lneg_ ? -uint128_t(lhs_.raw()) : uint128_t(lhs_.raw()),
+                              rneg_ ? -uint128_t(rhs_.raw()) : uint128_t(rhs_.raw()));
+        uint128_t quot_;
+        if (!prod_.high) {
+            quot_ = detail_::scale_down_<_Scale>(prod_.low, neg_, mode_);
+        } else {
+            uint128_t rem_;
+            quot_ = detail_::div_256_128_(prod_.high, prod_.low, detail_::pow10_(_Scale), rem_);
+            quot_ += uint128_t(detail_::round_away_(mode_, neg_, quot_, rem_, detail_::pow10_(_Scale)));
+        }
+        return decimal<_Scale>::from_raw(int128_t(neg_ ? -quot_ : quot_));
+    }
+
+    // lhs_ / rhs_ rounded once to _Scale digits, a zero rhs_ raises SIGFPE
+    template<unsigned _Scale>
+    inline decimal<_Scale> div(decimal<_Scale> lhs_, decimal<_Scale> rhs_, rounding mode_ = rounding::half_even) {
+        return decimal<_Scale>::from_raw(muldiv(lhs_.raw(), int128_t(detail_::pow10_(_Scale)), rhs_.raw(), mode_));
+    }
+
+    // locale free, "-12.340" for decimal<3>. Returns value_too_large and last_ if the buffer is short.
+    template<unsigned _Scale>
+    inline to_chars_result to_chars(char *first_, char *last_, decimal<_Scale> value_) {
+        bool neg_ = value_.raw() < int128_t(0);
+        char buf_[40];
+        auto len_ = detail_::write_fixed_(buf_, neg_ ? -uint128_t(value_.raw()) : uint128_t(value_.raw()), _Scale);
+        auto int_ = len_ - int(_Scale);
+        if (last_ - first_ < len_ + neg_ + !!_Scale) return {last_, std::errc::value_too_large};
+        if (neg_) *first_++ = '-';
+        memcpy(first_, buf_, static_cast<std::size_t>(int_));
+        first_ += int_;
+        if (_Scale) {
+            *first_++ = '.';
+            memcpy(first_, buf_ + int_, _Scale);
+            first_ += _Scale;
+        }
+        return {first_, std::errc()};
+    }
+
+    template<unsigned _Scale>
+    inline std::string to_string(decimal<_Scale> value_) {
+        char buf_[41];
+        return std::string(buf_, to_chars(buf_, buf_ + sizeof(buf_), value_).ptr);
+    }
+
+    // one pass over the digits, the point placed by print_value with the locale's decimal_point and grouping
+    template<class _CharT, class _Traits, unsigned _Scale>
+    inline std::basic_ostream<_CharT, _Traits> &operator<<(std::basic_ostream<_CharT, _Traits> &out, decimal<_Scale> _Val) {
+        return print_value(out, true, uint128_t(_Val.raw()), int(_Scale));
+    }
+}
@@ -0,0 +1,190 @@
+#pragma once
+
+#include "int128.h"
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#define INT128_FLOAT_X86 1
+#include <immintrin.h>
+#endif
+
+// int128_t/uint128_t arrays to and from float or double, 8 values at once on AVX-512 (F, DQ and CD), rounded and
+// saturated exactly as the casts and cast_overflow are
+namespace large_int {
+    namespace detail_ {
+        template<class _Tp, class _Int>
+        struct float_batch_ {
+            void (*to)(_Tp *, const _Int *, std::size_t);
+
+            std::size_t (*from)(_Int *, const _Tp *, std::size_t);
+        };
+
+        template<class _Tp, class _Int>
+        inline void to_float_scalar_(_Tp *out_, const _Int *values_, std::size_t count_) {
+            for (std::size_t i_ = 0; i_ < count_; ++i_) out_[i_] = static_cast<_Tp>(values_[i_]);
+        }
+
+        template<class _Tp, class _Int>
+        inline std::size_t from_float_scalar_(_Int *out_, const _Tp *values_, std::size_t count_) {
+            std::size_t bad_ = 0;
+            for (std::size_t i_ = 0; i_ < count_; ++i_) bad_ += cast_overflow(values_[i_], out_[i_]);
+            return bad_;
+        }
+
+        template<class _Tp, class _Int>
+        inline const float_batch_<_Tp, _Int> &float_pick_(std::false_type) {
+            static const float_batch_<_Tp, _Int> scalar_ = {to_float_scalar_<_Tp, _Int>, from_float_scalar_<_Tp, _Int>};
+            return scalar_;
+        }
+
+#ifdef INT128_FLOAT_X86
+
+        // the maskz forms with a full mask keep gcc from warning on the undefined source of the plain ones
+
+        // 8 values, interleaved low and high in memory, split into a vector of each
+        __attribute__((target("avx512f")))
+        inline void float_load8_(const void *values_, __m512i &low_, __m512i &high_) {
+            auto first_ = _mm512_loadu_si512(values_);
+            auto second_ = _mm512_loadu_si512(static_cast<const char *>(values_) + 64);
+            low_ = _mm512_permutex2var_epi64(first_, _mm512_set_epi64(14, 12, 10, 8, 6, 4, 2, 0), second_);
+            high_ = _mm512_permutex2var_epi64(first_, _mm512_set_epi64(15, 13, 11, 9, 7, 5, 3, 1), second_);
+        }
+
+        __attribute__((target("avx512f")))
+        inline void float_store8_(void *values_, __m512i low_, __m512i high_) {
+            _mm512_storeu_si512(values_, _mm512_permutex2var_epi64(
+                    low_, _mm512_set_epi64(11, 3, 10, 2, 9, 1, 8, 0), high_));
+            _mm512_storeu_si512(static_cast<char *>(values_) + 64, _mm512_permutex2var_epi64(
+                    low_, _mm512_set_epi64(15, 7, 14, 6, 13, 5, 12, 4), high_));
+        }
+
+        // two's complement negation of the lanes in neg_
+        __attribute__((target("avx512f")))
+        inline void float_negate8_(__mmask8 neg_, __m512i &low_, __m512i &high_) {
+            auto zero_ = _mm512_setzero_si512();
+            auto borrow_ = _mm512_maskz_set1_epi64(_mm512_test_epi64_mask(low_, low_), 1);
+            high_ = _mm512_mask_sub_epi64(high_, neg_, _mm512_sub_epi64(zero_, high_), borrow_);
+            low_ = _mm512_mask_sub_epi64(low_, neg_, zero_, low_);
+        }
+
+        // sticky_top_ of each lane, shift_ is how far it was moved down, 0 when the high half is zero
+        __attribute__((target("avx512f,avx512cd")))
+        inline __m512i float_top8_(__m512i low_, __m512i high_, __m512i &shift_) {
+            auto lz_ = _mm512_lzcnt_epi64(high_);
+            shift_ = _mm512_sub_epi64(_mm512_set1_epi64(64), lz_);
+            auto top_ = _mm512_or_si512(_mm512_maskz_sllv_epi64(0xff, high_, lz_),
+                                        _mm512_maskz_srlv_epi64(0xff, low_, shift_));
+            auto lost_ = _mm512_maskz_sllv_epi64(0xff, low_, lz_);
+            return _mm512_mask_or_epi64(top_, _mm512_test_epi64_mask(lost_, lost_), top_, _mm512_set1_epi64(1));
+        }
+
+        // top_ rounded once, then the exponent raised by shift_
+        __attribute__((target("avx512f,avx512dq")))
+        inline void float_round8_(double *out_, __m512i top_, __m512i shift_, __mmask8 neg_) {
+            auto bits_ = _mm512_add_epi64(_mm512_castpd_si512(_mm512_cvtepu64_pd(top_)),
+                                          _mm512_maskz_slli_epi64(0xff, shift_, 52));
+            bits_ = _mm512_mask_or_epi64(bits_, neg_, bits_, _mm512_set1_epi64(INT64_MIN));
+            _mm512_storeu_si512(out_, bits_);
+        }
+
+        // 2^128 carries into an all ones exponent with a zero mantissa, infinity as the cast gives
+        __attribute__((target("avx512f,avx512dq")))
+        inline void float_round8_(float *out_, __m512i top_, __m512i shift_, __mmask8 neg_) {
+            auto bits_ = _mm256_add_epi32(_mm256_castps_si256(_mm512_cvtepu64_ps(top_)),
+                                          _mm512_maskz_cvtepi64_epi32(0xff, _mm512_maskz_slli_epi64(0xff, shift_, 23)));
+            bits_ = _mm256_or_si256(bits_, _mm512_maskz_cvtepi64_epi32(0xff, _mm512_maskz_set1_epi64(neg_, INT32_MIN)));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(out_), bits_);
+        }
+
+        __attribute__((target("avx512f")))
+        inline __m512d float_widen8_(const double *values_) { return _mm512_loadu_pd(values_); }
+
+        __attribute__((target("avx512f")))
+        inline __m512d float_widen8_(const float *values_) { return _mm512_maskz_cvtps_pd(0xff, _mm256_loadu_ps(values_)); }
+
+        template<class _Tp, class _Int>
+        __attribute__((target("avx512f,avx512dq,avx512cd")))
+        void to_float_avx512_(_Tp *out_, const _Int *values_, std::size_t count_) {
+            std::size_t i_ = 0;
+            for (; i_ + 8 <= count_; i_ += 8) {
+                __m512i low_, high_, shift_;
+                float_load8_(values_ + i_, low_, high_);
+                __mmask8 neg_ = 0;
+                if (std::is_same<_Int, int128_t>::value) {
+                    neg_ = _mm512_cmplt_epi64_mask(high_, _mm512_setzero_si512());
+                    float_negate8_(neg_, low_, high_);
+                }
+                auto top_ = float_top8_(low_, high_, shift_);
+                float_round8_(out_ + i_, top_, shift_, neg_);
+            }
+            to_float_scalar_(out_ + i_, values_ + i_, count_ - i_);
+        }
+
+        // |val_| / 2^64 and the remainder truncate into the two halves exactly, lanes out of range or NaN are
+        // replaced afterwards
+        template<class _Tp, class _Int>
+        __attribute__((target("avx512f,avx512dq")))
+        std::size_t from_float_avx512_(_Int *out_, const _Tp *values_, std::size_t count_) {
+            typedef typename std::conditional<std::is_same<_Int, int128_t>::value, int64_t, uint64_t>::type _Hi;
+            const bool signed_ = std::is_signed<_Hi>::value;
+            const auto two64_ = _mm512_set1_pd(detail_::two64_<double>());
+            const auto upper_ = _mm512_set1_pd(double(float_upper_<_Hi>()));
+            const auto lower_ = _mm512_set1_pd(signed_ ? -double(float_upper_<_Hi>()) : -1.0);
+            const auto max_high_ = _mm512_set1_epi64(signed_ ? INT64_MAX : -1);
+            const auto min_high_ = _mm512_set1_epi64(signed_ ? INT64_MIN : 0);
+            std::size_t bad_ = 0, i_ = 0;
+            for (; i_ + 8 <= count_; i_ += 8) {
+                auto val_ = float_widen8_(values_ + i_);
+                auto mag_ = _mm512_abs_pd(val_);
+                auto high_ = _mm512_cvttpd_epu64(_mm512_div_pd(mag_, two64_));
+                auto low_ = _mm512_cvttpd_epu64(_mm512_fnmadd_pd(_mm512_cvtepu64_pd(high_), two64_, mag_));
+                float_negate8_(_mm512_cmp_pd_mask(val_, _mm512_setzero_pd(), _CMP_LT_OQ), low_, high_);
+                auto above_ = _mm512_cmp_pd_mask(val_, upper_, _CMP_GE_OQ);
+                auto below_ = _mm512_cmp_pd_mask(val_, lower_, signed_ ? _CMP_LT_OQ : _CMP_LE_OQ);
+                auto nan_ = _mm512_cmp_pd_mask(val_, val_, _CMP_UNORD_Q);
+                high_ = _mm512_mask_mov_epi64(high_, above_, max_high_);
+                low_ = _mm512_mask_mov_epi64(low_, above_, _mm512_set1_epi64(-1));
+                high_ = _mm512_mask_mov_epi64(high_, below_ | nan_, _mm512_maskz_mov_epi64(below_, min_high_));
+                low_ = _mm512_maskz_mov_epi64(static_cast<__mmask8>(~(below_ | nan_)), low_);
+                float_store8_(out_ + i_, low_, high_);
+                bad_ += static_cast<std::size_t>(__builtin_popcount(above_ | below_ | nan_));
+            }
+            return bad_ + from_float_scalar_(out_ + i_, values_ + i_, count_ - i_);
+        }
+
+        template<class _Tp, class _Int>
+        inline const float_batch_<_Tp, _Int> &float_pick_(std::true_type) {
+            static const float_batch_<_Tp, _Int> avx512_ = {to_float_avx512_<_Tp, _Int>,
+                                                            from_float_avx512_<_Tp, _Int>};
+            static const float_batch_<_Tp, _Int> &best_ =
+                    __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq") &&
+                    __builtin_cpu_supports("avx512cd") ? avx512_ : float_pick_<_Tp, _Int>(std::false_type());
+            return best_;
+        }
+
+#endif
+
+        template<class _Tp, class _Int>
+        inline const float_batch_<_Tp, _Int> &float_kernels_() {
+#ifdef INT128_FLOAT_X86
+            return float_pick_<_Tp, _Int>(std::integral_constant<bool, std::is_same<_Tp, double>::value ||
+                                                                       std::is_same<_Tp, float>::value>());
+#else
+            return float_pick_<_Tp, _Int>(std::false_type());
+#endif
+        }
+    }
+
+    // out_[i] = _Tp(values_[i]), rounded once to nearest even
+    template<class _Tp, class _Hi, class _Low>
+    inline typename std::enable_if<std::is_floating_point<_Tp>::value>::type
+    to_float_batch(_Tp *out_, const int128_base<_Hi, _Low> *values_, std::size_t count_) {
+        detail_::float_kernels_<_Tp, int128_base<_Hi, _Low> >().to(out_, values_, count_);
+    }
+
+    // out_[i] as cast_overflow gives it, returns how many were NaN or out of range
+    template<class _Tp, class _Hi, class _Low>
+    inline typename std::enable_if<std::is_floating_point<_Tp>::value, std::size_t>::type
+    from_float_batch(int128_base<_Hi, _Low> *out_, const _Tp *values_, std::size_t count_) {
+        return detail_::float_kernels_<_Tp, int128_base<_Hi, _Low> >().from(out_, values_, count_);
+    }
+}
@@ -0,0 +1,211 @@
+#pragma once
+
+#include "int128.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define INT128_HEX_X86 1
+#include <immintrin.h>
+#endif
+
+// fixed width hex of uint128_t: 32 digits, most significant first, no prefix and no terminating null
+namespace large_int {
+    namespace detail_ {
+        inline void hex_encode_scalar_(char *out_, const uint128_t *values_, std::size_t count_, bool upper_) {
+            auto digits_ = upper_ ? upper_digits_() : lower_digits_();
+            for (std::size_t i_ = 0; i_ < count_; ++i_, out_ += 32) {
+                auto high_ = static_cast<uint64_t>(values_[i_] >> 64), low_ = static_cast<uint64_t>(values_[i_]);
+                for (int j_ = 15; j_ >= 0; --j_, high_ >>= 4U, low_ >>= 4U) {
+                    out_[j_] = digits_[high_ & 15U];
+                    out_[j_ + 16] = digits_[low_ & 15U];
+                }
+            }
+        }
+
+        inline std::size_t hex_decode_scalar_(const char *in_, uint128_t *values_, std::size_t count_) {
+            for (std::size_t i_ = 0; i_ < count_; ++i_, in_ += 32) {
+                uint64_t high_ = 0, low_ = 0;
+                unsigned bad_ = 0;
+                for (int j_ = 0; j_ < 16; ++j_) {
+                    auto h_ = digit_value_(in_[j_]), l_ = digit_value_(in_[j_ + 16]);
+                    bad_ |= (h_ | l_) & ~15U;
+                    high_ = high_ << 4U | (h_ & 15U);
+                    low_ = low_ << 4U | (l_ & 15U);
+                }
+                if (bad_) return i_;
+                values_[i_] = uint128_t(high_) << 64 | uint128_t(low_);
+            }
+            return count_;
+        }
+
+#ifdef INT128_HEX_X86
+
+        // 16 bytes of one value, least significant first as uint128_t is laid out on x86
+
+        __attribute__((target("sse2")))
+        inline __m128i hex_reverse_sse2_(__m128i val_) {
+            val_ = _mm_shuffle_epi32(val_, _MM_SHUFFLE(0, 1, 2, 3));
+            val_ = _mm_shufflehi_epi16(_mm_shufflelo_epi16(val_, _MM_SHUFFLE(2, 3, 0, 1)), _MM_SHUFFLE(2, 3, 0, 1));
+            return _mm_or_si128(_mm_slli_epi16(val_, 8), _mm_srli_epi16(val_, 8));
+        }
+
+        // nibble values of 16 hex digits, valid_ clears bits of the bad ones
+        __attribute__((target("sse2")))
+        inline __m128i hex_nibbles_sse2_(__m128i chars_, int &valid_) {
+            auto dec_ = _mm_sub_epi8(chars_, _mm_set1_epi8('0'));
+            auto is_dec_ = _mm_cmpeq_epi8(_mm_min_epu8(dec_, _mm_set1_epi8(9)), dec_);
+            auto alpha_ = _mm_sub_epi8(_mm_or_si128(chars_, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+            auto is_alpha_ = _mm_cmpeq_epi8(_mm_min_epu8(alpha_, _mm_set1_epi8(5)), alpha_);
+            valid_ &= _mm_movemask_epi8(_mm_or_si128(is_dec_, is_alpha_));
+            return _mm_or_si128(_mm_and_si128(dec_, is_dec_),
+                                _mm_and_si128(_mm_add_epi8(alpha_, _mm_set1_epi8(10)), is_alpha_));
+        }
+
+        __attribute__((target("sse2")))
+        inline void hex_encode_sse2_(char *out_, const uint128_t *values_, std::size_t count_, bool upper_) {
+            auto alpha_ = _mm_set1_epi8(static_cast<char>(upper_ ? 'A' - '0' - 10 : 'a' - '0' - 10));
+            auto mask_ = _mm_set1_epi8(0x0f);
+            for (std::size_t i_ = 0; i_ < count_; ++i_, out_ += 32) {
+                auto val_ = hex_reverse_sse2_(_mm_loadu_si128(reinterpret_cast<const __m128i *>(values_ + i_)));
+                auto hi_ = _mm_and_si128(_mm_srli_epi16(val_, 4), mask_), lo_ = _mm_and_si128(val_, mask_);
+                hi_ = _mm_add_epi8(_mm_add_epi8(hi_, _mm_set1_epi8('0')),
+                                   _mm_and_si128(_mm_cmpgt_epi8(hi_, _mm_set1_epi8(9)), alpha_));
+                lo_ = _mm_add_epi8(_mm_add_epi8(lo_, _mm_set1_epi8('0')),
+                                   _mm_and_si128(_mm_cmpgt_epi8(lo_, _mm_set1_epi8(9)), alpha_));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(out_), _mm_unpacklo_epi8(hi_, lo_));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(out_ + 16), _mm_unpackhi_epi8(hi_, lo_));
+            }
+        }
+
+        __attribute__((target("sse2")))
+        inline std::size_t hex_decode_sse2_(const char *in_, uint128_t *values_, std::size_t count_) {
+            auto low_byte_ = _mm_set1_epi16(0xff);
+            for (std::size_t i_ = 0; i_ < count_; ++i_, in_ += 32) {
+                int valid_ = 0xffff;
+                auto a_ = hex_nibbles_sse2_(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in_)), valid_);
+                auto b_ = hex_nibbles_sse2_(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in_ + 16)), valid_);
+                if (valid_ != 0xffff) return i_;
+                // even digit is the high nibble, lands in the low byte of each 16-bit lane
+                a_ = _mm_or_si128(_mm_slli_epi16(_mm_and_si128(a_, low_byte_), 4), _mm_srli_epi16(a_, 8));
+                b_ = _mm_or_si128(_mm_slli_epi16(_mm_and_si128(b_, low_byte_), 4), _mm_srli_epi16(b_, 8));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(values_ + i_), hex_reverse_sse2_(_mm_packus_epi16(a_, b_)));
+            }
+            return count_;
+        }
+
+        __attribute__((target("ssse3")))
+        inline void hex_encode_ssse3_(char *out_, const uint128_t *values_, std::size_t count_, bool upper_) {
+            auto rev_ = _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+            auto lut_ = _mm_loadu_si128(reinterpret_cast<const __m128i *>(upper_ ? upper_digits_() : lower_digits_()));
+            auto mask_ = _mm_set1_epi8(0x0f);
+            for (std::size_t i_ = 0; i_ < count_; ++i_, out_ += 32) {
+                auto val_ = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(values_ + i_)), rev_);
+                auto hi_ = _mm_shuffle_epi8(lut_, _mm_and_si128(_mm_srli_epi16(val_, 4), mask_));
+                auto lo_ = _mm_shuffle_epi8(lut_, _mm_and_si128(val_, mask_));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(out_), _mm_unpacklo_epi8(hi_, lo_));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(out_ + 16), _mm_unpackhi_epi8(hi_, lo_));
+            }
+        }
+
+        __attribute__((target("ssse3")))
+        inline std::size_t hex_decode_ssse3_(const char *in_, uint128_t *values_, std::size_t count_) {
+            auto rev_ = _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+            auto weight_ = _mm_set1_epi16(0x0110); // high nibble * 16 + low nibble
+            for (std::size_t i_ = 0; i_ < count_; ++i_, in_ += 32) {
+                int valid_ = 0xffff;
+                auto a_ = hex_nibbles_sse2_(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in_)), valid_);
+                auto b_ = hex_nibbles_sse2_(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in_ + 16)), valid_);
+                if (valid_ != 0xffff) return i_;
+                auto bytes_ = _mm_packus_epi16(_mm_maddubs_epi16(a_, weight_), _mm_maddubs_epi16(b_, weight_));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(values_ + i_), _mm_shuffle_epi8(bytes_, rev_));
+            }
+            return count_;
+        }
+
+        __attribute__((target("avx2")))
+        inline void hex_encode_avx2_(char *out_, const uint128_t *values_, std::size_t count_, bool upper_) {
+            // both lanes hold the value, each byte picked twice, most significant first
+            auto idx_ = _mm256_setr_epi8(15, 15, 14, 14, 13, 13, 12, 12, 11, 11, 10, 10, 9, 9, 8, 8,
+                                         7, 7, 6, 6, 5, 5, 4, 4, 3, 3, 2, 2, 1, 1, 0, 0);
+            auto odd_ = _mm256_set1_epi16(static_cast<short>(0xff00));
+            auto lut_ = _mm256_broadcastsi128_si256(
+                    _mm_loadu_si128(reinterpret_cast<const __m128i *>(upper_ ? upper_digits_() : lower_digits_())));
+            auto mask_ = _mm256_set1_epi8(0x0f);
+            for (std::size_t i_ = 0; i_ < count_; ++i_, out_ += 32) {
+                auto val_ = _mm256_shuffle_epi8(_mm256_broadcastsi128_si256(
+                        _mm_loadu_si128(reinterpret_cast<const __m128i *>(values_ + i_))), idx_);
+                auto nib_ = _mm256_blendv_epi8(_mm256_srli_epi16(val_, 4), val_, odd_);
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(out_),
+                                    _mm256_shuffle_epi8(lut_, _mm256_and_si256(nib_, mask_)));
+            }
+        }
+
+        __attribute__((target("avx2")))
+        inline std::size_t hex_decode_avx2_(const char *in_, uint128_t *values_, std::size_t count_) {
+            auto rev_ = _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+            auto weight_ = _mm256_set1_epi16(0x0110);
+            for (std::size_t i_ = 0; i_ < count_; ++i_, in_ += 32) {
+                auto chars_ = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in_));
+                auto dec_ = _mm256_sub_epi8(chars_, _mm256_set1_epi8('0'));
+                auto is_dec_ = _mm256_cmpeq_epi8(_mm256_min_epu8(dec_, _mm256_set1_epi8(9)), dec_);
+                auto alpha_ = _mm256_sub_epi8(_mm256_or_si256(chars_, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+                auto is_alpha_ = _mm256_cmpeq_epi8(_mm256_min_epu8(alpha_, _mm256_set1_epi8(5)), alpha_);
+                if (_mm256_movemask_epi8(_mm256_or_si256(is_dec_, is_alpha_)) != -1) return i_;
+                auto nib_ = _mm256_or_si256(_mm256_and_si256(dec_, is_dec_),
+                                            _mm256_and_si256(_mm256_add_epi8(alpha_, _mm256_set1_epi8(10)), is_alpha_));
+                auto words_ = _mm256_maddubs_epi16(nib_, weight_);
+                // 8 bytes per lane after pack, gather the low quadword of both lanes
+                auto bytes_ = _mm256_permute4x64_epi64(_mm256_packus_epi16(words_, words_), _MM_SHUFFLE(3, 1, 2, 0));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(values_ + i_),
+                                 _mm_shuffle_epi8(_mm256_castsi256_si128(bytes_), rev_));
+            }
+            return count_;
+        }
+
+#endif
+
+        typedef void (*hex_encode_fn_)(char *, const uint128_t *, std::size_t, bool);
+
+        typedef std::size_t (*hex_decode_fn_)(const char *, uint128_t *, std::size_t);
+
+        // best kernel of the running cpu, resolved once
+        inline hex_encode_fn_ hex_encode_() {
+#ifdef INT128_HEX_X86
+            static const hex_encode_fn_ fn_ = __builtin_cpu_supports("avx2") ? hex_encode_avx2_ :
+                                              __builtin_cpu_supports("ssse3") ? hex_encode_ssse3_ :
+                                              __builtin_cpu_supports("sse2") ? hex_encode_sse2_ : hex_encode_scalar_;
+            return fn_;
+#else
+            return hex_encode_scalar_;
+#endif
+        }
+
+        inline hex_decode_fn_ hex_decode_() {
+#ifdef INT128_HEX_X86
+            static const hex_decode_fn_ fn_ = __builtin_cpu_supports("avx2") ? hex_decode_avx2_ :
+                                              __builtin_cpu_supports("ssse3") ? hex_decode_ssse3_ :
+                                              __builtin_cpu_supports("sse2") ? hex_decode_sse2_ : hex_decode_scalar_;
+            return fn_;
+#else
+            return hex_decode_scalar_;
+#endif
+        }
+    }
+
+    // writes 32 characters at out_
+    inline void to_hex(char *out_, uint128_t value_, bool upper_ = false) {
+        detail_::hex_encode_()(out_, &value_, 1, upper_);
+    }
+
+    // reads exactly 32 hex digits of either case, returns false and leaves value_ unchanged if any is not a digit
+    inline bool from_hex(const char *in_, uint128_t &value_) { return detail_::hex_decode_()(in_, &value_, 1) == 1; }
+
+    // writes 32 * count_ characters at out_
+    inline void to_hex_batch(char *out_, const uint128_t *values_, std::size_t count_, bool upper_ = false) {
+        detail_::hex_encode_()(out_, values_, count_, upper_);
+    }
+
+    // reads 32 * count_ characters, returns the number of values decoded before the first invalid one
+    inline std::size_t from_hex_batch(const char *in_, uint128_t *values_, std::size_t count_) {
+        return detail_::hex_decode_()(in_, values_, count_);
+    }
+}
@@ -0,0 +1,268 @@
+#pragma once
+
+#include "int128.h"
+
+// modular arithmetic for moduli up to 2^128 - 1: a Montgomery context for odd moduli, a Barrett style context with a
+// precomputed reciprocal for any modulus, and is_prime on top of them. Products are 256 bits, nothing overflows.
+namespace large_int {
+    namespace detail_ {
+        // (lhs_ + rhs_) mod mod_ for both below mod_, without the carry out of 128 bits
+        inline uint128_t add_mod_(uint128_t lhs_, uint128_t rhs_, uint128_t mod_) {
+            return lhs_ >= mod_ - rhs_ ? lhs_ - (mod_ - rhs_) : lhs_ + rhs_;
+        }
+
+        inline uint128_t sub_mod_(uint128_t lhs_, uint128_t rhs_, uint128_t mod_) {
+            return lhs_ >= rhs_ ? lhs_ - rhs_ : lhs_ + (mod_ - rhs_);
+        }
+
+        // left to right square and multiply, ctx_ supplies mul and the unit
+        template<class _Ctx>
+        inline uint128_t pow_(const _Ctx &ctx_, uint128_t base_, uint128_t exp_, uint128_t one_) {
+            if (!exp_) return one_;
+            auto res_ = base_;
+            for (auto bit_ = 126 - clz_helper<uint128_t>::clz(exp_); bit_ >= 0; --bit_) {
+                res_ = ctx_.mul(res_, res_);
+                if ((exp_ >> bit_) & uint128_t(1)) res_ = ctx_.mul(res_, base_);
+            }
+            return res_;
+        }
+    }
+
+    // values in Montgomery form a * 2^128 mod m. mul is one 256-bit product and one REDC, no division anywhere.
+    // An even modulus raises SIGFPE as division by zero does.
+    class montgomery_context {
+        uint128_t mod_, inv_, one_, r2_; // m, m^-1 mod 2^128, 2^128 mod m, 2^256 mod m
+
+        // (high_, low_) * 2^-128 mod m, requires high_ < m
+        uint128_t redc_(uint128_t high_, uint128_t low_) const {
+            // low_ - q_ * m is 0 mod 2^128, so only the high halves are left
+            auto sub_ = mulhi(low_ * inv_, mod_);
+            return high_ - sub_ + (mod_ & -uint128_t(high_ < sub_));
+        }
+
+    public:
+        explicit montgomery_context(uint128_t modulus_) : mod_(modulus_), inv_(modulus_), one_(0), r2_(0) {
+            if (!(modulus_ & uint128_t(1))) {
+                mod_ = uint128_t(!!(modulus_ & uint128_t(1)) / !!(modulus_ & uint128_t(1))); // raise signal SIGFPE
+                return;
+            }
+            // Newton, each step doubles the correct low bits, an odd m is its own inverse mod 8
+            for (int i_ = 0; i_ < 6; ++i_) inv_ *= uint128_t(2) - modulus_ * inv_;
+            one_ = -modulus_ % modulus_;
+            auto sq_ = mul_wide(one_, one_);
+            detail_::div_256_128_(sq_.high, sq_.low, modulus_, r2_);
+        }
+
+        uint128_t modulus() const { return mod_; }
+
+        // 1 in Montgomery form
+        uint128_t one() const { return one_; }
+
+        // any val_, reduced on the way in
+        uint128_t to_form(uint128_t val_) const {
+            auto prod_ = mul_wide(val_, r2_);
+            return redc_(prod_.high, prod_.low);
+        }
+
+        uint128_t from_form(uint128_t val_) const { return redc_(0, val_); }
+
+        // the operations in form take and give values below the modulus
+        uint128_t mul(uint128_t lhs_, uint128_t rhs_) const {
+            auto prod_ = mul_wide(lhs_, rhs_);
+            return redc_(prod_.high, prod_.low);
+        }
+
+        uint128_t add(uint128_t lhs_, uint128_t rhs_) const { return detail_::add_mod_(lhs_, rhs_, mod_); }
+
+        uint128_t sub(uint128_t lhs_, uint128_t rhs_) const { return detail_::sub_mod_(lhs_, rhs_, mod_); }
+
+        uint128_t pow(uint128_t base_, uint128_t exp_) const { return detail_::pow_(*this, base_, exp_, one_); }
+
+        // lhs_ * rhs_ mod m for any lhs_, rhs_, with the Montgomery factors cancelled: two REDC and no conversion
+        // back
+        uint128_t mulmod(uint128_t lhs_, uint128_t rhs_) const {
+            auto prod_ = mul_wide(to_form(lhs_), rhs_);
+            return redc_(prod_.high, prod_.low);
+        }
+
+        uint128_t powmod(uint128_t base_, uint128_t exp_) const { return from_form(pow(to_form(base_), exp_)); }
+    };
+
+    // any nonzero modulus m. The modulus is shifted up to its top bit and 256-bit values are reduced with the
+    // 2-by-1 division by reciprocal of Moller and Granlund on 128-bit limbs, the reciprocal computed once.
+    class barrett_context {
+        uint128_t mod_, norm_, recip_; // m, m << shift_, floor((2^256 - 1) / norm_) - 2^128
+        unsigned shift_;
+
+        // (high_, low_) mod norm_, requires high_ < norm_
+        uint128_t rem_norm_(uint128_t high_, uint128_t low_) const {
+            auto q_ = mul_wide(recip_, high_);
+            auto q0_ = q_.low + low_;
+            auto q1_ = q_.high + high_ + uint128_t(q0_ < low_) + uint128_t(1);
+            auto r_ = low_ - q1_ * norm_;
+            if (r_ > q0_) r_ += norm_;
+            if (__builtin_expect(r_ >= norm_, 0)) r_ -= norm_;
+            return r_;
+        }
+
+    public:
+        explicit barrett_context(uint128_t modulus_) : mod_(modulus_), norm_(0), recip_(0), shift_(0) {
+            if (!modulus_) {
+                mod_ = uint128_t(!!modulus_ / !!modulus_); // raise signal SIGFPE
+                return;
+            }
+            shift_ = static_cast<unsigned>(clz_helper<uint128_t>::clz(modulus_));
+            norm_ = modulus_ << shift_;
+            uint128_t rem_;
+            recip_ = detail_::div_256_128_(~norm_, ~uint128_t(0), norm_, rem_);
+        }
+
+        uint128_t modulus() const { return mod_; }
+
+        // (high_, low_) mod m, requires high_ < m
+        uint128_t reduce(uint128_t high_, uint128_t low_) const {
+            if (!shift_) return rem_norm_(high_, low_);
+            return rem_norm_(high_ << shift_ | low_ >> 1U >> (127 - shift_), low_ << shift_) >> shift_;
+        }
+
+        uint128_t reduce(uint128_t val_) const { return reduce(0, val_); }
+
+        // lhs_ * rhs_ mod m, both below m
+        uint128_t mul(uint128_t lhs_, uint128_t rhs_) const {
+            auto prod_ = mul_wide(lhs_, rhs_);
+            return reduce(prod_.high, prod_.low);
+        }
+
+        uint128_t pow(uint128_t base_, uint128_t exp_) const {
+            return detail_::pow_(*this, base_, exp_, reduce(uint128_t(1)));
+        }
+
+        uint128_t mulmod(uint128_t lhs_, uint128_t rhs_) const { return mul(reduce(lhs_), reduce(rhs_)); }
+
+        uint128_t powmod(uint128_t base_, uint128_t exp_) const { return pow(reduce(base_), exp_); }
+    };
+
+    // lhs_ * rhs_ mod mod_ through one 256-by-128 division, for a single product. Contexts pay off from a handful of
+    // products with the same modulus.
+    inline uint128_t mulmod(uint128_t lhs_, uint128_t rhs_, uint128_t mod_) {
+        auto prod_ = mul_wide(lhs_, rhs_);
+        uint128_t rem_;
+        detail_::div_256_128_(prod_.high, prod_.low, mod_, rem_);
+        return rem_;
+    }
+
+    // Montgomery for an odd modulus, the reciprocal otherwise
+    inline uint128_t powmod(uint128_t base_, uint128_t exp_, uint128_t mod_) {
+        if (mod_ & uint128_t(1)) return montgomery_context(mod_).powmod(base_, exp_);
+        return barrett_context(mod_).powmod(base_, exp_);
+    }
+
+    // mod_inverse under its older name
+    inline uint128_t invmod(uint128_t val_, uint128_t mod_) { return mod_inverse(val_, mod_); }
+
+    namespace detail_ {
+        // strong probable prime to base_ for odd n = odd_ * 2^twos_ + 1
+        inline bool strong_probable_(const montgomery_context &ctx_, uint128_t base_, uint128_t odd_, int twos_) {
+            auto minus_one_ = ctx_.modulus() - ctx_.one();
+            auto x_ = ctx_.pow(ctx_.to_form(base_), odd_);
+            if (x_ == ctx_.one() || x_ == minus_one_) return true;
+            for (int i_ = 1; i_ < twos_; ++i_) {
+                x_ = ctx_.mul(x_, x_);
+                if (x_ == minus_one_) return true;
+                if (x_ == ctx_.one()) return false;
+            }
+            return false;
+        }
+
+        // Jacobi symbol (num_ / den_) for odd den_
+        inline int jacobi_(uint128_t num_, uint128_t den_) {
+            int res_ = 1;
+            num_ %= den_;
+            while (num_) {
+                auto twos_ = countr_zero(num_);
+                num_ >>= twos_;
+                auto den8_ = static_cast<unsigned>(den_) & 7U;
+                if ((twos_ & 1) && (den8_ == 3 || den8_ == 5)) res_ = -res_;
+                if ((static_cast<unsigned>(num_) & 3U) == 3 && (den8_ & 3U) == 3) res_ = -res_;
+                auto t_ = num_;
+                num_ = den_ % num_;
+                den_ = t_;
+            }
+            return den_ == uint128_t(1) ? res_ : 0;
+        }
+
+        inline bool is_square_(uint128_t val_) {
+            auto root_ = isqrt(val_);
+            return detail_delegate<>::mul64_(root_, root_) == val_;
+        }
+
+        // strong Lucas probable prime with P = 1 and Q = (1 - D) / 4 for the first D in 5, -7, 9, -11, ... with
+        // (D / n) = -1, Selfridge's method A. n is odd, not a square and has no factor below 50.
+        inline bool strong_lucas_(const montgomery_context &ctx_) {
+            auto n_ = ctx_.modulus();
+            auto signed_ = [&](int64_t val_) {
+                return val_ >= 0 ? uint128_t(val_) : n_ - uint128_t(-val_);
+            };
+            int64_t d_ = 5;
+            for (;; d_ = d_ > 0 ? -d_ - 2 : -d_ + 2) {
+                auto sym_ = jacobi_(signed_(d_), n_);
+                if (sym_ == -1) break;
+                if (!sym_) return false; // |D| < n shares a factor with it
+            }
+            auto dd_ = ctx_.to_form(signed_(d_)), q_ = ctx_.to_form(signed_((1 - d_) / 4));
+            // halving in form, n odd
+            auto half_ = [&](uint128_t val_) {
+                return val_ & uint128_t(1) ? (val_ >> 1) + (n_ >> 1) + uint128_t(1) : val_ >> 1;
+            };
+            auto odd_ = n_ + uint128_t(1);
+            auto twos_ = countr_zero(odd_);
+            odd_ >>= twos_;
+            // U_1 = 1, V_1 = P = 1, then the bits of odd_ below the top one
+            auto u_ = ctx_.one(), v_ = ctx_.one(), qk_ = q_;
+            for (auto bit_ = 126 - clz_helper<uint128_t>::clz(odd_); bit_ >= 0; --bit_) {
+                u_ = ctx_.mul(u_, v_);
+                v_ = ctx_.sub(ctx_.mul(v_, v_), ctx_.add(qk_, qk_));
+                qk_ = ctx_.mul(qk_, qk_);
+                if ((odd_ >> bit_) & uint128_t(1)) {
+                    auto u1_ = half_(ctx_.add(u_, v_));
+                    v_ = half_(ctx_.add(ctx_.mul(dd_, u_), v_));
+                    u_ = u1_;
+                    qk_ = ctx_.mul(qk_, q_);
+                }
+            }
+            if (!u_ || !v_) return true;
+            for (int i_ = 1; i_ < twos_; ++i_) {
+                v_ = ctx_.sub(ctx_.mul(v_, v_), ctx_.add(qk_, qk_));
+                if (!v_) return true;
+                qk_ = ctx_.mul(qk_, qk_);
+            }
+            return false;
+        }
+    }
+
+    // Miller-Rabin to the prime bases up to 41, deterministic below 3.3 * 10^24. Above that base 2 and a strong
+    // Lucas test (Baillie-PSW), which has no known counterexample.
+    inline bool is_prime(uint128_t n_) {
+        static const unsigned primes_[] = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47};
+        if (n_ < uint128_t(2)) return false;
+        // one remainder by the product of the small primes, the rest in 64 bits
+        auto rest_ = static_cast<uint64_t>(n_ % uint128_t(UINT64_C(614889782588491410)));
+        for (auto p_ : primes_) {
+            if (rest_ % p_ == 0) return n_ == uint128_t(p_);
+        }
+        if (n_ < uint128_t(53 * 53)) return true;
+        montgomery_context ctx_(n_);
+        auto odd_ = n_ - uint128_t(1);
+        auto twos_ = countr_zero(odd_);
+        odd_ >>= twos_;
+        // 3317044064679887385961981, Sorenson and Webster
+        if (n_ < (uint128_t(UINT64_C(179817)) << 64 | uint128_t(UINT64_C(5885577656943027709)))) {
+            for (int i_ = 0; i_ < 13; ++i_) {
+                if (!detail_::strong_probable_(ctx_, uint128_t(primes_[i_]), odd_, twos_)) return false;
+            }
+            return true;
+        }
+        return detail_::strong_probable_(ctx_, uint128_t(2), odd_, twos_) && !detail_::is_square_(n_) &&
+               detail_::strong_lucas_(ctx_);
+    }
+}
@@ -0,0 +1,147 @@
+#pragma once
+
+#include "int128.h"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+// sum, min/max and dot product over arrays of int128_t/uint128_t, split across threads. The partial sums are exact
+// (192 bits for sums, 320 bits for dot products), so the result and its overflow flag do not depend on the split.
+namespace large_int {
+    template<class _Tp>
+    struct reduce_result {
+        _Tp value; // the total wrapped to _Tp, what a plain += loop gives
+        bool overflow; // the exact total does not fit in _Tp
+    };
+
+    template<class _Tp>
+    struct minmax_result {
+        _Tp min;
+        _Tp max;
+    };
+
+    namespace detail_ {
+        // all ones for a negative int128_t, zero otherwise and for uint128_t
+        inline uint64_t reduce_ext_(uint128_t) { return 0; }
+
+        inline uint64_t reduce_ext_(int128_t val_) { return -static_cast<uint64_t>(val_ < int128_t(0)); }
+
+        // 192-bit two's complement
+        struct sum_acc_ {
+            uint128_t low{};
+            uint64_t high{};
+
+            void add(uint128_t val_, uint64_t ext_) {
+                low += val_;
+                high += ext_ + uint64_t(low < val_);
+            }
+
+            void merge(const sum_acc_ &other_) { add(other_.low, other_.high); }
+
+            template<class _Tp>
+            reduce_result<_Tp> result() const { return {_Tp(low), high != reduce_ext_(_Tp(low))}; }
+        };
+
+        // 320-bit two's complement, products are 256 bits
+        struct dot_acc_ {
+            uint128_t low{}, mid{};
+            uint64_t high{};
+
+            void add(uint128_t low_, uint128_t mid_, uint64_t ext_) {
+                low += low_;
+                auto carry_ = low < low_;
+                auto sum_ = mid + mid_;
+                high += ext_ + uint64_t(sum_ < mid_) + uint64_t(carry_ && sum_ == ~uint128_t(0));
+                mid = sum_ + uint128_t(carry_);
+            }
+
+            void merge(const dot_acc_ &other_) { add(other_.low, other_.mid, other_.high); }
+
+            template<class _Tp>
+            reduce_result<_Tp> result() const {
+                auto ext_ = reduce_ext_(_Tp(low));
+                return {_Tp(low), high != ext_ || mid != (uint128_t(ext_) << 64 | uint128_t(ext_))};
+            }
+        };
+
+        // below a few pages per thread the spawn costs more than it saves
+        inline unsigned reduce_threads_(std::size_t size_, unsigned threads_) {
+            if (!threads_) threads_ = std::max(1U, std::thread::hardware_concurrency());
+            return size_ < std::size_t(threads_) * 4096 ? static_cast<unsigned>(std::max<std::size_t>(1, size_ / 4096))
+                                                         : threads_;
+        }
+
+        // runs fn_(t_, first, last) on threads_ contiguous chunks of [0, size_), the calling thread takes the first
+        template<class _Fn>
+        inline void reduce_run_(std::size_t size_, unsigned threads_, const _Fn &fn_) {
+            auto chunk_ = (size_ + threads_ - 1) / threads_;
+            std::vector<std::thread> pool_;
+            for (unsigned t_ = 1; t_ < threads_; ++t_) {
+                pool_.emplace_back(fn_, t_, std::min(size_, t_ * chunk_), std::min(size_, (t_ + 1) * chunk_));
+            }
+            fn_(0U, std::size_t(0), std::min(size_, chunk_));
+            for (auto &th_ : pool_) th_.join();
+        }
+    }
+
+    // threads_ = 0 takes std::thread::hardware_concurrency(), short spans run on the calling thread
+    template<class _Hi, class _Low>
+    inline reduce_result<int128_base<_Hi, _Low> >
+    reduce_sum(const int128_base<_Hi, _Low> *first_, const int128_base<_Hi, _Low> *last_, unsigned threads_ = 0) {
+        auto size_ = static_cast<std::size_t>(last_ - first_);
+        threads_ = detail_::reduce_threads_(size_, threads_);
+        std::vector<detail_::sum_acc_> acc_(threads_);
+        detail_::reduce_run_(size_, threads_, [&](unsigned t_, std::size_t from_, std::size_t to_) {
+            detail_::sum_acc_ sum_;
+            for (auto i_ = from_; i_ < to_; ++i_) sum_.add(uint128_t(first_[i_]), detail_::reduce_ext_(first_[i_]));
+            acc_[t_] = sum_;
+        });
+        for (unsigned t_ = 1; t_ < threads_; ++t_) acc_[0].merge(acc_[t_]);
+        return acc_[0].template result<int128_base<_Hi, _Low> >();
+    }
+
+    // an empty span gives min as the largest value and max as the smallest
+    template<class _Hi, class _Low>
+    inline minmax_result<int128_base<_Hi, _Low> >
+    reduce_minmax(const int128_base<_Hi, _Low> *first_, const int128_base<_Hi, _Low> *last_, unsigned threads_ = 0) {
+        typedef int128_base<_Hi, _Low> _Tp;
+        auto size_ = static_cast<std::size_t>(last_ - first_);
+        threads_ = detail_::reduce_threads_(size_, threads_);
+        auto top_ = std::is_signed<_Hi>::value ? ~uint128_t(0) >> 1 : ~uint128_t(0);
+        std::vector<minmax_result<_Tp> > acc_(threads_, minmax_result<_Tp>{_Tp(top_), _Tp(~top_)});
+        detail_::reduce_run_(size_, threads_, [&](unsigned t_, std::size_t from_, std::size_t to_) {
+            auto res_ = acc_[t_];
+            for (auto i_ = from_; i_ < to_; ++i_) {
+                if (first_[i_] < res_.min) res_.min = first_[i_];
+                if (res_.max < first_[i_]) res_.max = first_[i_];
+            }
+            acc_[t_] = res_;
+        });
+        for (unsigned t_ = 1; t_ < threads_; ++t_) {
+            if (acc_[t_].min < acc_[0].min) acc_[0].min = acc_[t_].min;
+            if (acc_[0].max < acc_[t_].max) acc_[0].max = acc_[t_].max;
+        }
+        return acc_[0];
+    }
+
+    // sum of first1_[i] * first2_[i] over 256-bit products, first2_ spans as many values as [first1_, last1_)
+    template<class _Hi, class _Low>
+    inline reduce_result<int128_base<_Hi, _Low> >
+    dot(const int128_base<_Hi, _Low> *first1_, const int128_base<_Hi, _Low> *last1_,
+        const int128_base<_Hi, _Low> *first2_, unsigned threads_ = 0) {
+        auto size_ = static_cast<std::size_t>(last1_ - first1_);
+        threads_ = detail_::reduce_threads_(size_, threads_);
+        std::vector<detail_::dot_acc_> acc_(threads_);
+        detail_::reduce_run_(size_, threads_, [&](unsigned t_, std::size_t from_, std::size_t to_) {
+            detail_::dot_acc_ sum_;
+            for (auto i_ = from_; i_ < to_; ++i_) {
+                auto prod_ = mul_wide(first1_[i_], first2_[i_]);
+                sum_.add(prod_.low, uint128_t(prod_.high), detail_::reduce_ext_(prod_.high));
+            }
+            acc_[t_] = sum_;
+        });
+        for (unsigned t_ = 1; t_ < threads_; ++t_) acc_[0].merge(acc_[t_]);
+        return acc_[0].template result<int128_base<_Hi, _Low> >();
+    }
+}
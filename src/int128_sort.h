@@ -0,0 +1,312 @@
+#pragma once
+
+#include "int128.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// radix sort of int128_t/uint128_t on 8-bit digits, stable, with optional values carried along
+namespace large_int {
+    namespace detail_ {
+        constexpr unsigned radix_passes_ = 16;
+        constexpr unsigned radix_buckets_ = 256;
+
+        // byte pass_ of key_, least significant first
+        inline unsigned radix_digit_(uint128_t key_, unsigned pass_) {
+            return static_cast<unsigned>((pass_ < 8 ? static_cast<uint64_t>(key_) : hi64_(key_)) >> (pass_ % 8 * 8)) &
+                   0xffU;
+        }
+
+        // the sign bit flipped, so negative keys come first
+        inline unsigned radix_digit_(int128_t key_, unsigned pass_) {
+            return radix_digit_(uint128_t(key_), pass_) ^ (pass_ == radix_passes_ - 1 ? 0x80U : 0U);
+        }
+
+        struct radix_hist_ {
+            std::size_t count[radix_passes_][radix_buckets_];
+        };
+
+        template<class _Key, class _Val>
+        struct radix_items_ {
+            _Key *keys;
+            _Val *vals;
+
+            radix_items_ operator+(std::size_t off_) const { return {keys + off_, vals + off_}; }
+
+            void put(std::size_t to_, const radix_items_ &from_, std::size_t idx_) const {
+                keys[to_] = from_.keys[idx_];
+                vals[to_] = std::move(from_.vals[idx_]);
+            }
+        };
+
+        template<class _Key>
+        struct radix_items_<_Key, void> {
+            _Key *keys;
+
+            radix_items_ operator+(std::size_t off_) const { return {keys + off_}; }
+
+            void put(std::size_t to_, const radix_items_ &from_, std::size_t idx_) const {
+                keys[to_] = from_.keys[idx_];
+            }
+        };
+
+        // the scratch of a sort, size_ items and hists_ histograms, which are 32 KB each and stay off the stack
+        template<class _Key, class _Val>
+        struct radix_buffer_ {
+            std::vector<_Key> keys;
+            std::vector<_Val> vals;
+            std::vector<radix_hist_> hists;
+
+            explicit radix_buffer_(std::size_t size_, std::size_t hists_ = 0) : keys(size_), vals(size_), hists(hists_) {}
+
+            radix_items_<_Key, _Val> items() { return {keys.data(), vals.data()}; }
+        };
+
+        template<class _Key>
+        struct radix_buffer_<_Key, void> {
+            std::vector<_Key> keys;
+            std::vector<radix_hist_> hists;
+
+            explicit radix_buffer_(std::size_t size_, std::size_t hists_ = 0) : keys(size_), hists(hists_) {}
+
+            radix_items_<_Key, void> items() { return {keys.data()}; }
+        };
+
+        // histograms of the digits [0, passes_) in one read
+        template<class _Key>
+        inline void radix_count_(const _Key *keys_, std::size_t size_, unsigned passes_, radix_hist_ &hist_) {
+            for (unsigned p_ = 0; p_ < passes_; ++p_) std::fill_n(hist_.count[p_], radix_buckets_, std::size_t(0));
+            for (std::size_t i_ = 0; i_ < size_; ++i_) {
+                for (unsigned p_ = 0; p_ < passes_; ++p_) ++hist_.count[p_][radix_digit_(keys_[i_], p_)];
+            }
+        }
+
+        // a pass where every key has the same digit keeps the order, skip it
+        template<class _Key>
+        inline bool radix_skip_(const radix_hist_ &hist_, unsigned pass_, _Key first_, std::size_t size_) {
+            return hist_.count[pass_][radix_digit_(first_, pass_)] == size_;
+        }
+
+        // passes [0, passes_) bouncing between data_ and temp_, returns true if the result ended in temp_
+        template<class _Key, class _Val>
+        inline bool radix_lsd_(radix_items_<_Key, _Val> data_, radix_items_<_Key, _Val> temp_, std::size_t size_,
+                               unsigned passes_, const radix_hist_ &hist_) {
+            bool swapped_ = false;
+            std::size_t offset_[radix_buckets_];
+            for (unsigned p_ = 0; p_ < passes_; ++p_) {
+                if (radix_skip_(hist_, p_, data_.keys[0], size_)) continue;
+                std::size_t sum_ = 0;
+                for (unsigned b_ = 0; b_ < radix_buckets_; ++b_) {
+                    offset_[b_] = sum_;
+                    sum_ += hist_.count[p_][b_];
+                }
+                for (std::size_t i_ = 0; i_ < size_; ++i_) temp_.put(offset_[radix_digit_(data_.keys[i_], p_)]++, data_, i_);
+                std::swap(data_, temp_);
+                swapped_ = !swapped_;
+            }
+            return swapped_;
+        }
+
+        template<class _Key, class _Val>
+        inline void radix_copy_(radix_items_<_Key, _Val> to_, radix_items_<_Key, _Val> from_, std::size_t size_) {
+            for (std::size_t i_ = 0; i_ < size_; ++i_) to_.put(i_, from_, i_);
+        }
+
+        constexpr std::size_t radix_small_ = 48; // insertion sort below
+        constexpr std::size_t radix_large_ = 1U << 16; // counts all digits at once from here
+        constexpr unsigned radix_lsd_passes_ = 3; // LSD up to this many varying digits, MSD above
+
+        template<class _Key, class _Val>
+        inline void radix_insertion_(radix_items_<_Key, _Val> data_, radix_items_<_Key, _Val> hold_, std::size_t size_) {
+            for (std::size_t i_ = 1; i_ < size_; ++i_) {
+                if (!(data_.keys[i_] < data_.keys[i_ - 1])) continue;
+                hold_.put(0, data_, i_);
+                auto j_ = i_;
+                for (; j_ > 0 && hold_.keys[0] < data_.keys[j_ - 1]; --j_) data_.put(j_, data_, j_ - 1);
+                data_.put(j_, hold_, 0);
+            }
+        }
+
+        template<class _Key, class _Val>
+        inline void radix_sort_range_(radix_items_<_Key, _Val> data_, radix_items_<_Key, _Val> temp_,
+                                      std::size_t size_, unsigned passes_, bool to_temp_, radix_hist_ &hist_);
+
+        // scatters data_ into temp_ by the digit pass_ with its counts, then sorts each bucket by the digits below
+        template<class _Key, class _Val>
+        inline void radix_split_(radix_items_<_Key, _Val> data_, radix_items_<_Key, _Val> temp_, std::size_t size_,
+                                 unsigned pass_, bool to_temp_, const std::size_t *count_);
+
+        // MSD below the digit passes_, counting one digit at a time so constant ones cost a read and no scatter
+        template<class _Key, class _Val>
+        inline void radix_msd_(radix_items_<_Key, _Val> data_, radix_items_<_Key, _Val> temp_, std::size_t size_,
+                               unsigned passes_, bool to_temp_) {
+            std::size_t count_[radix_buckets_];
+            while (size_ > radix_small_ && passes_) {
+                --passes_;
+                std::fill_n(count_, radix_buckets_, std::size_t(0));
+                for (std::size_t i_ = 0; i_ < size_; ++i_) ++count_[radix_digit_(data_.keys[i_], passes_)];
+                if (count_[radix_digit_(data_.keys[0], passes_)] != size_) {
+                    return radix_split_(data_, temp_, size_, passes_, to_temp_, count_);
+                }
+            }
+            if (size_ > 1 && passes_) radix_insertion_(data_, temp_, size_);
+            if (to_temp_) radix_copy_(temp_, data_, size_);
+        }
+
+        template<class _Key, class _Val>
+        inline void radix_split_(radix_items_<_Key, _Val> data_, radix_items_<_Key, _Val> temp_, std::size_t size_,
+                                 unsigned pass_, bool to_temp_, const std::size_t *count_) {
+            std::size_t start_[radix_buckets_ + 1], offset_[radix_buckets_];
+            start_[0] = 0;
+            for (unsigned b_ = 0; b_ < radix_buckets_; ++b_) {
+                offset_[b_] = start_[b_];
+                start_[b_ + 1] = start_[b_] + count_[b_];
+            }
+            for (std::size_t i_ = 0; i_ < size_; ++i_) temp_.put(offset_[radix_digit_(data_.keys[i_], pass_)]++, data_, i_);
+            std::vector<radix_hist_> hist_; // counting all digits in one read pays off for large buckets
+            for (unsigned b_ = 0; b_ < radix_buckets_; ++b_) {
+                auto bucket_ = start_[b_ + 1] - start_[b_];
+                if (bucket_ < radix_large_) {
+                    radix_msd_(temp_ + start_[b_], data_ + start_[b_], bucket_, pass_, !to_temp_);
+                } else {
+                    hist_.resize(1);
+                    radix_sort_range_(temp_ + start_[b_], data_ + start_[b_], bucket_, pass_, !to_temp_, hist_[0]);
+                }
+            }
+        }
+
+        // sorts by the digits [0, passes_) the items at data_, the result ends in temp_ if to_temp_, else in data_.
+        // Few varying digits go LSD on the counts of one read, more go MSD so the buckets get sorted in cache and
+        // mostly end in insertion sort.
+        template<class _Key, class _Val>
+        inline void radix_sort_range_(radix_items_<_Key, _Val> data_, radix_items_<_Key, _Val> temp_,
+                                      std::size_t size_, unsigned passes_, bool to_temp_, radix_hist_ &hist_) {
+            if (size_ <= radix_small_) return radix_msd_(data_, temp_, size_, passes_, to_temp_);
+            radix_count_(data_.keys, size_, passes_, hist_);
+            unsigned varying_ = 0, top_ = 0;
+            for (unsigned p_ = 0; p_ < passes_; ++p_) {
+                if (!radix_skip_(hist_, p_, data_.keys[0], size_)) ++varying_, top_ = p_;
+            }
+            if (varying_ > radix_lsd_passes_) return radix_split_(data_, temp_, size_, top_, to_temp_, hist_.count[top_]);
+            if (radix_lsd_(data_, temp_, size_, passes_, hist_) != to_temp_) {
+                to_temp_ ? radix_copy_(temp_, data_, size_) : radix_copy_(data_, temp_, size_);
+            }
+        }
+
+        template<class _Key, class _Val>
+        inline void radix_sort_(radix_items_<_Key, _Val> data_, std::size_t size_) {
+            if (size_ < 2) return;
+            if (size_ <= radix_small_) {
+                radix_buffer_<_Key, _Val> hold_(1);
+                return radix_msd_(data_, hold_.items(), size_, radix_passes_, false);
+            }
+            radix_buffer_<_Key, _Val> temp_(size_, 1);
+            radix_sort_range_(data_, temp_.items(), size_, radix_passes_, false, temp_.hists[0]);
+        }
+
+        // runs fn_(t_) for t_ in [0, threads_), the calling thread takes t_ = 0
+        template<class _Fn>
+        inline void radix_run_(unsigned threads_, const _Fn &fn_) {
+            std::vector<std::thread> pool_;
+            for (unsigned t_ = 1; t_ < threads_; ++t_) pool_.emplace_back(fn_, t_);
+            fn_(0U);
+            for (auto &th_ : pool_) th_.join();
+        }
+
+        // scatter on the highest digit which is not the same for every key, then LSD sort the buckets in parallel
+        template<class _Key, class _Val>
+        inline void radix_sort_parallel_(radix_items_<_Key, _Val> data_, std::size_t size_, unsigned threads_) {
+            if (!threads_) threads_ = std::max(1U, std::thread::hardware_concurrency());
+            if (threads_ == 1 || size_ < (std::size_t(1) << 16)) return radix_sort_(data_, size_);
+
+            auto chunk_ = (size_ + threads_ - 1) / threads_;
+            radix_buffer_<_Key, _Val> temp_(size_, threads_ + 1); // the counts of each thread, then their total
+            auto &hists_ = temp_.hists;
+            radix_run_(threads_, [&](unsigned t_) {
+                auto first_ = std::min(size_, t_ * chunk_), last_ = std::min(size_, first_ + chunk_);
+                radix_count_(data_.keys + first_, last_ - first_, radix_passes_, hists_[t_]);
+            });
+
+            auto &total_ = hists_[threads_];
+            for (unsigned t_ = 0; t_ < threads_; ++t_) {
+                for (unsigned p_ = 0; p_ < radix_passes_; ++p_) {
+                    for (unsigned b_ = 0; b_ < radix_buckets_; ++b_) total_.count[p_][b_] += hists_[t_].count[p_][b_];
+                }
+            }
+            auto top_ = radix_passes_;
+            while (top_ > 0 && radix_skip_(total_, top_ - 1, data_.keys[0], size_)) --top_;
+            if (!top_) return; // all keys equal
+            --top_;
+
+            // bucket starts, then where each thread scatters into them
+            std::size_t start_[radix_buckets_ + 1];
+            std::vector<std::size_t> offsets_(threads_ * radix_buckets_);
+            start_[0] = 0;
+            for (unsigned b_ = 0; b_ < radix_buckets_; ++b_) {
+                auto at_ = start_[b_];
+                for (unsigned t_ = 0; t_ < threads_; ++t_) {
+                    offsets_[t_ * radix_buckets_ + b_] = at_;
+                    at_ += hists_[t_].count[top_][b_];
+                }
+                start_[b_ + 1] = at_;
+            }
+
+            auto buf_ = temp_.items();
+            radix_run_(threads_, [&](unsigned t_) {
+                auto first_ = std::min(size_, t_ * chunk_), last_ = std::min(size_, first_ + chunk_);
+                auto offset_ = offsets_.data() + t_ * radix_buckets_;
+                for (auto i_ = first_; i_ < last_; ++i_) buf_.put(offset_[radix_digit_(data_.keys[i_], top_)]++, data_, i_);
+            });
+
+            // the counts are spent once the offsets are, each thread sorts its buckets on its own histogram
+            std::atomic<unsigned> next_(0);
+            radix_run_(threads_, [&](unsigned t_) {
+                auto &hist_ = hists_[t_];
+                for (unsigned b_; (b_ = next_++) < radix_buckets_;) {
+                    radix_sort_range_(buf_ + start_[b_], data_ + start_[b_], start_[b_ + 1] - start_[b_], top_, true,
+                                      hist_);
+                }
+            });
+        }
+    }
+
+    template<class _Hi, class _Low>
+    inline void radix_sort(int128_base<_Hi, _Low> *first_, int128_base<_Hi, _Low> *last_) {
+        detail_::radix_sort_(detail_::radix_items_<int128_base<_Hi, _Low>, void>{first_},
+                             static_cast<std::size_t>(last_ - first_));
+    }
+
+    // values_[i] follows first_[i], equal keys keep their order
+    template<class _Hi, class _Low, class _Val>
+    inline void radix_sort(int128_base<_Hi, _Low> *first_, int128_base<_Hi, _Low> *last_, _Val *values_) {
+        detail_::radix_sort_(detail_::radix_items_<int128_base<_Hi, _Low>, _Val>{first_, values_},
+                             static_cast<std::size_t>(last_ - first_));
+    }
+
+    // index_ receives the positions of [first_, last_) in stable sorted order, the keys are left alone
+    template<class _Hi, class _Low, class _Index>
+    inline void radix_argsort(const int128_base<_Hi, _Low> *first_, const int128_base<_Hi, _Low> *last_,
+                              _Index *index_) {
+        std::vector<int128_base<_Hi, _Low> > keys_(first_, last_);
+        for (std::size_t i_ = 0; i_ < keys_.size(); ++i_) index_[i_] = static_cast<_Index>(i_);
+        radix_sort(keys_.data(), keys_.data() + keys_.size(), index_);
+    }
+
+    // threads_ = 0 takes std::thread::hardware_concurrency(), small inputs are sorted on the calling thread
+    template<class _Hi, class _Low>
+    inline void parallel_radix_sort(int128_base<_Hi, _Low> *first_, int128_base<_Hi, _Low> *last_,
+                                    unsigned threads_ = 0) {
+        detail_::radix_sort_parallel_(detail_::radix_items_<int128_base<_Hi, _Low>, void>{first_},
+                                      static_cast<std::size_t>(last_ - first_), threads_);
+    }
+
+    template<class _Hi, class _Low, class _Val>
+    inline void parallel_radix_sort(int128_base<_Hi, _Low> *first_, int128_base<_Hi, _Low> *last_, _Val *values_,
+                                    unsigned threads_ = 0) {
+        detail_::radix_sort_parallel_(detail_::radix_items_<int128_base<_Hi, _Low>, _Val>{first_, values_},
+                                      static_cast<std::size_t>(last_ - first_), threads_);
+    }
+}
@@ -0,0 +1,536 @@
+#pragma once
+
+#include "int128.h"
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#define INT128_WIDE_ADC
+#include <x86intrin.h>
+#endif
+
+namespace large_int {
+    template<unsigned _Bits, bool _Signed>
+    class basic_wide_int;
+
+    // 128 bits stay on int128_base, wider ones are limb arrays
+    template<unsigned _Bits, bool _Signed>
+    struct wide_int_select {
+        typedef basic_wide_int<_Bits, _Signed> type;
+    };
+
+    template<>
+    struct wide_int_select<128, false> {
+        typedef uint128_t type;
+    };
+
+    template<>
+    struct wide_int_select<128, true> {
+        typedef int128_t type;
+    };
+
+    template<unsigned _Bits, bool _Signed = false>
+    using wide_int = typename wide_int_select<_Bits, _Signed>::type;
+
+    typedef basic_wide_int<256, false> uint256_t;
+    typedef basic_wide_int<256, true> int256_t;
+    typedef basic_wide_int<512, false> uint512_t;
+    typedef basic_wide_int<512, true> int512_t;
+
+    namespace detail_ {
+        inline unsigned char add_carry_(unsigned char carry_, uint64_t lhs_, uint64_t rhs_, uint64_t &out_) {
+#ifdef INT128_WIDE_ADC
+            unsigned long long sum_;
+            carry_ = _addcarry_u64(carry_, lhs_, rhs_, &sum_);
+            out_ = sum_;
+            return carry_;
+#else
+            auto sum_ = lhs_ + rhs_;
+            auto next_ = sum_ < lhs_;
+            out_ = sum_ + carry_;
+            return static_cast<unsigned char>(next_ | (out_ < sum_));
+#endif
+        }
+
+        inline unsigned char sub_borrow_(unsigned char borrow_, uint64_t lhs_, uint64_t rhs_, uint64_t &out_) {
+#ifdef INT128_WIDE_ADC
+            unsigned long long diff_;
+            borrow_ = _subborrow_u64(borrow_, lhs_, rhs_, &diff_);
+            out_ = diff_;
+            return borrow_;
+#else
+            auto diff_ = lhs_ - rhs_;
+            auto next_ = lhs_ < rhs_;
+            out_ = diff_ - borrow_;
+            return static_cast<unsigned char>(next_ | (diff_ < borrow_));
+#endif
+        }
+
+        // carry chains unrolled at compile time, limbs least significant first, out_ may alias an input
+        template<std::size_t _I, std::size_t _N>
+        struct limb_chain_ {
+            static void add(uint64_t *out_, const uint64_t *lhs_, const uint64_t *rhs_, unsigned char carry_) {
+                carry_ = add_carry_(carry_, lhs_[_I], rhs_[_I], out_[_I]);
+                limb_chain_<_I + 1, _N>::add(out_, lhs_, rhs_, carry_);
+            }
+
+            static void sub(uint64_t *out_, const uint64_t *lhs_, const uint64_t *rhs_, unsigned char borrow_) {
+                borrow_ = sub_borrow_(borrow_, lhs_[_I], rhs_[_I], out_[_I]);
+                limb_chain_<_I + 1, _N>::sub(out_, lhs_, rhs_, borrow_);
+            }
+        };
+
+        template<std::size_t _N>
+        struct limb_chain_<_N, _N> {
+            static void add(uint64_t *, const uint64_t *, const uint64_t *, unsigned char) {}
+
+            static void sub(uint64_t *, const uint64_t *, const uint64_t *, unsigned char) {}
+        };
+
+        // low _N limbs of the product, out_ must not alias an input
+        template<std::size_t _N>
+        inline void mul_limbs_(uint64_t *out_, const uint64_t *lhs_, const uint64_t *rhs_) {
+            for (std::size_t i_ = 0; i_ < _N; ++i_) out_[i_] = 0;
+            for (std::size_t i_ = 0; i_ < _N; ++i_) {
+                uint64_t carry_ = 0;
+                for (std::size_t j_ = 0; i_ + j_ < _N; ++j_) {
+                    auto t_ = detail_delegate<>::mul64_(lhs_[i_], rhs_[j_]) + uint128_t(out_[i_ + j_]) +
+                              uint128_t(carry_);
+                    out_[i_ + j_] = static_cast<uint64_t>(t_);
+                    carry_ = hi64_(t_);
+                }
+            }
+        }
+
+        template<std::size_t _N>
+        inline bool less_limbs_(const uint64_t *lhs_, const uint64_t *rhs_) {
+            for (auto i_ = _N; i_-- > 0;) if (lhs_[i_] != rhs_[i_]) return lhs_[i_] < rhs_[i_];
+            return false;
+        }
+
+        template<std::size_t _N>
+        inline void negate_limbs_(uint64_t *val_) {
+            const uint64_t zero_[_N] = {};
+            limb_chain_<0, _N>::sub(val_, zero_, val_, 0);
+        }
+
+        template<std::size_t _N>
+        inline void divmod_limbs_(const uint64_t *u_, const uint64_t *v_, uint64_t *q_, uint64_t *r_) {
+            auto n_ = _N;
+            while (n_ && !v_[n_ - 1]) --n_;
+            for (std::size_t i_ = 0; i_ < _N; ++i_) q_[i_] = r_[i_] = 0;
+            if (!n_) {
+                q_[0] = !!n_ / !!n_; // raise signal SIGFPE
+                return;
+            }
+            if (less_limbs_<_N>(u_, v_)) {
+                for (std::size_t i_ = 0; i_ < _N; ++i_) r_[i_] = u_[i_];
+                return;
+            }
+            knuth_div_<_N>(u_, v_, n_, q_, r_);
+        }
+
+        // digits of the _N limbs at value_ in radix_ ending at last_, returns the first digit
+        template<std::size_t _N>
+        inline char *write_wide_digits_(char *last_, const uint64_t *value_, unsigned radix_, const char *digits_) {
+            uint64_t v_[_N];
+            auto n_ = _N;
+            while (n_ > 2 && !value_[n_ - 1]) --n_;
+            if (n_ <= 2) return write_digits_(last_, uint128_t(value_[1]) << 64 | uint128_t(value_[0]), radix_, digits_);
+            if (!(radix_ & (radix_ - 1))) { // walk the bits, a digit may straddle two limbs
+                auto bits_ = static_cast<unsigned>(__builtin_ctz(radix_));
+                auto top_ = static_cast<unsigned>(64 * n_ - clz_helper<uint64_t>::clz(value_[n_ - 1]));
+                for (unsigned pos_ = 0; pos_ < top_; pos_ += bits_) {
+                    auto i_ = pos_ / 64, off_ = pos_ % 64;
+                    auto d_ = value_[i_] >> off_;
+                    if (off_ + bits_ > 64 && i_ + 1 < n_) d_ |= value_[i_ + 1] << (64 - off_);
+                    *--last_ = digits_[d_ & (radix_ - 1)];
+                }
+                return last_;
+            }
+            // short division by the largest power of radix_ fits in 64 bits until 128 bits are left
+            uint64_t chunk_mul_ = radix_;
+            int chunk_len_ = 1;
+            while (chunk_mul_ <= ~UINT64_C(0) / radix_) chunk_mul_ *= radix_, ++chunk_len_;
+            for (std::size_t i_ = 0; i_ < n_; ++i_) v_[i_] = value_[i_];
+            while (n_ > 2) {
+                uint64_t part_ = 0;
+                for (auto i_ = n_; i_-- > 0;) v_[i_] = detail_delegate<>::div_128_64_(part_, v_[i_], chunk_mul_, part_);
+                if (!v_[n_ - 1]) --n_;
+                if (radix_ == 10) {
+                    last_ = write_dec64_(last_, part_, chunk_len_);
+                } else {
+                    for (int i_ = 0; i_ < chunk_len_; ++i_, part_ /= radix_) *--last_ = digits_[part_ % radix_];
+                }
+            }
+            return write_digits_(last_, uint128_t(v_[1]) << 64 | uint128_t(v_[0]), radix_, digits_);
+        }
+    }
+
+    // two's complement integer of _Bits bits as 64-bit limbs, least significant limb first
+    template<unsigned _Bits, bool _Signed>
+    class alignas(16) basic_wide_int final {
+        static_assert(_Bits % 64 == 0 && _Bits > 128, "bits should be a multiple of 64 and wider than 128");
+
+    public:
+        static constexpr std::size_t limb_count = _Bits / 64;
+
+    private:
+        uint64_t limbs_[limb_count]{};
+
+        void fill_(std::size_t from_, bool negative_) {
+            for (auto i_ = from_; i_ < limb_count; ++i_) limbs_[i_] = negative_ ? ~UINT64_C(0) : 0;
+        }
+
+        bool negative_() const { return _Signed && limbs_[limb_count - 1] >> 63; }
+
+        template<class _Tp>
+        void assign_(_Tp val_, std::true_type) {
+            limbs_[0] = uint64_t(val_);
+            fill_(1, val_ < 0);
+        }
+
+        template<class _Tp>
+        void assign_(_Tp val_, std::false_type) {
+            limbs_[0] = uint64_t(val_);
+            fill_(1, false);
+        }
+
+    public:
+        basic_wide_int() noexcept = default;
+
+        basic_wide_int(long long val_) { assign_(val_, std::true_type()); } // NOLINT explicit
+
+        basic_wide_int(long val_) { assign_(val_, std::true_type()); } // NOLINT explicit
+
+        basic_wide_int(int val_) { assign_(val_, std::true_type()); } // NOLINT explicit
+
+        basic_wide_int(unsigned long long val_) { assign_(val_, std::false_type()); } // NOLINT explicit
+
+        basic_wide_int(unsigned long val_) { assign_(val_, std::false_type()); } // NOLINT explicit
+
+        basic_wide_int(unsigned val_) { assign_(val_, std::false_type()); } // NOLINT explicit
+
+        template<class _Hi>
+        basic_wide_int(int128_base<_Hi, uint64_t> val_) { // NOLINT explicit
+            limbs_[0] = static_cast<uint64_t>(val_);
+            limbs_[1] = static_cast<uint64_t>(uint128_t(val_) >> 64);
+            fill_(2, val_ < int128_base<_Hi, uint64_t>(0));
+        }
+
+        // truncates or extends by the signedness of the source
+        template<unsigned _B2, bool _S2>
+        explicit basic_wide_int(const basic_wide_int<_B2, _S2> &val_) {
+            auto n_ = limb_count < val_.limb_count ? limb_count : val_.limb_count;
+            for (std::size_t i_ = 0; i_ < n_; ++i_) limbs_[i_] = val_.limb(i_);
+            fill_(n_, _S2 && val_.limb(val_.limb_count - 1) >> 63);
+        }
+
+        uint64_t limb(std::size_t idx_) const { return limbs_[idx_]; }
+
+        uint64_t &limb(std::size_t idx_) { return limbs_[idx_]; }
+
+        explicit operator bool() const {
+            for (auto val_ : limbs_) if (val_) return true;
+            return false;
+        }
+
+        template<class _Tp, class = typename std::enable_if<
+                std::is_integral<_Tp>::value && sizeof(_Tp) <= sizeof(uint64_t)>::type>
+        explicit operator _Tp() const { return _Tp(limbs_[0]); }
+
+        template<class _Hi>
+        explicit operator int128_base<_Hi, uint64_t>() const {
+            return int128_base<_Hi, uint64_t>(uint128_t(limbs_[1]) << 64 | uint128_t(limbs_[0]));
+        }
+
+        basic_wide_int operator+() const { return *this; }
+
+        basic_wide_int operator-() const {
+            auto res_ = *this;
+            detail_::negate_limbs_<limb_count>(res_.limbs_);
+            return res_;
+        }
+
+        basic_wide_int operator~() const {
+            auto res_ = *this;
+            for (auto &val_ : res_.limbs_) val_ = ~val_;
+            return res_;
+        }
+
+        bool operator!() const { return !bool(*this); }
+
+        basic_wide_int &operator++() &{ return *this += basic_wide_int(1); }
+
+        basic_wide_int &operator--() &{ return *this -= basic_wide_int(1); }
+
+        basic_wide_int operator++(int) &{ // NOLINT returns non constant
+            basic_wide_int tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        basic_wide_int operator--(int) &{ // NOLINT returns non constant
+            basic_wide_int tmp = *this;
+            --*this;
+            return tmp;
+        }
+
+        friend basic_wide_int operator+(basic_wide_int lhs_, const basic_wide_int &rhs_) {
+            detail_::limb_chain_<0, limb_count>::add(lhs_.limbs_, lhs_.limbs_, rhs_.limbs_, 0);
+            return lhs_;
+        }
+
+        friend basic_wide_int operator-(basic_wide_int lhs_, const basic_wide_int &rhs_) {
+            detail_::limb_chain_<0, limb_count>::sub(lhs_.limbs_, lhs_.limbs_, rhs_.limbs_, 0);
+            return lhs_;
+        }
+
+        // the low half of a product is the same for signed and unsigned
+        friend basic_wide_int operator*(const basic_wide_int &lhs_, const basic_wide_int &rhs_) {
+            basic_wide_int res_;
+            detail_::mul_limbs_<limb_count>(res_.limbs_, lhs_.limbs_, rhs_.limbs_);
+            return res_;
+        }
+
+        // truncated like the builtin types, the remainder takes the sign of the dividend
+        friend divmod_result<basic_wide_int> divmod(basic_wide_int lhs_, basic_wide_int rhs_) {
+            bool lneg_ = lhs_.negative_(), rneg_ = rhs_.negative_();
+            if (lneg_) lhs_ = -lhs_;
+            if (rneg_) rhs_ = -rhs_;
+            divmod_result<basic_wide_int> res_;
+            detail_::divmod_limbs_<limb_count>(lhs_.limbs_, rhs_.limbs_, res_.quot.limbs_, res_.rem.limbs_);
+            if (lneg_ != rneg_) res_.quot = -res_.quot;
+            if (lneg_) res_.rem = -res_.rem;
+            return res_;
+        }
+
+        friend basic_wide_int operator/(const basic_wide_int &lhs_, const basic_wide_int &rhs_) {
+            return divmod(lhs_, rhs_).quot;
+        }
+
+        friend basic_wide_int operator%(const basic_wide_int &lhs_, const basic_wide_int &rhs_) {
+            return divmod(lhs_, rhs_).rem;
+        }
+
+        friend basic_wide_int operator&(basic_wide_int lhs_, const basic_wide_int &rhs_) {
+            for (std::size_t i_ = 0; i_ < limb_count; ++i_) lhs_.limbs_[i_] &= rhs_.limbs_[i_];
+            return lhs_;
+        }
+
+        friend basic_wide_int operator|(basic_wide_int lhs_, const basic_wide_int &rhs_) {
+            for (std::size_t i_ = 0; i_ < limb_count; ++i_) lhs_.limbs_[i_] |= rhs_.limbs_[i_];
+            return lhs_;
+        }
+
+        friend basic_wide_int operator^(basic_wide_int lhs_, const basic_wide_int &rhs_) {
+            for (std::size_t i_ = 0; i_ < limb_count; ++i_) lhs_.limbs_[i_] ^= rhs_.limbs_[i_];
+            return lhs_;
+        }
+
+        // shift counts of _Bits or more give zero, or all sign bits for signed right shift
+        friend basic_wide_int operator<<(const basic_wide_int &lhs_, int rhs_) {
+            basic_wide_int res_;
+            auto limb_ = static_cast<unsigned>(rhs_) / 64, bit_ = static_cast<unsigned>(rhs_) % 64;
+            for (auto i_ = limb_; i_ < limb_count; ++i_) {
+                res_.limbs_[i_] = lhs_.limbs_[i_ - limb_] << bit_;
+                if (bit_ && i_ > limb_) res_.limbs_[i_] |= lhs_.limbs_[i_ - limb_ - 1] >> (64 - bit_);
+            }
+            return res_;
+        }
+
+        friend basic_wide_int operator>>(const basic_wide_int &lhs_, int rhs_) {
+            basic_wide_int res_;
+            auto fill_ = lhs_.negative_() ? ~UINT64_C(0) : 0;
+            auto limb_ = static_cast<unsigned>(rhs_) / 64, bit_ = static_cast<unsigned>(rhs_) % 64;
+            for (std::size_t i_ = 0; i_ < limb_count; ++i_) {
+                auto src_ = i_ + limb_;
+                auto cur_ = src_ < limb_count ? lhs_.limbs_[src_] : fill_;
+                auto next_ = src_ + 1 < limb_count ? lhs_.limbs_[src_ + 1] : fill_;
+                res_.limbs_[i_] = bit_ ? cur_ >> bit_ | next_ << (64 - bit_) : cur_;
+            }
+            return res_;
+        }
+
+        friend bool operator==(const basic_wide_int &lhs_, const basic_wide_int &rhs_) {
+            for (std::size_t i_ = 0; i_ < limb_count; ++i_) if (lhs_.limbs_[i_] != rhs_.limbs_[i_]) return false;
+            return true;
+        }
+
+        friend bool operator<(const basic_wide_int &lhs_, const basic_wide_int &rhs_) {
+            if (lhs_.negative_() != rhs_.negative_()) return lhs_.negative_();
+            return detail_::less_limbs_<limb_count>(lhs_.limbs_, rhs_.limbs_);
+        }
+
+        friend bool operator>(const basic_wide_int &lhs_, const basic_wide_int &rhs_) { return rhs_ < lhs_; }
+
+        friend bool operator>=(const basic_wide_int &lhs_, const basic_wide_int &rhs_) { return !(lhs_ < rhs_); }
+
+        friend bool operator<=(const basic_wide_int &lhs_, const basic_wide_int &rhs_) { return !(rhs_ < lhs_); }
+
+        friend bool operator!=(const basic_wide_int &lhs_, const basic_wide_int &rhs_) { return !(lhs_ == rhs_); }
+
+        basic_wide_int &operator+=(const basic_wide_int &rhs_) &{ return *this = *this + rhs_; }
+
+        basic_wide_int &operator-=(const basic_wide_int &rhs_) &{ return *this = *this - rhs_; }
+
+        basic_wide_int &operator*=(const basic_wide_int &rhs_) &{ return *this = *this * rhs_; }
+
+        basic_wide_int &operator/=(const basic_wide_int &rhs_) &{ return *this = *this / rhs_; }
+
+        basic_wide_int &operator%=(const basic_wide_int &rhs_) &{ return *this = *this % rhs_; }
+
+        basic_wide_int &operator<<=(int rhs_) &{ return *this = *this << rhs_; }
+
+        basic_wide_int &operator>>=(int rhs_) &{ return *this = *this >> rhs_; }
+
+        basic_wide_int &operator&=(const basic_wide_int &rhs_) &{ return *this = *this & rhs_; }
+
+        basic_wide_int &operator|=(const basic_wide_int &rhs_) &{ return *this = *this | rhs_; }
+
+        basic_wide_int &operator^=(const basic_wide_int &rhs_) &{ return *this = *this ^ rhs_; }
+    };
+
+    // base_ in [2, 36], lower case digits, negative values as '-' and the magnitude like to_chars
+    template<unsigned _Bits, bool _Signed>
+    inline std::string to_string(const basic_wide_int<_Bits, _Signed> &value_, int base_ = 10) {
+        char buf_[_Bits + 1];
+        bool neg_ = value_ < basic_wide_int<_Bits, _Signed>(0);
+        auto abs_ = neg_ ? -value_ : value_;
+        auto end_ = buf_ + sizeof(buf_);
+        auto first_ = detail_::write_wide_digits_<_Bits / 64>(end_, &abs_.limb(0), static_cast<unsigned>(base_),
+                                                               detail_::lower_digits_());
+        if (neg_) *--first_ = '-';
+        return std::string(first_, end_);
+    }
+
+    template<class _CharT, class _Traits, unsigned _Bits, bool _Signed>
+    inline std::basic_ostream<_CharT, _Traits> &
+    operator<<(std::basic_ostream<_CharT, _Traits> &out_, const basic_wide_int<_Bits, _Signed> &value_) {
+        constexpr std::size_t buf_size_ = _Bits / 3 + 3;
+
+        typename std::basic_ostream<_CharT, _Traits>::sentry sentry_(out_);
+        if (!sentry_) return out_;
+        auto flags_ = out_.flags(), base_flag_ = flags_ & std::ios::basefield;
+        auto show_base_ = bool(flags_ & std::ios::showbase); // work not dec
+        auto show_pos_ = bool(flags_ & std::ios::showpos); // work only dec
+        auto upper_case_ = bool(flags_ & std::ios::uppercase); // work only hex
+
+        char buf_[buf_size_];
+        auto end_ = buf_ + buf_size_;
+        char *first_;
+        char const *prefix_ = nullptr;
+        auto abs_ = value_;
+
+        switch (base_flag_) {
+            case std::ios::hex: {
+                if (show_base_ && value_) prefix_ = upper_case_ ? "0X" : "0x";
+                first_ = detail_::write_wide_digits_<_Bits / 64>(end_, &abs_.limb(0), 16, upper_case_
+                                                                                          ? detail_::upper_digits_()
+                                                                                          : detail_::lower_digits_());
+                break;
+            }
+            case std::ios::oct: {
+                first_ = detail_::write_wide_digits_<_Bits / 64>(end_, &abs_.limb(0), 8, detail_::lower_digits_());
+                if (show_base_ && value_) *--first_ = '0';
+                break;
+            }
+            default: {
+                if (_Signed && value_ < basic_wide_int<_Bits, _Signed>(0)) {
+                    prefix_ = "-";
+                    abs_ = -value_;
+                } else if (_Signed && show_pos_) {
+                    prefix_ = "+";
+                }
+                first_ = detail_::write_wide_digits_<_Bits / 64>(end_, &abs_.limb(0), 10, detail_::lower_digits_());
+                break;
+            }
+        }
+
+        memmove(buf_, first_, static_cast<std::size_t>(end_ - first_));
+        return detail_::put_digits_<buf_size_>(out_, buf_, static_cast<int>(end_ - first_), prefix_);
+    }
+
+    inline namespace literals {
+        template<char ..._Args>
+        inline uint256_t operator "" _u256() { return impl_::int128_literal<uint256_t, _Args...>(); }
+
+        template<char ..._Args>
+        inline int256_t operator "" _l256() { return impl_::int128_literal<int256_t, _Args...>(); }
+
+        template<char ..._Args>
+        inline uint256_t operator "" _U256() { return impl_::int128_literal<uint256_t, _Args...>(); }
+
+        template<char ..._Args>
+        inline int256_t operator "" _L256() { return impl_::int128_literal<int256_t, _Args...>(); }
+
+        template<char ..._Args>
+        inline uint512_t operator "" _u512() { return impl_::int128_literal<uint512_t, _Args...>(); }
+
+        template<char ..._Args>
+        inline int512_t operator "" _l512() { return impl_::int128_literal<int512_t, _Args...>(); }
+
+        template<char ..._Args>
+        inline uint512_t operator "" _U512() { return impl_::int128_literal<uint512_t, _Args...>(); }
+
+        template<char ..._Args>
+        inline int512_t operator "" _L512() { return impl_::int128_literal<int512_t, _Args...>(); }
+    }
+}
+
+#ifdef INT128_SPECIALIZATION
+namespace std {
+    template<unsigned _Bits, bool _Signed>
+    struct numeric_limits<large_int::basic_wide_int<_Bits, _Signed> > {
+    private:
+        typedef large_int::basic_wide_int<_Bits, _Signed> _Tp;
+    public:
+        static constexpr const bool is_specialized = true;
+        static constexpr const bool is_signed = _Signed;
+        static constexpr const bool is_integer = true;
+        static constexpr const bool is_exact = true;
+        static constexpr const bool has_infinity = false;
+        static constexpr const bool has_quiet_NaN = false;
+        static constexpr const bool has_signaling_NaN = false;
+        static constexpr const std::float_denorm_style has_denorm = std::denorm_absent;
+        static constexpr const bool has_denorm_loss = false;
+        static constexpr const std::float_round_style round_style = std::round_toward_zero;
+        static constexpr const bool is_iec559 = false;
+        static constexpr const bool is_bounded = true;
+        static constexpr const bool is_modulo = !_Signed;
+        static constexpr const int digits = static_cast<int>(_Bits - is_signed);
+        static constexpr const int digits10 = digits * 3 / 10;
+        static constexpr const int max_digits10 = 0;
+        static constexpr const int radix = 2;
+        static constexpr const int min_exponent = 0;
+        static constexpr const int min_exponent10 = 0;
+        static constexpr const int max_exponent = 0;
+        static constexpr const int max_exponent10 = 0;
+        static constexpr const bool traps = true;
+        static constexpr const bool tinyness_before = false;
+
+        static _Tp min() { return is_signed ? _Tp(1) << digits : _Tp(0); }
+
+        static _Tp lowest() { return min(); }
+
+        static _Tp max() { return ~min(); }
+
+        static _Tp epsilon() { return _Tp(0); }
+
+        static _Tp round_error() { return _Tp(0); }
+
+        static _Tp infinity() { return _Tp(0); }
+
+        static _Tp quiet_NaN() { return _Tp(0); }
+
+        static _Tp signaling_NaN() { return _Tp(0); }
+
+        static _Tp denorm_min() { return _Tp(0); }
+    };
+}
+#endif /* INT128_SPECIALIZATION */
+
+#ifndef INT128_NO_EXPORT
+using large_int::uint256_t;
+using large_int::int256_t;
+using large_int::uint512_t;
+using large_int::int512_t;
+#endif /* INT128_NO_EXPORT */
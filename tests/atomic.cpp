@@ -0,0 +1,101 @@
+#include "int128_atomic.h"
+
+#include "check.h"
+
+#include <thread>
+#include <vector>
+
+using large_int::int128_t;
+using large_int::uint128_t;
+
+namespace {
+    const int thread_count = 4;
+    const int iterations = 20000;
+
+    // a step that carries out of the low half every few adds, so a torn update shows in either half
+    const uint128_t step = uint128_t(1) << 64 | uint128_t(UINT64_C(0x4000000000000001));
+
+    template<class _Fn>
+    void run_threads(_Fn fn_) {
+        std::vector<std::thread> threads_;
+        for (int t_ = 0; t_ < thread_count; ++t_) threads_.emplace_back(fn_, t_);
+        for (auto &thread_ : threads_) thread_.join();
+    }
+}
+
+// every read-modify-write hands back the value before it, compare_exchange the current one when it fails
+TEST_CASE(atomic_previous) {
+    const uint128_t a_ = uint128_t(UINT64_C(0x0123456789abcdef)) << 64 | uint128_t(~UINT64_C(0));
+    const uint128_t b_ = uint128_t(UINT64_C(0xfedcba9876543210)) << 64 | uint128_t(1);
+    large_int::atomic_uint128 val_{a_};
+    CHECK(val_.load() == a_ && uint128_t(val_) == a_);
+    CHECK(val_.exchange(b_) == a_ && val_.load() == b_);
+    val_.store(a_);
+    CHECK(val_.fetch_add(uint128_t(1)) == a_ && val_.load() == a_ + uint128_t(1));
+    CHECK(val_.fetch_sub(uint128_t(2)) == a_ + uint128_t(1) && val_.load() == a_ - uint128_t(1));
+    val_ = a_;
+    CHECK(val_.fetch_and(b_) == a_ && val_.load() == (a_ & b_));
+    CHECK(val_.fetch_or(a_) == (a_ & b_) && val_.load() == a_);
+    CHECK(val_.fetch_xor(b_) == a_ && val_.load() == (a_ ^ b_));
+    val_ = a_;
+    CHECK(++val_ == a_ + uint128_t(1) && val_++ == a_ + uint128_t(1) && val_.load() == a_ + uint128_t(2));
+    CHECK(--val_ == a_ + uint128_t(1) && val_-- == a_ + uint128_t(1) && val_.load() == a_);
+    CHECK((val_ += b_) == a_ + b_ && (val_ -= b_) == a_);
+
+    auto expected_ = b_;
+    CHECK(!val_.compare_exchange_strong(expected_, uint128_t(0)) && expected_ == a_ && val_.load() == a_);
+    CHECK(val_.compare_exchange_strong(expected_, b_) && expected_ == a_ && val_.load() == b_);
+    CHECK(!val_.compare_exchange_weak(expected_, a_, std::memory_order_acq_rel, std::memory_order_acquire));
+    CHECK(expected_ == b_ && val_.compare_exchange_weak(expected_, a_) && val_.load() == a_);
+
+    const int128_t min128 = int128_t(uint128_t(1) << 127);
+    large_int::atomic_int128 sval_{int128_t(-1)};
+    CHECK(sval_.fetch_add(int128_t(1)) == int128_t(-1) && sval_.load() == int128_t(0));
+    CHECK(sval_.fetch_sub(int128_t(1)) == int128_t(0) && sval_.exchange(min128) == int128_t(-1));
+    CHECK(sval_.fetch_sub(int128_t(1)) == min128 && sval_.load() == int128_t(~uint128_t(0) >> 1));
+#ifdef INT128_ATOMIC_CX16
+    CHECK(val_.is_lock_free() && large_int::atomic_uint128::is_always_lock_free);
+#else
+    CHECK(!val_.is_lock_free() && !large_int::atomic_uint128::is_always_lock_free);
+#endif
+#ifdef INT128_SPECIALIZATION
+    std::atomic<uint128_t> std_{a_};
+    CHECK(std_.fetch_add(b_) == a_ && std_.load() == a_ + b_);
+#endif
+}
+
+// no update lost or torn under contention: fetch_add from every thread, and a compare_exchange_strong loop that
+// counts its own successes
+TEST_CASE(atomic_threads) {
+    const uint128_t start_ = (uint128_t(1) << 64) - uint128_t(iterations);
+    large_int::atomic_uint128 sum_{start_};
+    run_threads([&sum_](int) {
+        for (int i_ = 0; i_ < iterations; ++i_) sum_.fetch_add(step);
+    });
+    CHECK(sum_.load() == start_ + uint128_t(thread_count * iterations) * step);
+
+    large_int::atomic_uint128 cas_{start_};
+    std::vector<int> successes_(thread_count);
+    run_threads([&cas_, &successes_](int t_) {
+        auto cur_ = cas_.load();
+        for (int i_ = 0; i_ < iterations; ++i_) {
+            if (cas_.compare_exchange_strong(cur_, cur_ + step)) {
+                ++successes_[t_];
+                cur_ += step;
+            }
+        }
+    });
+    uint128_t done_(0);
+    for (auto n_ : successes_) done_ += uint128_t(n_);
+    CHECK(cas_.load() == start_ + done_ * step && done_ >= uint128_t(iterations));
+
+    // neighbours share a lock stripe or a cache line, each one still counts alone
+    large_int::atomic_int128 counters_[8];
+    for (auto &counter_ : counters_) counter_.store(int128_t(0));
+    run_threads([&counters_](int t_) {
+        for (int i_ = 0; i_ < iterations; ++i_) counters_[(i_ + t_) % 8].fetch_sub(int128_t(step));
+    });
+    int128_t total_(0);
+    for (auto &counter_ : counters_) total_ += counter_.load();
+    CHECK(total_ == -int128_t(uint128_t(thread_count * iterations) * step));
+}
@@ -0,0 +1,167 @@
+#include "int128_binary.h"
+
+#include "check.h"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+using large_int::int128_t;
+using large_int::uint128_t;
+
+namespace {
+    // LEB128 a byte at a time, what the encoder has to agree with
+    std::string reference_varint(uint128_t value_) {
+        std::string res_;
+        for (; value_ >> 7; value_ >>= 7) res_ += static_cast<char>(static_cast<unsigned char>(value_) | 0x80U);
+        res_ += static_cast<char>(static_cast<unsigned char>(value_));
+        return res_;
+    }
+
+    // both sides of every 7-bit boundary, then random of every width
+    std::vector<uint128_t> varint_values(std::mt19937_64 &rng_) {
+        std::vector<uint128_t> values_ = {uint128_t(0), uint128_t(1), ~uint128_t(0), ~uint128_t(0) >> 1};
+        for (int bits_ = 7; bits_ < 128; bits_ += 7) {
+            values_.push_back((uint128_t(1) << bits_) - uint128_t(1));
+            values_.push_back(uint128_t(1) << bits_);
+        }
+        for (int i_ = 0; i_ < 500; ++i_) values_.push_back(int128_test::random128(rng_));
+        return values_;
+    }
+
+    // the encoding at the start of a buffer of size_ bytes, the rest filled with fill_
+    std::vector<char> buffer(const std::string &bytes_, std::size_t size_, char fill_) {
+        std::vector<char> buf_(size_ < bytes_.size() ? bytes_.size() : size_, fill_);
+        memcpy(buf_.data(), bytes_.data(), bytes_.size());
+        return buf_;
+    }
+
+    const uint128_t sentinel = uint128_t(0x5a5a5a5a5a5a5a5aULL) << 64 | uint128_t(0x5a5a5a5a5a5a5a5aULL);
+}
+
+// encode against the reference, decode back from exactly the bytes, which takes the byte loop, and with 16 or more
+// bytes to read, which takes the word loads, whatever follows the varint
+TEST_CASE(varint_round_trip) {
+    std::mt19937_64 rng_(22);
+    for (auto value_ : varint_values(rng_)) {
+        auto want_ = reference_varint(value_);
+        CHECK(large_int::varint_size(value_) == static_cast<int>(want_.size()));
+        char out_[19];
+        auto enc_ = large_int::varint_encode(out_, out_ + sizeof(out_), value_);
+        CHECK(enc_.ec == std::errc() && std::string(out_, enc_.ptr) == want_);
+
+        for (std::size_t size_ : {want_.size(), std::size_t(16), std::size_t(17), want_.size() + 16}) {
+            for (char fill_ : {'\0', '\xff', '\x80'}) {
+                auto buf_ = buffer(want_, size_, fill_);
+                auto got_ = sentinel;
+                auto dec_ = large_int::varint_decode(buf_.data(), buf_.data() + buf_.size(), got_);
+                CHECK(dec_.ec == std::errc() && got_ == value_ && dec_.ptr == buf_.data() + want_.size());
+            }
+        }
+
+        auto svalue_ = int128_t(value_);
+        CHECK(large_int::varint_size(svalue_) == large_int::varint_size(large_int::zigzag_encode(svalue_)));
+        enc_ = large_int::varint_encode(out_, out_ + sizeof(out_), svalue_);
+        CHECK(enc_.ec == std::errc() && std::string(out_, enc_.ptr) == reference_varint(large_int::zigzag_encode(svalue_)));
+        for (std::size_t size_ : {std::size_t(enc_.ptr - out_), std::size_t(32)}) {
+            auto buf_ = buffer(std::string(out_, enc_.ptr), size_, '\xff');
+            int128_t got_(0);
+            auto dec_ = large_int::varint_decode(buf_.data(), buf_.data() + buf_.size(), got_);
+            CHECK(dec_.ec == std::errc() && got_ == svalue_ && dec_.ptr == buf_.data() + (enc_.ptr - out_));
+        }
+    }
+    CHECK(large_int::zigzag_encode(int128_t(-1)) == uint128_t(1));
+    CHECK(large_int::zigzag_encode(int128_t(1)) == uint128_t(2));
+    CHECK(large_int::zigzag_encode(int128_t(uint128_t(1) << 127)) == ~uint128_t(0));
+    CHECK(large_int::varint_size(uint128_t(0)) == 1 && large_int::varint_size(~uint128_t(0)) == 19);
+}
+
+// every cut of every encoding is invalid_argument, first_ and the value left alone
+TEST_CASE(varint_truncated) {
+    std::mt19937_64 rng_(23);
+    for (auto value_ : varint_values(rng_)) {
+        auto bytes_ = reference_varint(value_);
+        for (std::size_t cut_ = 0; cut_ < bytes_.size(); ++cut_) {
+            std::vector<char> buf_(bytes_.begin(), bytes_.begin() + static_cast<std::ptrdiff_t>(cut_));
+            auto got_ = sentinel;
+            auto dec_ = large_int::varint_decode(buf_.data(), buf_.data() + cut_, got_);
+            CHECK(dec_.ec == std::errc::invalid_argument && dec_.ptr == buf_.data() && got_ == sentinel);
+            int128_t sgot_(7);
+            dec_ = large_int::varint_decode(buf_.data(), buf_.data() + cut_, sgot_);
+            CHECK(dec_.ec == std::errc::invalid_argument && sgot_ == int128_t(7));
+        }
+    }
+    // 16 continuation bytes leave the word loads without a last byte, the byte loop finds the end of the buffer
+    std::vector<char> cont_(20, '\x80');
+    auto got_ = sentinel;
+    auto dec_ = large_int::varint_decode(cont_.data(), cont_.data() + 18, got_);
+    CHECK(dec_.ec == std::errc::invalid_argument && dec_.ptr == cont_.data() && got_ == sentinel);
+}
+
+// the 19th byte holds bits 126 and 127, anything more does not fit in 128 bits
+TEST_CASE(varint_out_of_range) {
+    for (std::size_t slack_ : {0, 16}) {
+        for (unsigned last_ : {0x03U, 0x04U, 0x7fU, 0x83U, 0xffU}) {
+            std::vector<char> buf_(19 + slack_, '\0');
+            std::fill_n(buf_.begin(), 18, '\xff');
+            buf_[18] = static_cast<char>(last_);
+            auto got_ = sentinel;
+            auto dec_ = large_int::varint_decode(buf_.data(), buf_.data() + buf_.size(), got_);
+            if (last_ == 0x03U) {
+                CHECK(dec_.ec == std::errc() && got_ == ~uint128_t(0) && dec_.ptr == buf_.data() + 19);
+            } else {
+                CHECK(dec_.ec == std::errc::result_out_of_range && dec_.ptr == buf_.data() && got_ == sentinel);
+            }
+        }
+    }
+    // not canonical, still in range: 1 spread over 19 bytes
+    std::vector<char> padded_(19, '\x80');
+    padded_[0] = '\x81';
+    padded_[18] = '\0';
+    auto got_ = sentinel;
+    auto dec_ = large_int::varint_decode(padded_.data(), padded_.data() + padded_.size(), got_);
+    CHECK(dec_.ec == std::errc() && got_ == uint128_t(1));
+}
+
+// a buffer one byte short is value_too_large with last_, nothing written
+TEST_CASE(varint_short_buffer) {
+    std::mt19937_64 rng_(24);
+    for (auto value_ : varint_values(rng_)) {
+        auto len_ = large_int::varint_size(value_);
+        std::vector<char> buf_(19, '#');
+        auto enc_ = large_int::varint_encode(buf_.data(), buf_.data() + len_ - 1, value_);
+        CHECK(enc_.ec == std::errc::value_too_large && enc_.ptr == buf_.data() + len_ - 1);
+        CHECK(std::string(buf_.begin(), buf_.end()) == std::string(19, '#'));
+        enc_ = large_int::varint_encode(buf_.data(), buf_.data() + len_, value_);
+        CHECK(enc_.ec == std::errc() && enc_.ptr == buf_.data() + len_);
+        auto sbuf_ = buf_;
+        auto senc_ = large_int::varint_encode(sbuf_.data(), sbuf_.data(), int128_t(value_));
+        CHECK(senc_.ec == std::errc::value_too_large && senc_.ptr == sbuf_.data());
+    }
+}
+
+// the packing of the word loads against the bytes one at a time
+TEST_CASE(varint_pack7) {
+    std::mt19937_64 rng_(25);
+    for (int i_ = 0; i_ < 10000; ++i_) {
+        auto word_ = rng_();
+        uint64_t want_ = 0;
+        for (int b_ = 0; b_ < 8; ++b_) want_ |= (word_ >> (8 * b_) & 0x7fU) << (7 * b_);
+        CHECK(large_int::detail_::varint_pack7_(word_) == want_);
+    }
+}
+
+// the byte order of the fixed width forms whatever the host is
+TEST_CASE(binary_fixed) {
+    auto value_ = uint128_t(0x0001020304050607ULL) << 64 | uint128_t(0x08090a0b0c0d0e0fULL);
+    unsigned char le_[17], be_[17];
+    large_int::store_le(le_ + 1, value_);
+    large_int::store_be(be_ + 1, value_);
+    for (int i_ = 0; i_ < 16; ++i_) {
+        CHECK(le_[1 + i_] == 15 - i_);
+        CHECK(be_[1 + i_] == i_);
+    }
+    CHECK(large_int::load_le(le_ + 1) == value_);
+    CHECK(large_int::load_be(be_ + 1) == value_);
+    CHECK(large_int::load_le<int128_t>(le_ + 1) == int128_t(value_));
+}
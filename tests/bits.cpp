@@ -0,0 +1,158 @@
+#include "int128.h"
+
+#include "check.h"
+
+#include <vector>
+
+using large_int::int128_t;
+using large_int::uint128_t;
+
+namespace {
+    bool bit(uint128_t val_, int pos_) { return !!(val_ >> pos_ & uint128_t(1)); }
+
+    // a bit at a time, what the word operations have to agree with
+    int reference_popcount(uint128_t val_) {
+        int res_ = 0;
+        for (int i_ = 0; i_ < 128; ++i_) res_ += bit(val_, i_);
+        return res_;
+    }
+
+    int reference_countl(uint128_t val_, bool one_) {
+        int res_ = 0;
+        while (res_ < 128 && bit(val_, 127 - res_) == one_) ++res_;
+        return res_;
+    }
+
+    int reference_countr(uint128_t val_, bool one_) {
+        int res_ = 0;
+        while (res_ < 128 && bit(val_, res_) == one_) ++res_;
+        return res_;
+    }
+
+    uint128_t reference_rotl(uint128_t val_, int shift_) {
+        uint128_t res_(0);
+        for (int i_ = 0; i_ < 128; ++i_) {
+            if (bit(val_, i_)) res_ |= uint128_t(1) << (((i_ + shift_) % 128 + 128) % 128);
+        }
+        return res_;
+    }
+
+    uint128_t reference_bit_ceil(uint128_t val_) {
+        for (int i_ = 0; i_ < 128; ++i_) {
+            if (uint128_t(1) << i_ >= val_) return uint128_t(1) << i_;
+        }
+        return uint128_t(0);
+    }
+
+    uint128_t reference_byteswap(uint128_t val_) {
+        uint128_t res_(0);
+        for (int i_ = 0; i_ < 16; ++i_) res_ |= (val_ >> (8 * i_) & uint128_t(0xff)) << (8 * (15 - i_));
+        return res_;
+    }
+
+    uint128_t reference_pdep(uint128_t src_, uint128_t mask_) {
+        uint128_t res_(0);
+        for (int i_ = 0, k_ = 0; i_ < 128; ++i_) {
+            if (bit(mask_, i_) && bit(src_, k_++)) res_ |= uint128_t(1) << i_;
+        }
+        return res_;
+    }
+
+    uint128_t reference_pext(uint128_t src_, uint128_t mask_) {
+        uint128_t res_(0);
+        for (int i_ = 0, k_ = 0; i_ < 128; ++i_) {
+            if (bit(mask_, i_) && bit(src_, i_)) res_ |= uint128_t(1) << k_;
+            k_ += bit(mask_, i_);
+        }
+        return res_;
+    }
+
+    // 0, all ones, every single bit and its complement, both halves, then random of every width
+    std::vector<uint128_t> bit_values(std::mt19937_64 &rng_) {
+        std::vector<uint128_t> res_ = {uint128_t(0), ~uint128_t(0), uint128_t(~UINT64_C(0)), ~uint128_t(~UINT64_C(0))};
+        for (int i_ = 0; i_ < 128; ++i_) {
+            res_.push_back(uint128_t(1) << i_);
+            res_.push_back(~(uint128_t(1) << i_));
+            res_.push_back((uint128_t(1) << i_) + uint128_t(1));
+        }
+        for (int i_ = 0; i_ < 2000; ++i_) res_.push_back(int128_test::random128(rng_));
+        return res_;
+    }
+
+#if __cplusplus >= 201402L
+    // forced through the constant evaluated path, the loop even where -mbmi2 takes pdep and pext at run time
+    constexpr uint128_t pdep_mask = uint128_t(UINT64_C(0xf0f0f0f00ff00ff0)) << 64 | uint128_t(UINT64_C(0x8421842184218421));
+    constexpr uint128_t pdep_src = uint128_t(UINT64_C(0x0123456789abcdef)) << 64 | uint128_t(UINT64_C(0xfedcba9876543210));
+    constexpr uint128_t const_pdep = large_int::pdep(pdep_src, pdep_mask);
+    constexpr uint128_t const_pext = large_int::pext(pdep_src, pdep_mask);
+#endif
+}
+
+// the counts, widths and powers against a bit at a time, 0 and all ones included
+TEST_CASE(bits_count) {
+    std::mt19937_64 rng_(21);
+    for (auto val_ : bit_values(rng_)) {
+        CHECK(large_int::popcount(val_) == reference_popcount(val_));
+        CHECK(large_int::countl_zero(val_) == reference_countl(val_, false));
+        CHECK(large_int::countl_one(val_) == reference_countl(val_, true));
+        CHECK(large_int::countr_zero(val_) == reference_countr(val_, false));
+        CHECK(large_int::countr_one(val_) == reference_countr(val_, true));
+        CHECK(large_int::has_single_bit(val_) == (reference_popcount(val_) == 1));
+        CHECK(large_int::bit_width(val_) == 128 - reference_countl(val_, false));
+        CHECK(large_int::bit_floor(val_) == (val_ ? uint128_t(1) << (127 - reference_countl(val_, false)) : val_));
+        CHECK(large_int::bit_ceil(val_) == reference_bit_ceil(val_));
+        CHECK(large_int::byteswap(val_) == reference_byteswap(val_));
+        CHECK(large_int::byteswap(int128_t(val_)) == int128_t(reference_byteswap(val_)));
+        CHECK(large_int::ilog2(val_) == 127 - reference_countl(val_, false));
+    }
+    CHECK(large_int::bit_ceil(uint128_t(0)) == uint128_t(1) && large_int::bit_ceil(uint128_t(1)) == uint128_t(1));
+    CHECK(large_int::bit_ceil(uint128_t(1) << 127) == uint128_t(1) << 127);
+    CHECK(large_int::bit_ceil((uint128_t(1) << 127) + uint128_t(1)) == uint128_t(0));
+    CHECK(large_int::bit_ceil(~uint128_t(0)) == uint128_t(0));
+    CHECK(large_int::countl_zero(uint128_t(0)) == 128 && large_int::countr_zero(uint128_t(0)) == 128);
+}
+
+// every shift count in both directions, the ones past 128 and the negative ones too
+TEST_CASE(bits_rotate) {
+    std::mt19937_64 rng_(22);
+    auto values_ = bit_values(rng_);
+    values_.resize(200);
+    for (auto val_ : values_) {
+        for (int shift_ = -300; shift_ <= 300; shift_ += 7) {
+            CHECK(large_int::rotl(val_, shift_) == reference_rotl(val_, shift_));
+            CHECK(large_int::rotr(val_, shift_) == reference_rotl(val_, -shift_));
+        }
+        for (int shift_ : {0, 63, 64, 65, 127, 128, 129, 256, -1, -64, -128, -129}) {
+            CHECK(large_int::rotl(val_, shift_) == reference_rotl(val_, shift_));
+            CHECK(large_int::rotr(large_int::rotl(val_, shift_), shift_) == val_);
+        }
+    }
+}
+
+// deposit and extract against a bit at a time, masks with either half empty or full; under C++14 the constant
+// evaluated result has to match the run-time one
+TEST_CASE(bits_pdep_pext) {
+    std::mt19937_64 rng_(23);
+    auto values_ = bit_values(rng_);
+    for (std::size_t i_ = 0; i_ + 1 < values_.size(); i_ += 3) {
+        auto src_ = values_[i_], mask_ = values_[i_ + 1];
+        auto pdep_ = large_int::pdep(src_, mask_), pext_ = large_int::pext(src_, mask_);
+        CHECK(pdep_ == reference_pdep(src_, mask_) && pext_ == reference_pext(src_, mask_));
+        CHECK(large_int::pext(pdep_, mask_) == (src_ & (large_int::popcount(mask_) == 128
+                                                          ? ~uint128_t(0)
+                                                          : (uint128_t(1) << large_int::popcount(mask_)) - uint128_t(1))));
+        auto low_ = static_cast<uint64_t>(src_), low_mask_ = static_cast<uint64_t>(mask_);
+        CHECK(large_int::bit_helper<uint128_t>::pdep64_(low_, low_mask_) == uint64_t(reference_pdep(src_, mask_)));
+        CHECK(large_int::bit_helper<uint128_t>::pext64_(low_, low_mask_) ==
+              uint64_t(reference_pext(uint128_t(low_), uint128_t(low_mask_))));
+    }
+    CHECK(large_int::pdep(~uint128_t(0), uint128_t(0)) == uint128_t(0));
+    CHECK(large_int::pext(~uint128_t(0), ~uint128_t(0)) == ~uint128_t(0));
+    CHECK(large_int::pdep(~uint128_t(0) >> 1, ~uint128_t(0)) == ~uint128_t(0) >> 1);
+#if __cplusplus >= 201402L
+    volatile uint64_t hide_ = 0; // keeps the run-time calls out of constant folding
+    auto src_ = pdep_src + uint128_t(hide_), mask_ = pdep_mask + uint128_t(hide_);
+    CHECK(const_pdep == large_int::pdep(src_, mask_) && const_pdep == reference_pdep(pdep_src, pdep_mask));
+    CHECK(const_pext == large_int::pext(src_, mask_) && const_pext == reference_pext(pdep_src, pdep_mask));
+#endif
+}
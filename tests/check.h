@@ -0,0 +1,67 @@
+#pragma once
+
+#include "int128.h"
+
+#include <cstdio>
+#include <random>
+
+// a test is a function registered by TEST_CASE, CHECK counts a failure and goes on. int128_test [name] runs all of
+// them or the one named, and fails if any check did.
+namespace int128_test {
+    typedef void (*test_fn)();
+
+    bool add(const char *name_, test_fn fn_);
+
+    void fail(const char *file_, int line_, const char *expr_);
+
+    // full width, or a random bit length, or near a limb edge
+    inline large_int::uint128_t random128(std::mt19937_64 &rng_) {
+        auto val_ = large_int::uint128_t(rng_()) << 64 | large_int::uint128_t(rng_());
+        switch (rng_() % 4) {
+            case 0:
+                return val_;
+            case 1:
+                return val_ >> static_cast<int>(rng_() % 128);
+            case 2:
+                return large_int::uint128_t(~UINT64_C(0)) << static_cast<int>(rng_() % 2 * 64) ^
+                       large_int::uint128_t(rng_() % 4);
+            default:
+                return -(val_ >> static_cast<int>(rng_() % 128));
+        }
+    }
+}
+
+// the compiler's own 128-bit integers as the reference, there on 64-bit targets even where -U__SIZEOF_INT128__ takes
+// them away from int128.h
+#if defined(__GNUC__) && __SIZEOF_POINTER__ == 8
+#define INT128_TEST_BUILTIN 1
+
+namespace int128_test {
+    typedef unsigned __int128 builtin_u128;
+    typedef __int128 builtin_i128;
+
+    inline builtin_u128 to_builtin(large_int::uint128_t val_) {
+        return builtin_u128(static_cast<uint64_t>(val_ >> 64)) << 64 | static_cast<uint64_t>(val_);
+    }
+
+    inline builtin_i128 to_builtin(large_int::int128_t val_) {
+        return static_cast<builtin_i128>(to_builtin(large_int::uint128_t(val_)));
+    }
+
+    inline large_int::uint128_t from_builtin(builtin_u128 val_) {
+        return large_int::uint128_t(static_cast<uint64_t>(val_ >> 64)) << 64 |
+               large_int::uint128_t(static_cast<uint64_t>(val_));
+    }
+
+    inline large_int::int128_t from_builtin(builtin_i128 val_) {
+        return large_int::int128_t(from_builtin(static_cast<builtin_u128>(val_)));
+    }
+}
+#endif
+
+#define TEST_CASE(name) \
+    static void name(); \
+    static const bool name##_registered_ = int128_test::add(#name, name); \
+    static void name()
+
+#define CHECK(expr) do { if (!(expr)) int128_test::fail(__FILE__, __LINE__, #expr); } while (0)
@@ -0,0 +1,158 @@
+#include "int128_column.h"
+
+#include "check.h"
+
+#include <vector>
+
+using large_int::int128_t;
+using large_int::uint128_t;
+
+namespace {
+    namespace dt = large_int::detail_;
+
+    struct kernel_set {
+        const char *name;
+        const dt::column_table_ *table;
+    };
+
+    std::vector<kernel_set> kernel_sets() {
+        std::vector<kernel_set> sets_ = {{"scalar", &dt::column_scalar_kernels_()}};
+#ifdef INT128_COLUMN_X86
+        if (__builtin_cpu_supports("avx2")) sets_.push_back({"avx2", &dt::column_avx2_kernels_()});
+        if (__builtin_cpu_supports("avx512f")) sets_.push_back({"avx512", &dt::column_avx512_kernels_()});
+#endif
+        return sets_;
+    }
+
+    // halves that make the kernels carry, borrow, and compare on the low half after equal high ones
+    uint64_t pick_half(std::mt19937_64 &rng_, uint64_t other_) {
+        switch (rng_() % 5) {
+            case 0:
+                return other_;
+            case 1:
+                return ~UINT64_C(0) - rng_() % 3;
+            case 2:
+                return rng_() % 3;
+            case 3:
+                return UINT64_C(1) << 63 ^ (rng_() % 2);
+            default:
+                return rng_();
+        }
+    }
+
+    struct arrays {
+        std::vector<uint64_t> lhs_high, lhs_low, rhs_high, rhs_low, out_high, out_low;
+        std::vector<uint8_t> mask, pick;
+
+        arrays(std::mt19937_64 &rng_, std::size_t size_)
+                : lhs_high(size_), lhs_low(size_), rhs_high(size_), rhs_low(size_), out_high(size_ + 8, 0x5a),
+                  out_low(size_ + 8, 0x5a), mask(size_ + 8, 0x5a), pick(size_) {
+            for (std::size_t i_ = 0; i_ < size_; ++i_) {
+                lhs_high[i_] = rng_();
+                lhs_low[i_] = rng_();
+                rhs_high[i_] = pick_half(rng_, lhs_high[i_]);
+                rhs_low[i_] = pick_half(rng_, lhs_low[i_]);
+                pick[i_] = static_cast<uint8_t>(rng_() % 3 ? 0 : rng_() % 255 + 1);
+            }
+        }
+
+        dt::column_args_ args() {
+            return {lhs_high.data(), lhs_low.data(), rhs_high.data(), rhs_low.data(), out_high.data(), out_low.data(),
+                    mask.data(), pick.data()};
+        }
+    };
+
+    template<class _Tp>
+    _Tp at(const std::vector<uint64_t> &high_, const std::vector<uint64_t> &low_, std::size_t i_) {
+        return _Tp(uint128_t(high_[i_]) << 64 | uint128_t(low_[i_]));
+    }
+
+    // runs fn_ over [first_, size_) and holds every lane against the operators, lanes outside untouched
+    template<class _Tp, class _Ref>
+    void check_values(dt::column_fn_ fn_, std::mt19937_64 &rng_, std::size_t size_, std::size_t first_, _Ref ref_) {
+        arrays a_(rng_, size_);
+        fn_(a_.args(), first_, size_);
+        for (std::size_t i_ = 0; i_ < size_ + 8; ++i_) {
+            if (i_ < first_ || i_ >= size_) {
+                CHECK(a_.out_high[i_] == 0x5a && a_.out_low[i_] == 0x5a);
+                continue;
+            }
+            auto lhs_ = at<_Tp>(a_.lhs_high, a_.lhs_low, i_), rhs_ = at<_Tp>(a_.rhs_high, a_.rhs_low, i_);
+            CHECK(at<_Tp>(a_.out_high, a_.out_low, i_) == ref_(lhs_, rhs_, a_.pick[i_]));
+        }
+    }
+
+    template<class _Tp, class _Ref>
+    void check_mask(dt::column_fn_ fn_, std::mt19937_64 &rng_, std::size_t size_, std::size_t first_, _Ref ref_) {
+        arrays a_(rng_, size_);
+        fn_(a_.args(), first_, size_);
+        for (std::size_t i_ = 0; i_ < size_ + 8; ++i_) {
+            if (i_ < first_ || i_ >= size_) {
+                CHECK(a_.mask[i_] == 0x5a);
+                continue;
+            }
+            auto lhs_ = at<_Tp>(a_.lhs_high, a_.lhs_low, i_), rhs_ = at<_Tp>(a_.rhs_high, a_.rhs_low, i_);
+            CHECK(a_.mask[i_] == uint8_t(ref_(lhs_, rhs_)));
+        }
+    }
+
+    template<class _Tp>
+    void check_typed(const dt::column_table_ &table_, std::mt19937_64 &rng_, std::size_t size_, std::size_t first_) {
+        auto sign_ = dt::column_signed_<_Tp>();
+        check_mask<_Tp>(table_.less[sign_], rng_, size_, first_, [](_Tp l_, _Tp r_) { return l_ < r_; });
+        check_values<_Tp>(table_.min[sign_], rng_, size_, first_, [](_Tp l_, _Tp r_, uint8_t) {
+            return r_ < l_ ? r_ : l_;
+        });
+        check_values<_Tp>(table_.max[sign_], rng_, size_, first_, [](_Tp l_, _Tp r_, uint8_t) {
+            return l_ < r_ ? r_ : l_;
+        });
+    }
+}
+
+// every kernel the cpu runs against the operators, for every length up to two AVX-512 blocks and a tail, from the
+// start and from one past it
+TEST_CASE(column_kernels) {
+    std::mt19937_64 rng_(11);
+    for (auto &set_ : kernel_sets()) {
+        auto &table_ = *set_.table;
+        for (std::size_t size_ = 0; size_ <= 2 * 8 + 1; ++size_) {
+            for (std::size_t first_ = 0; first_ < 2 && first_ <= size_; ++first_) {
+                for (int trial_ = 0; trial_ < 20; ++trial_) {
+                    check_values<uint128_t>(table_.add, rng_, size_, first_, [](uint128_t l_, uint128_t r_, uint8_t) {
+                        return l_ + r_;
+                    });
+                    check_values<uint128_t>(table_.sub, rng_, size_, first_, [](uint128_t l_, uint128_t r_, uint8_t) {
+                        return l_ - r_;
+                    });
+                    check_values<uint128_t>(table_.select, rng_, size_, first_,
+                                            [](uint128_t l_, uint128_t r_, uint8_t p_) { return p_ ? l_ : r_; });
+                    check_mask<uint128_t>(table_.equal, rng_, size_, first_, [](uint128_t l_, uint128_t r_) {
+                        return l_ == r_;
+                    });
+                    check_typed<uint128_t>(table_, rng_, size_, first_);
+                    check_typed<int128_t>(table_, rng_, size_, first_);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE(column_api) {
+    std::mt19937_64 rng_(12);
+    std::vector<int128_t> lhs_(37), rhs_(41);
+    for (auto &v_ : lhs_) v_ = int128_t(int128_test::random128(rng_));
+    for (auto &v_ : rhs_) v_ = int128_t(int128_test::random128(rng_));
+    large_int::int128_column a_(lhs_.data(), lhs_.size()), b_(rhs_.data(), rhs_.size()), out_;
+    large_int::column_add(a_, b_, out_);
+    CHECK(out_.size() == 37);
+    for (std::size_t i_ = 0; i_ < 37; ++i_) CHECK(out_[i_] == lhs_[i_] + rhs_[i_]);
+    large_int::column_min(a_, b_, out_);
+    for (std::size_t i_ = 0; i_ < 37; ++i_) CHECK(out_[i_] == (rhs_[i_] < lhs_[i_] ? rhs_[i_] : lhs_[i_]));
+    uint8_t mask_[37];
+    large_int::column_less(a_, b_, mask_);
+    for (std::size_t i_ = 0; i_ < 37; ++i_) CHECK(mask_[i_] == uint8_t(lhs_[i_] < rhs_[i_]));
+    large_int::column_select(mask_, a_, b_, out_);
+    for (std::size_t i_ = 0; i_ < 37; ++i_) CHECK(out_[i_] == (mask_[i_] ? lhs_[i_] : rhs_[i_]));
+    large_int::column_sub(a_, a_, a_); // in place
+    for (std::size_t i_ = 0; i_ < 37; ++i_) CHECK(a_[i_] == int128_t(0));
+}
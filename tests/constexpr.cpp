@@ -0,0 +1,106 @@
+#include "int128.h"
+
+#include "check.h"
+
+using large_int::int128_t;
+using large_int::uint128_t;
+
+// what C++14 makes constexpr, checked by the compiler: each static_assert fails to build if a path on the way uses
+// asm, an intrinsic, floating point or an uninitialized local in a constant expression
+#if __cplusplus >= 201402L
+namespace {
+    constexpr uint128_t make128(uint64_t high_, uint64_t low_) { return uint128_t(high_) << 64 | uint128_t(low_); }
+
+    constexpr int128_t min128 = int128_t(uint128_t(1) << 127);
+    constexpr uint128_t ten19 = uint128_t(UINT64_C(10000000000000000000));
+    constexpr uint128_t two_limbs = make128(0x123456789abcdefULL, 0xfedcba9876543210ULL);
+
+    template<bool _Native>
+    using delegate = large_int::detail_delegate<_Native>;
+
+    // one limb, two limbs with a one limb quotient, and a divisor above the dividend
+    template<bool _Native>
+    constexpr bool divides() {
+        return delegate<_Native>::div(~uint128_t(0), ten19) == make128(1, 0xd83c94fb6d2ac34aULL) &&
+               delegate<_Native>::mod(~uint128_t(0), ten19) == uint128_t(UINT64_C(3374607431768211455)) &&
+               delegate<_Native>::div(~uint128_t(0), two_limbs) == uint128_t(0xe1) &&
+               delegate<_Native>::mod(two_limbs, ~uint128_t(0)) == two_limbs &&
+               delegate<_Native>::div(two_limbs, ~uint128_t(0)) == uint128_t(0) &&
+               delegate<_Native>::div(int128_t(-7), int128_t(2)) == int128_t(-3) &&
+               delegate<_Native>::mod(int128_t(-7), int128_t(2)) == int128_t(-1) &&
+               delegate<_Native>::div(min128, int128_t(ten19)) == -int128_t(UINT64_C(17014118346046923173)) &&
+               delegate<_Native>::mod(min128, int128_t(ten19)) == -int128_t(UINT64_C(1687303715884105728));
+    }
+
+    static_assert(divides<false>(), "fallback division");
+#ifdef __SIZEOF_INT128__
+    static_assert(divides<true>(), "native division");
+#endif
+
+    static_assert(~uint128_t(0) / uint128_t(3) == make128(0x5555555555555555ULL, 0x5555555555555555ULL), "");
+    static_assert(~uint128_t(0) % two_limbs == ~uint128_t(0) - uint128_t(0xe1) * two_limbs, "");
+    static_assert(large_int::divmod(int128_t(-7), int128_t(2)).quot == int128_t(-3), "");
+    static_assert(large_int::divmod(int128_t(-7), int128_t(2)).rem == int128_t(-1), "");
+    static_assert(large_int::divmod(int128_t(7), int128_t(-2)).quot == int128_t(-3), "");
+    static_assert(large_int::divmod(int128_t(7), int128_t(-2)).rem == int128_t(1), "");
+    static_assert(large_int::divmod(int128_t(-7), int128_t(-2)).quot == int128_t(3), "");
+    static_assert(large_int::divmod(int128_t(-7), int128_t(-2)).rem == int128_t(-1), "");
+    static_assert(large_int::divmod(min128, int128_t(-2)).quot == int128_t(uint128_t(1) << 126), "");
+
+    constexpr uint128_t compound() {
+        auto val_ = ~uint128_t(0);
+        val_ /= ten19;
+        val_ %= uint128_t(1000);
+        return val_;
+    }
+
+    static_assert(compound() == uint128_t(346), "");
+
+    // the README example
+    struct powers {
+        uint128_t v[39];
+    };
+
+    constexpr powers make_powers() {
+        powers p_{};
+        p_.v[0] = uint128_t(1);
+        for (int i_ = 1; i_ < 39; ++i_) p_.v[i_] = p_.v[i_ - 1] * uint128_t(10);
+        return p_;
+    }
+
+    constexpr powers pow10 = make_powers();
+
+    static_assert(pow10.v[19] == ten19 && pow10.v[38] / pow10.v[19] == ten19 && pow10.v[38] % pow10.v[37] == 0, "");
+
+    struct text {
+        char buf[41];
+        std::size_t size;
+    };
+
+    constexpr text min_text() {
+        text res_{};
+        auto out_ = large_int::to_chars_constexpr(res_.buf, res_.buf + sizeof(res_.buf), min128);
+        res_.size = static_cast<std::size_t>(out_.ptr - res_.buf);
+        return res_;
+    }
+
+    constexpr bool equal(const char *lhs_, const char *rhs_, std::size_t size_) {
+        for (std::size_t i_ = 0; i_ < size_; ++i_) {
+            if (lhs_[i_] != rhs_[i_]) return false;
+        }
+        return true;
+    }
+
+    constexpr text min_text_ = min_text();
+
+    static_assert(min_text_.size == 40 && equal(min_text_.buf, "-170141183460469231731687303715884105728", 40), "");
+}
+
+// the same tables at run time, against the operators
+TEST_CASE(constexpr_tables) {
+    uint128_t pow_(1);
+    for (int i_ = 0; i_ < 39; ++i_, pow_ *= uint128_t(10)) CHECK(pow10.v[i_] == pow_);
+    CHECK(std::string(min_text_.buf, min_text_.size) == large_int::to_string(min128));
+    CHECK(divides<false>());
+}
+#endif
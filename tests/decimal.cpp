@@ -0,0 +1,250 @@
+#include "int128_decimal.h"
+#include "wide_int.h"
+
+#include "check.h"
+
+#include <iomanip>
+#include <locale>
+#include <sstream>
+#include <string>
+
+using large_int::decimal;
+using large_int::int128_t;
+using large_int::rounding;
+using large_int::uint128_t;
+using large_int::uint256_t;
+
+namespace {
+    const rounding modes[] = {rounding::toward_zero, rounding::floor, rounding::ceil, rounding::half_up,
+                              rounding::half_even};
+
+    const int128_t min128 = int128_t(uint128_t(1) << 127);
+
+    uint128_t magnitude(int128_t val_) { return val_ < int128_t(0) ? -uint128_t(val_) : uint128_t(val_); }
+
+    uint256_t pow10(unsigned n_) {
+        uint256_t res_ = 1;
+        while (n_--) res_ *= uint256_t(10);
+        return res_;
+    }
+
+    // num_ / den_ of sign neg_ rounded as mode_ on 256 bits, the ties found from twice the remainder; fits_ is
+    // false when the result is out of the range of int128_t
+    int128_t round_ref(const uint256_t &num_, const uint256_t &den_, bool neg_, rounding mode_, bool &fits_) {
+        auto quot_ = num_ / den_, rem_ = num_ % den_;
+        bool away_ = false;
+        if (rem_) {
+            switch (mode_) {
+                case rounding::toward_zero:
+                    break;
+                case rounding::floor:
+                    away_ = neg_;
+                    break;
+                case rounding::ceil:
+                    away_ = !neg_;
+                    break;
+                case rounding::half_up:
+                    away_ = rem_ + rem_ >= den_;
+                    break;
+                case rounding::half_even:
+                    away_ = rem_ + rem_ > den_ || (rem_ + rem_ == den_ && (quot_.limb(0) & 1));
+                    break;
+            }
+        }
+        if (away_) ++quot_;
+        fits_ = quot_ < (uint256_t(1) << 127) + uint256_t(neg_);
+        auto mag_ = uint128_t(quot_);
+        return int128_t(neg_ ? -mag_ : mag_);
+    }
+
+    // a raw value of a random width, or one whose digits past keep_ are a tie, 5 then zeros
+    template<unsigned _Scale>
+    int128_t make_raw(std::mt19937_64 &rng_, unsigned keep_) {
+        auto val_ = int128_t(int128_test::random128(rng_) >> static_cast<int>(rng_() % 100 + 1));
+        if (keep_ < _Scale && rng_() % 3 == 0) {
+            auto unit_ = large_int::detail_::pow10_(_Scale - keep_);
+            auto mag_ = magnitude(val_) / unit_ * unit_ + unit_ / uint128_t(2);
+            val_ = int128_t(val_ < int128_t(0) ? -mag_ : mag_);
+        }
+        return val_;
+    }
+
+    // mul, div and rescale in every mode against the rounding of the exact 256-bit quotient, the cases whose
+    // result does not fit skipped
+    template<unsigned _Scale, unsigned _To>
+    void check_rounding(std::mt19937_64 &rng_) {
+        typedef decimal<_Scale> _Dec;
+        // 0.5 and 2 now and then, so the products and quotients land on ties, 2 does not fit at Scale 38
+        const auto half_ = int128_t(large_int::detail_::pow10_(_Scale) / uint128_t(2));
+        const auto two_ = _Scale < 38 ? int128_t(large_int::detail_::pow10_(_Scale) * uint128_t(2)) : int128_t(0);
+        for (int i_ = 0; i_ < 2000; ++i_) {
+            auto lhs_ = _Dec::from_raw(make_raw<_Scale>(rng_, 0));
+            auto rhs_ = _Dec::from_raw(i_ % 4 == 0 && half_ ? half_ : i_ % 4 == 1 && two_ ? two_ :
+                                       make_raw<_Scale>(rng_, 0));
+            if (rng_() & 1) rhs_ = -rhs_;
+            bool neg_ = (lhs_.raw() < int128_t(0)) != (rhs_.raw() < int128_t(0)), fits_;
+            auto lmag_ = uint256_t(magnitude(lhs_.raw())), rmag_ = uint256_t(magnitude(rhs_.raw()));
+            for (auto mode_ : modes) {
+                auto want_ = round_ref(lmag_ * rmag_, pow10(_Scale), neg_, mode_, fits_);
+                if (fits_) CHECK(large_int::mul(lhs_, rhs_, mode_).raw() == want_);
+                if (rhs_.raw() == int128_t(0)) continue;
+                want_ = round_ref(lmag_ * pow10(_Scale), rmag_, neg_, mode_, fits_);
+                if (fits_) CHECK(large_int::div(lhs_, rhs_, mode_).raw() == want_);
+            }
+            auto raw_ = make_raw<_Scale>(rng_, _To);
+            auto value_ = _Dec::from_raw(raw_);
+            for (auto mode_ : modes) {
+                auto want_ = round_ref(uint256_t(magnitude(raw_)), pow10(_Scale - _To), raw_ < int128_t(0), mode_,
+                                       fits_);
+                CHECK(value_.template rescale<_To>(mode_).raw() == want_);
+            }
+        }
+    }
+
+    template<unsigned _Scale>
+    std::string print(decimal<_Scale> value_, std::ios::fmtflags flags_ = std::ios::fmtflags(), int width_ = 0,
+                      const std::locale &loc_ = std::locale::classic()) {
+        std::ostringstream os_;
+        os_.imbue(loc_);
+        os_.flags(flags_);
+        os_ << std::setw(width_) << value_;
+        return os_.str();
+    }
+
+    // 1.234.567,89 as in much of Europe, the fraction is never grouped
+    struct comma_point : std::numpunct<char> {
+        char do_decimal_point() const override { return ','; }
+
+        char do_thousands_sep() const override { return '.'; }
+
+        std::string do_grouping() const override { return "\3"; }
+    };
+}
+
+TEST_CASE(decimal_rounding) {
+    std::mt19937_64 rng_(18);
+    check_rounding<0, 0>(rng_);
+    check_rounding<2, 0>(rng_);
+    check_rounding<2, 1>(rng_);
+    check_rounding<18, 9>(rng_);
+    check_rounding<38, 0>(rng_);
+    check_rounding<38, 37>(rng_);
+}
+
+// each mode on the ties and next to them, by hand
+TEST_CASE(decimal_modes) {
+    typedef decimal<1> _D1;
+    struct {
+        int128_t raw;
+        int128_t want[5]; // toward_zero, floor, ceil, half_up, half_even
+    } cases_[] = {
+            {25, {2, 2, 3, 3, 2}},
+            {35, {3, 3, 4, 4, 4}},
+            {-25, {-2, -3, -2, -3, -2}},
+            {-26, {-2, -3, -2, -3, -3}},
+            {24, {2, 2, 3, 2, 2}},
+            {-1, {0, -1, 0, 0, 0}},
+            {30, {3, 3, 3, 3, 3}},
+    };
+    for (auto &c_ : cases_) {
+        for (int m_ = 0; m_ < 5; ++m_) {
+            CHECK(_D1::from_raw(c_.raw).rescale<0>(modes[m_]).raw() == c_.want[m_]);
+            CHECK(_D1::from_raw(c_.raw).to_integer(modes[m_]) == c_.want[m_]);
+        }
+    }
+    // 0.25 and -0.25 from a product and from a quotient, rounded to one digit
+    auto half_ = _D1::from_raw(5), two_ = _D1(2);
+    const int128_t want_pos_[] = {2, 2, 3, 3, 2}, want_neg_[] = {-2, -3, -2, -3, -2};
+    for (int m_ = 0; m_ < 5; ++m_) {
+        CHECK(large_int::mul(half_, half_, modes[m_]).raw() == want_pos_[m_]);
+        CHECK(large_int::mul(-half_, half_, modes[m_]).raw() == want_neg_[m_]);
+        CHECK(large_int::div(half_, two_, modes[m_]).raw() == want_pos_[m_]);
+        CHECK(large_int::div(half_, -two_, modes[m_]).raw() == want_neg_[m_]);
+    }
+    CHECK(half_ * half_ == _D1::from_raw(2));
+    CHECK(_D1(1) / _D1(3) == _D1::from_raw(3));
+}
+
+// Scale 0 is plain integers, Scale 38 takes the 256-bit products, INT128_MIN has no positive counterpart
+TEST_CASE(decimal_limits) {
+    CHECK(large_int::mul(decimal<0>(-7), decimal<0>(6)).raw() == int128_t(-42));
+    CHECK(large_int::div(decimal<0>(7), decimal<0>(2)).raw() == int128_t(4));
+    CHECK(large_int::div(decimal<0>(7), decimal<0>(2), rounding::toward_zero).raw() == int128_t(3));
+    CHECK(large_int::div(decimal<0>(-7), decimal<0>(2), rounding::floor).raw() == int128_t(-4));
+    CHECK(to_string(decimal<0>(-7)) == "-7");
+    CHECK(to_string(decimal<0>()) == "0");
+
+    typedef decimal<38> _D38;
+    auto one_ = _D38(1), half_ = _D38::from_raw(int128_t(large_int::detail_::pow10_(37) * uint128_t(5)));
+    CHECK(to_string(one_) == "1.00000000000000000000000000000000000000");
+    CHECK(to_string(-half_) == "-0.50000000000000000000000000000000000000");
+    CHECK(one_ * one_ == one_);
+    CHECK(large_int::mul(half_, -one_) == -half_);
+    CHECK(one_ / (half_ + half_) == one_);
+    CHECK(half_ / one_ == half_);
+    CHECK(_D38::from_raw(1) * half_ == _D38());
+    CHECK(large_int::mul(_D38::from_raw(1), half_, rounding::half_up) == _D38::from_raw(1));
+    CHECK(large_int::mul(_D38::from_raw(-1), half_, rounding::floor) == _D38::from_raw(-1));
+    CHECK(one_.rescale<0>().raw() == int128_t(1));
+    CHECK(half_.rescale<0>().raw() == int128_t(0));
+    CHECK(half_.rescale<0>(rounding::half_up).raw() == int128_t(1));
+
+    auto min_ = decimal<2>::from_raw(min128);
+    CHECK(to_string(min_) == "-1701411834604692317316873037158841057.28");
+    CHECK(print(min_) == "-1701411834604692317316873037158841057.28");
+    CHECK(to_string(decimal<0>::from_raw(min128)) == "-170141183460469231731687303715884105728");
+    CHECK(to_string(decimal<38>::from_raw(min128)) == "-1.70141183460469231731687303715884105728");
+    CHECK(large_int::mul(min_, decimal<2>(1)) == min_);
+    CHECK(large_int::div(min_, decimal<2>(1)) == min_);
+    CHECK(to_string(min_.rescale<0>()) == "-1701411834604692317316873037158841057");
+    CHECK(to_string(min_.rescale<0>(rounding::floor)) == "-1701411834604692317316873037158841058");
+
+    char buf_[8];
+    auto res_ = large_int::to_chars(buf_, buf_ + sizeof(buf_), min_);
+    CHECK(res_.ec == std::errc::value_too_large && res_.ptr == buf_ + sizeof(buf_));
+    res_ = large_int::to_chars(buf_, buf_ + 5, decimal<2>::from_raw(-123));
+    CHECK(res_.ec == std::errc() && std::string(buf_, res_.ptr) == "-1.23");
+    res_ = large_int::to_chars(buf_, buf_ + 4, decimal<2>::from_raw(-123));
+    CHECK(res_.ec == std::errc::value_too_large);
+}
+
+// the example of the README
+TEST_CASE(decimal_readme) {
+    large_int::decimal<2> price = 19, rate = large_int::decimal<2>::from_raw(5); // 0.05
+    auto tax = large_int::mul(price, rate, large_int::rounding::half_up);
+    std::ostringstream out;
+    out << tax << ' ' << price.rescale<0>() << ' ' << to_string(price / 3);
+    CHECK(out.str() == "0.95 19 6.33");
+}
+
+// the point from the locale, grouping only left of it, and the sign, width and fill of the stream around both
+TEST_CASE(decimal_stream) {
+    typedef decimal<2> _D2;
+    auto val_ = _D2::from_raw(123456789), neg_ = -_D2::from_raw(5);
+    CHECK(print(val_) == "1234567.89");
+    CHECK(print(neg_) == "-0.05");
+    CHECK(print(_D2()) == "0.00");
+    CHECK(print(val_, std::ios::showpos) == "+1234567.89");
+    CHECK(print(neg_, std::ios::showpos) == "-0.05");
+    CHECK(print(_D2(), std::ios::showpos) == "+0.00");
+    CHECK(print(val_, std::ios::hex | std::ios::showbase) == "1234567.89"); // always decimal
+    CHECK(print(neg_, std::ios::fmtflags(), 8) == "   -0.05");
+    CHECK(print(neg_, std::ios::left, 8) == "-0.05   ");
+    CHECK(print(neg_, std::ios::internal, 8) == "-   0.05");
+    CHECK(print(val_, std::ios::showpos | std::ios::left, 13) == "+1234567.89  ");
+    CHECK(print(val_, std::ios::fmtflags(), 4) == "1234567.89");
+
+    std::locale comma_(std::locale::classic(), new comma_point);
+    CHECK(print(val_, std::ios::fmtflags(), 0, comma_) == "1.234.567,89");
+    CHECK(print(-val_, std::ios::fmtflags(), 0, comma_) == "-1.234.567,89");
+    CHECK(print(_D2::from_raw(99999), std::ios::fmtflags(), 0, comma_) == "999,99");
+    CHECK(print(_D2::from_raw(100000), std::ios::fmtflags(), 0, comma_) == "1.000,00");
+    CHECK(print(decimal<6>::from_raw(1234567890), std::ios::fmtflags(), 0, comma_) == "1.234,567890");
+    CHECK(print(val_, std::ios::showpos | std::ios::internal, 15, comma_) == "+  1.234.567,89");
+    CHECK(print(val_, std::ios::left, 14, comma_) == "1.234.567,89  ");
+    CHECK(print(decimal<0>(1234567), std::ios::fmtflags(), 0, comma_) == "1.234.567");
+
+    std::ostringstream os_;
+    os_ << std::setfill('*') << std::setw(7) << _D2::from_raw(-150) << '|' << _D2::from_raw(7);
+    CHECK(os_.str() == "**-1.50|0.07");
+}
@@ -0,0 +1,194 @@
+#include "int128.h"
+
+#include "check.h"
+
+#include <vector>
+
+using large_int::int128_t;
+using large_int::uint128_t;
+
+namespace {
+    const int128_t min128 = int128_t(uint128_t(1) << 127);
+
+    uint128_t pow2(int exp_) { return uint128_t(1) << exp_; }
+
+    // one limb, two limbs, and the ones whose quotient estimates need correcting: all ones in either limb, a lone
+    // high bit with the low one set, the top of the range
+    std::vector<uint128_t> edge_divisors() {
+        return {uint128_t(1), uint128_t(2), uint128_t(3), uint128_t(7), uint128_t(10), uint128_t(UINT64_C(0xffffffff)),
+                uint128_t(UINT64_C(0x100000001)), uint128_t(UINT64_C(10000000000000000000)),
+                pow2(63), pow2(63) + uint128_t(1), pow2(64) - uint128_t(1), pow2(64), pow2(64) + uint128_t(1),
+                pow2(96) - uint128_t(1), pow2(96) + uint128_t(1), pow2(127) - uint128_t(1), pow2(127),
+                pow2(127) + uint128_t(1), ~uint128_t(0) - uint128_t(1), ~uint128_t(0),
+                uint128_t(UINT64_C(0x8000000000000000)) << 64 | uint128_t(~UINT64_C(0)),
+                uint128_t(UINT64_C(0xffffffff00000000)) << 64 | uint128_t(UINT64_C(0xffffffff))};
+    }
+
+    // q * d + r for quotients up to every width and the largest remainder, or the dividend itself
+    std::vector<uint128_t> dividends_for(uint128_t div_, std::mt19937_64 &rng_) {
+        std::vector<uint128_t> res_ = {uint128_t(0), uint128_t(1), div_ - uint128_t(1), div_, div_ + uint128_t(1),
+                                       ~uint128_t(0), ~uint128_t(0) - div_, pow2(127), pow2(64) - uint128_t(1)};
+        for (int i_ = 0; i_ < 40; ++i_) {
+            auto quot_ = (~uint128_t(0) / div_) >> static_cast<int>(rng_() % 128);
+            res_.push_back(quot_ * div_ + (div_ - uint128_t(1)));
+            res_.push_back(quot_ * div_);
+            res_.push_back(int128_test::random128(rng_));
+        }
+        return res_;
+    }
+
+    void check_unsigned(uint128_t lhs_, uint128_t rhs_) {
+        auto res_ = large_int::divmod(lhs_, rhs_);
+        CHECK(lhs_ / rhs_ == res_.quot && lhs_ % rhs_ == res_.rem);
+        CHECK(res_.rem < rhs_ && res_.quot * rhs_ + res_.rem == lhs_);
+        uint128_t rem_;
+        CHECK(large_int::detail_delegate<false>::divmod(lhs_, rhs_, rem_) == res_.quot && rem_ == res_.rem);
+        auto div_ = lhs_, mod_ = lhs_;
+        div_ /= rhs_;
+        mod_ %= rhs_;
+        CHECK(div_ == res_.quot && mod_ == res_.rem);
+#ifdef INT128_TEST_BUILTIN
+        auto a_ = int128_test::to_builtin(lhs_), b_ = int128_test::to_builtin(rhs_);
+        CHECK(res_.quot == int128_test::from_builtin(a_ / b_) && res_.rem == int128_test::from_builtin(a_ % b_));
+#endif
+    }
+
+    // truncated toward zero, the remainder takes the sign of the dividend
+    void check_signed(int128_t lhs_, int128_t rhs_) {
+        if (lhs_ == min128 && rhs_ == int128_t(-1)) return;
+        auto res_ = large_int::divmod(lhs_, rhs_);
+        CHECK(lhs_ / rhs_ == res_.quot && lhs_ % rhs_ == res_.rem);
+        CHECK(res_.quot * rhs_ + res_.rem == lhs_);
+        CHECK(!res_.rem || (res_.rem < int128_t(0)) == (lhs_ < int128_t(0)));
+        auto abs_ = [](int128_t val_) { return val_ < int128_t(0) ? -uint128_t(val_) : uint128_t(val_); };
+        CHECK(abs_(res_.rem) < abs_(rhs_));
+        int128_t rem_;
+        CHECK(large_int::detail_delegate<false>::divmod(lhs_, rhs_, rem_) == res_.quot && rem_ == res_.rem);
+        auto div_ = lhs_, mod_ = lhs_;
+        div_ /= rhs_;
+        mod_ %= rhs_;
+        CHECK(div_ == res_.quot && mod_ == res_.rem);
+#ifdef INT128_TEST_BUILTIN
+        auto a_ = int128_test::to_builtin(lhs_), b_ = int128_test::to_builtin(rhs_);
+        CHECK(res_.quot == int128_test::from_builtin(a_ / b_) && res_.rem == int128_test::from_builtin(a_ % b_));
+#endif
+    }
+}
+
+// operands of every width and near the limb edges, through the delegate of the build and the fallback one
+TEST_CASE(divide_random) {
+    std::mt19937_64 rng_(1);
+    for (int i_ = 0; i_ < 50000; ++i_) {
+        auto lhs_ = int128_test::random128(rng_), rhs_ = int128_test::random128(rng_);
+        if (!rhs_) continue;
+        check_unsigned(lhs_, rhs_);
+        check_signed(int128_t(lhs_), int128_t(rhs_));
+    }
+}
+
+// one and two limb divisors, divisors above the dividend, and dividends one below a multiple where the estimate is
+// most often too large
+TEST_CASE(divide_edges) {
+    std::mt19937_64 rng_(2);
+    for (auto div_ : edge_divisors()) {
+        for (auto num_ : dividends_for(div_, rng_)) {
+            check_unsigned(num_, div_);
+            check_unsigned(div_ >> 1, div_);
+            for (auto sdiv_ : {int128_t(div_), -int128_t(div_)}) {
+                if (!sdiv_) continue;
+                check_signed(int128_t(num_), sdiv_);
+                check_signed(-int128_t(num_), sdiv_);
+            }
+        }
+    }
+    CHECK(min128 / int128_t(1) == min128 && min128 % int128_t(1) == int128_t(0));
+    CHECK(min128 / int128_t(-2) == int128_t(pow2(126)) && min128 / min128 == int128_t(1));
+    CHECK(int128_t(-7) / int128_t(2) == int128_t(-3) && int128_t(-7) % int128_t(2) == int128_t(-1));
+    CHECK(int128_t(7) / int128_t(-2) == int128_t(-3) && int128_t(7) % int128_t(-2) == int128_t(1));
+    CHECK(~uint128_t(0) / ~uint128_t(0) == uint128_t(1) && (~uint128_t(0) - uint128_t(1)) / ~uint128_t(0) == uint128_t(0));
+    CHECK(~uint128_t(0) / (pow2(127) + uint128_t(1)) == uint128_t(1));
+    CHECK(~uint128_t(0) % (pow2(127) + uint128_t(1)) == pow2(127) - uint128_t(2));
+}
+
+// every kind of uint128_divider: powers of two, one limb with its reciprocal, the magic multiplier and the one that
+// needs 129 bits, against plain division
+TEST_CASE(divider_unsigned) {
+    std::mt19937_64 rng_(3);
+    auto divs_ = edge_divisors();
+    for (int k_ = 0; k_ < 128; ++k_) divs_.push_back(pow2(k_));
+    for (int i_ = 0; i_ < 200; ++i_) {
+        auto div_ = int128_test::random128(rng_);
+        if (div_) divs_.push_back(div_);
+    }
+    for (auto div_ : divs_) {
+        large_int::uint128_divider divider_(div_);
+        CHECK(divider_.divisor() == div_);
+        for (auto num_ : dividends_for(div_, rng_)) {
+            auto want_ = large_int::divmod(num_, div_);
+            auto res_ = divider_.divmod(num_);
+            CHECK(divider_.divide(num_) == want_.quot && res_.quot == want_.quot && res_.rem == want_.rem);
+            CHECK(num_ / divider_ == want_.quot && num_ % divider_ == want_.rem);
+            res_ = divmod(num_, divider_);
+            CHECK(res_.quot == want_.quot && res_.rem == want_.rem);
+            auto q_ = num_, r_ = num_;
+            q_ /= divider_;
+            r_ %= divider_;
+            CHECK(q_ == want_.quot && r_ == want_.rem);
+        }
+    }
+}
+
+// signed divisors of both signs up to INT128_MIN, truncated as operator/ does
+TEST_CASE(divider_signed) {
+    std::mt19937_64 rng_(4);
+    std::vector<int128_t> divs_ = {min128, int128_t(-1), -int128_t(pow2(64)), -int128_t(pow2(127) - uint128_t(1))};
+    for (auto div_ : edge_divisors()) {
+        divs_.push_back(int128_t(div_));
+        divs_.push_back(-int128_t(div_));
+    }
+    for (int i_ = 0; i_ < 200; ++i_) {
+        auto div_ = int128_t(int128_test::random128(rng_));
+        if (div_) divs_.push_back(div_);
+    }
+    for (auto div_ : divs_) {
+        if (!div_) continue;
+        large_int::int128_divider divider_(div_);
+        CHECK(divider_.divisor() == div_);
+        for (auto unum_ : dividends_for(uint128_t(div_), rng_)) {
+            for (auto num_ : {int128_t(unum_), -int128_t(unum_), min128}) {
+                if (num_ == min128 && div_ == int128_t(-1)) continue;
+                auto want_ = large_int::divmod(num_, div_);
+                auto res_ = divider_.divmod(num_);
+                CHECK(divider_.divide(num_) == want_.quot && res_.quot == want_.quot && res_.rem == want_.rem);
+                CHECK(num_ / divider_ == want_.quot && num_ % divider_ == want_.rem);
+                res_ = divmod(num_, divider_);
+                CHECK(res_.quot == want_.quot && res_.rem == want_.rem);
+                auto q_ = num_, r_ = num_;
+                q_ /= divider_;
+                r_ %= divider_;
+                CHECK(q_ == want_.quot && r_ == want_.rem);
+            }
+        }
+    }
+}
+
+// the split print_value takes for decimal output, by 10^19 and by other one limb divisors
+TEST_CASE(divider_part_div) {
+    std::mt19937_64 rng_(5);
+    const uint64_t ten19_ = UINT64_C(10000000000000000000);
+    for (uint64_t div_ : {ten19_, UINT64_C(1000000000), ~UINT64_C(0), UINT64_C(3) << 62}) {
+        large_int::uint128_divider divider_{uint128_t(div_)};
+        auto limit_ = uint128_t(div_) * uint128_t(div_);
+        for (int i_ = 0; i_ < 2000; ++i_) {
+            auto num_ = int128_test::random128(rng_);
+            if (num_ / limit_ >> 64) continue;
+            uint64_t high_, mid_, low_;
+            divider_.part_div(num_, high_, mid_, low_);
+            CHECK(low_ < div_ && mid_ < div_);
+            CHECK((uint128_t(high_) * uint128_t(div_) + uint128_t(mid_)) * uint128_t(div_) + uint128_t(low_) == num_);
+        }
+    }
+    uint64_t high_, mid_, low_;
+    large_int::detail_::ten19_divider_().part_div(~uint128_t(0), high_, mid_, low_);
+    CHECK(high_ == 3 && mid_ == UINT64_C(4028236692093846346) && low_ == UINT64_C(3374607431768211455));
+}
@@ -0,0 +1,191 @@
+#include "int128_float.h"
+
+#include "check.h"
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+using large_int::int128_t;
+using large_int::uint128_t;
+
+namespace {
+    namespace dt = large_int::detail_;
+
+    const int128_t min128 = int128_t(uint128_t(1) << 127), max128 = ~min128;
+
+    template<class _Tp, class _Int>
+    struct kernel {
+        const char *name;
+        dt::float_batch_<_Tp, _Int> fns;
+    };
+
+    // every kernel, not only the one the dispatch settles on
+    template<class _Tp, class _Int>
+    std::vector<kernel<_Tp, _Int> > kernels() {
+        std::vector<kernel<_Tp, _Int> > kernels_;
+        kernels_.push_back({"scalar", {dt::to_float_scalar_<_Tp, _Int>, dt::from_float_scalar_<_Tp, _Int>}});
+#ifdef INT128_FLOAT_X86
+        if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq") &&
+            __builtin_cpu_supports("avx512cd")) {
+            kernels_.push_back({"avx512", {dt::to_float_avx512_<_Tp, _Int>, dt::from_float_avx512_<_Tp, _Int>}});
+        }
+#endif
+        return kernels_;
+    }
+
+    template<class _Tp>
+    bool same_bits(_Tp lhs_, _Tp rhs_) { return std::memcmp(&lhs_, &rhs_, sizeof(_Tp)) == 0; }
+
+    // the ends of the range, the limb edges and the rounding ties of float and double, sticky bits below them
+    template<class _Int>
+    std::vector<_Int> int_values(std::mt19937_64 &rng_) {
+        std::vector<_Int> values_ = {_Int(0), _Int(1), _Int(-1), _Int(min128), _Int(max128), _Int(~uint128_t(0) >> 11),
+                                     _Int(uint128_t(1) << 64), _Int((uint128_t(1) << 64) - 1)};
+        for (int shift_ : {0, 11, 40, 64, 70, 74, 103}) {
+            for (int mant_ : {24, 53}) {
+                auto tie_ = (uint128_t(1) << mant_ | 1) << shift_;
+                values_.push_back(_Int(tie_));
+                values_.push_back(_Int(tie_ + uint128_t(1)));
+                values_.push_back(_Int(tie_ - uint128_t(1)));
+                values_.push_back(_Int(tie_ + (uint128_t(1) << shift_ << 1)));
+                values_.push_back(_Int(-tie_));
+            }
+        }
+        for (int i_ = 0; i_ < 200; ++i_) values_.push_back(_Int(int128_test::random128(rng_)));
+        return values_;
+    }
+
+    // NaN, the infinities, 2^127 and 2^128 from both sides, fractions that truncate to 0 or -1, every exponent
+    template<class _Tp>
+    std::vector<_Tp> float_values(std::mt19937_64 &rng_) {
+        const _Tp inf_ = std::numeric_limits<_Tp>::infinity();
+        std::vector<_Tp> values_ = {std::numeric_limits<_Tp>::quiet_NaN(), -std::numeric_limits<_Tp>::quiet_NaN(),
+                                    inf_, -inf_, _Tp(0), -_Tp(0), _Tp(0.5), _Tp(-0.5), _Tp(-1), _Tp(-1.5),
+                                    std::numeric_limits<_Tp>::max(), std::numeric_limits<_Tp>::lowest(),
+                                    std::numeric_limits<_Tp>::denorm_min(), -std::numeric_limits<_Tp>::denorm_min()};
+        for (int exp_ : {63, 64, 127, 128}) {
+            for (_Tp sign_ : {_Tp(1), _Tp(-1)}) {
+                auto edge_ = std::ldexp(sign_, exp_);
+                values_.push_back(edge_);
+                values_.push_back(std::nextafter(edge_, _Tp(0)));
+                values_.push_back(std::nextafter(edge_, edge_ * 2));
+            }
+        }
+        std::uniform_real_distribution<_Tp> mant_(_Tp(-1), _Tp(1));
+        for (int i_ = 0; i_ < 200; ++i_) values_.push_back(std::ldexp(mant_(rng_), static_cast<int>(rng_() % 140)));
+        return values_;
+    }
+
+    // count_ values from values_, starting at a different one each round so every value lands in every lane
+    template<class _Tp>
+    std::vector<_Tp> window(const std::vector<_Tp> &values_, std::size_t start_, std::size_t count_) {
+        std::vector<_Tp> res_(count_);
+        for (std::size_t i_ = 0; i_ < count_; ++i_) res_[i_] = values_[(start_ + i_) % values_.size()];
+        return res_;
+    }
+
+    template<class _Tp, class _Int>
+    void check_to(std::mt19937_64 &rng_) {
+        auto values_ = int_values<_Int>(rng_);
+        for (auto &k_ : kernels<_Tp, _Int>()) {
+            for (std::size_t count_ = 0; count_ <= 17; ++count_) {
+                for (std::size_t start_ = 0; start_ < values_.size(); start_ += 5) {
+                    auto in_ = window(values_, start_, count_);
+                    std::vector<_Tp> out_(count_ + 1, _Tp(42));
+                    k_.fns.to(out_.data(), in_.data(), count_);
+                    for (std::size_t i_ = 0; i_ < count_; ++i_) CHECK(same_bits(out_[i_], static_cast<_Tp>(in_[i_])));
+                    CHECK(out_[count_] == _Tp(42));
+                }
+            }
+        }
+    }
+
+    template<class _Tp, class _Int>
+    void check_from(std::mt19937_64 &rng_) {
+        auto values_ = float_values<_Tp>(rng_);
+        for (auto &k_ : kernels<_Tp, _Int>()) {
+            for (std::size_t count_ = 0; count_ <= 17; ++count_) {
+                for (std::size_t start_ = 0; start_ < values_.size(); start_ += 3) {
+                    auto in_ = window(values_, start_, count_);
+                    std::vector<_Int> out_(count_ + 1, _Int(42));
+                    auto bad_ = k_.fns.from(out_.data(), in_.data(), count_);
+                    std::size_t want_bad_ = 0;
+                    for (std::size_t i_ = 0; i_ < count_; ++i_) {
+                        _Int want_;
+                        want_bad_ += large_int::cast_overflow(in_[i_], want_);
+                        CHECK(out_[i_] == want_);
+                    }
+                    CHECK(bad_ == want_bad_);
+                    CHECK(out_[count_] == _Int(42));
+                }
+            }
+        }
+    }
+}
+
+// each kernel against the cast, lengths 0..17 so every tail after a full step of 8 is covered
+TEST_CASE(float_to_kernels) {
+    std::mt19937_64 rng_(17);
+    check_to<double, uint128_t>(rng_);
+    check_to<double, int128_t>(rng_);
+    check_to<float, uint128_t>(rng_);
+    check_to<float, int128_t>(rng_);
+}
+
+// each kernel against cast_overflow, the saturated values and the count of NaN or out of range inputs
+TEST_CASE(float_from_kernels) {
+    std::mt19937_64 rng_(18);
+    check_from<double, uint128_t>(rng_);
+    check_from<double, int128_t>(rng_);
+    check_from<float, uint128_t>(rng_);
+    check_from<float, int128_t>(rng_);
+}
+
+// the dispatched entry points, and values whose casts are known without the scalar path
+TEST_CASE(float_api) {
+    const uint128_t u_[] = {uint128_t(0), uint128_t(1) << 127, ~uint128_t(0), (uint128_t(1) << 53 | 1) << 11,
+                            uint128_t(1), uint128_t(3) << 100, uint128_t(1) << 64, uint128_t(12345)};
+    double d_[8];
+    float f_[8];
+    large_int::to_float_batch(d_, u_, 8);
+    large_int::to_float_batch(f_, u_, 8);
+    CHECK(d_[0] == 0.0);
+    CHECK(d_[1] == std::ldexp(1.0, 127));
+    CHECK(d_[2] == std::ldexp(1.0, 128));
+    CHECK(d_[3] == std::ldexp(1.0, 64)); // the tie rounds to the even mantissa
+    CHECK(d_[5] == std::ldexp(3.0, 100));
+    CHECK(f_[2] == std::numeric_limits<float>::infinity());
+    CHECK(f_[7] == 12345.0f);
+
+    const int128_t s_[] = {min128, int128_t(-1), int128_t(-3) << 100, int128_t(0),
+                           max128, int128_t(7), int128_t(-7), int128_t(1) << 64};
+    large_int::to_float_batch(d_, s_, 8);
+    CHECK(d_[0] == -std::ldexp(1.0, 127));
+    CHECK(d_[1] == -1.0);
+    CHECK(d_[2] == -std::ldexp(3.0, 100));
+    CHECK(d_[4] == std::ldexp(1.0, 127));
+    CHECK(d_[6] == -7.0);
+
+    const double in_[] = {std::nan(""), -std::numeric_limits<double>::infinity(), std::ldexp(1.0, 127),
+                          -std::ldexp(1.0, 127), -0.5, 2.5, std::ldexp(1.0, 126), -std::ldexp(1.0, 128)};
+    int128_t out_[8];
+    CHECK(large_int::from_float_batch(out_, in_, 8) == 4);
+    CHECK(out_[0] == int128_t(0));
+    CHECK(out_[1] == min128);
+    CHECK(out_[2] == max128);
+    CHECK(out_[3] == min128);
+    CHECK(out_[4] == int128_t(0));
+    CHECK(out_[5] == int128_t(2));
+    CHECK(out_[6] == int128_t(1) << 126);
+    CHECK(out_[7] == min128);
+
+    uint128_t uout_[8];
+    CHECK(large_int::from_float_batch(uout_, in_, 8) == 4);
+    CHECK(uout_[1] == uint128_t(0));
+    CHECK(uout_[2] == uint128_t(1) << 127);
+    CHECK(uout_[3] == uint128_t(0));
+    CHECK(uout_[4] == uint128_t(0));
+    CHECK(uout_[6] == uint128_t(1) << 126);
+}
@@ -0,0 +1,245 @@
+#include "int128.h"
+
+#include "check.h"
+
+#include <iomanip>
+#include <locale>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using large_int::int128_t;
+using large_int::uint128_t;
+
+namespace {
+    const int128_t min128 = int128_t(uint128_t(1) << 127);
+
+    // a digit at a time by plain division, lower case
+    std::string reference_digits(uint128_t value_, int base_) {
+        std::string res_;
+        do {
+            res_.insert(res_.begin(), large_int::detail_::lower_digits_()[static_cast<unsigned>(value_ % uint128_t(base_))]);
+            value_ /= uint128_t(base_);
+        } while (value_);
+        return res_;
+    }
+
+    std::string reference_digits(int128_t value_, int base_) {
+        return value_ < int128_t(0) ? "-" + reference_digits(-uint128_t(value_), base_)
+                                    : reference_digits(uint128_t(value_), base_);
+    }
+
+    template<class _Tp>
+    std::string chars(_Tp value_, int base_) {
+        char buf_[130];
+        auto res_ = large_int::to_chars(buf_, buf_ + sizeof(buf_), value_, base_);
+        return res_.ec == std::errc() ? std::string(buf_, res_.ptr) : "error";
+    }
+
+    struct grouping : std::numpunct<char> {
+        std::string group_;
+
+        explicit grouping(std::string group_arg_) : group_(std::move(group_arg_)) {}
+
+        char do_thousands_sep() const override { return '\''; }
+
+        std::string do_grouping() const override { return group_; }
+    };
+
+    template<class _Tp>
+    std::string put(const std::locale &loc_, std::ios::fmtflags flags_, std::streamsize width_, char fill_, _Tp val_) {
+        std::ostringstream os_;
+        os_.imbue(loc_);
+        os_.flags(flags_);
+        os_ << std::setw(static_cast<int>(width_)) << std::setfill(fill_) << val_;
+        return os_.str();
+    }
+}
+
+// every base against a digit at a time, values of every width, negative ones with their sign
+TEST_CASE(format_to_chars) {
+    std::mt19937_64 rng_(4);
+    for (int i_ = 0; i_ < 3000; ++i_) {
+        auto val_ = int128_test::random128(rng_);
+        for (int base_ = 2; base_ <= 36; ++base_) {
+            CHECK(chars(val_, base_) == reference_digits(val_, base_));
+            CHECK(chars(int128_t(val_), base_) == reference_digits(int128_t(val_), base_));
+        }
+        CHECK(large_int::to_string(val_) == reference_digits(val_, 10));
+        CHECK(large_int::to_string(int128_t(val_), 16) == reference_digits(int128_t(val_), 16));
+        char buf_[40];
+        CHECK(large_int::to_chars_constexpr(buf_, buf_ + sizeof(buf_), int128_t(val_)).ptr - buf_ ==
+              static_cast<std::ptrdiff_t>(reference_digits(int128_t(val_), 10).size()));
+    }
+#ifdef INT128_TEST_BUILTIN
+    for (int i_ = 0; i_ < 3000; ++i_) {
+        auto val_ = int128_test::random128(rng_);
+        auto native_ = int128_test::to_builtin(val_);
+        std::string want_;
+        do want_.insert(want_.begin(), static_cast<char>('0' + static_cast<int>(native_ % 10))); while (native_ /= 10);
+        CHECK(large_int::to_string(val_) == want_);
+    }
+#endif
+    CHECK(large_int::to_string(uint128_t(0), 2) == "0" && large_int::to_string(int128_t(0)) == "0");
+    CHECK(large_int::to_string(~uint128_t(0)) == "340282366920938463463374607431768211455");
+    CHECK(large_int::to_string(min128) == "-170141183460469231731687303715884105728");
+    CHECK(large_int::to_string(min128, 16) == "-80000000000000000000000000000000");
+    CHECK(large_int::to_string(~uint128_t(0), 3) ==
+          "202201102121002021012000211012011021221022212021111001022110211020010021100121010"); // 81 digits
+}
+
+// a buffer one short of the digits is value_too_large and last_, the exact size is enough
+TEST_CASE(format_short_buffer) {
+    char buf_[130];
+    for (int base_ : {2, 3, 8, 10, 16, 36}) {
+        for (auto val_ : {min128, int128_t(-1), int128_t(0), int128_t(~uint128_t(0) >> 1)}) {
+            auto len_ = static_cast<std::ptrdiff_t>(reference_digits(val_, base_).size());
+            auto res_ = large_int::to_chars(buf_, buf_ + len_ - 1, val_, base_);
+            CHECK(res_.ec == std::errc::value_too_large && res_.ptr == buf_ + len_ - 1);
+            res_ = large_int::to_chars(buf_, buf_ + len_, val_, base_);
+            CHECK(res_.ec == std::errc() && res_.ptr == buf_ + len_);
+            res_ = large_int::to_chars_constexpr(buf_, buf_ + len_ - 1, val_, base_);
+            CHECK(res_.ec == std::errc::value_too_large && res_.ptr == buf_ + len_ - 1);
+        }
+        auto ulen_ = static_cast<std::ptrdiff_t>(reference_digits(~uint128_t(0), base_).size());
+        auto res_ = large_int::to_chars(buf_, buf_ + ulen_ - 1, ~uint128_t(0), base_);
+        CHECK(res_.ec == std::errc::value_too_large && res_.ptr == buf_ + ulen_ - 1);
+    }
+    auto res_ = large_int::to_chars(buf_, buf_ + 39, min128);
+    CHECK(res_.ec == std::errc::value_too_large && res_.ptr == buf_ + 39);
+    res_ = large_int::to_chars(buf_, buf_ + 40, min128);
+    CHECK(res_.ec == std::errc() && std::string(buf_, res_.ptr) == "-170141183460469231731687303715884105728");
+}
+
+// operator<< against the stream's own 64-bit output for every combination of base, showbase, showpos, uppercase,
+// adjustment, width, fill and grouping
+TEST_CASE(format_stream_flags) {
+    const std::locale locales_[] = {std::locale::classic(), std::locale(std::locale::classic(), new grouping("\3")),
+                                    std::locale(std::locale::classic(), new grouping("\1\2"))};
+    const std::ios::fmtflags bases_[] = {std::ios::dec, std::ios::hex, std::ios::oct, std::ios::fmtflags(0)};
+    const std::ios::fmtflags adjusts_[] = {std::ios::fmtflags(0), std::ios::left, std::ios::right, std::ios::internal};
+    const uint64_t uvals_[] = {0, 1, 8, 255, 1234567, UINT64_C(0xdeadbeefcafe), ~UINT64_C(0)};
+    const int64_t svals_[] = {0, 1, -1, 255, -1234567, INT64_C(0x7fffffffffffffff), -INT64_C(0x7fffffffffffffff) - 1};
+    int mismatches_ = 0;
+    for (auto &loc_ : locales_) {
+        bool grouped_ = &loc_ != locales_;
+        for (auto base_ : bases_) {
+            for (unsigned extra_ = 0; extra_ < 8; ++extra_) {
+                auto flags_ = base_ | (extra_ & 1 ? std::ios::showbase : std::ios::fmtflags(0)) |
+                              (extra_ & 2 ? std::ios::showpos : std::ios::fmtflags(0)) |
+                              (extra_ & 4 ? std::ios::uppercase : std::ios::fmtflags(0));
+                for (auto adjust_ : adjusts_) {
+                    for (std::streamsize width_ : {0, 5, 30}) {
+                        for (char fill_ : {' ', '*'}) {
+                            for (auto v_ : uvals_) {
+                                if (grouped_ && base_ == std::ios::oct && (extra_ & 1)) continue;
+                                mismatches_ += put(loc_, flags_ | adjust_, width_, fill_, uint128_t(v_)) !=
+                                               put(loc_, flags_ | adjust_, width_, fill_, v_);
+                            }
+                            for (auto v_ : svals_) {
+                                if (v_ < 0 && base_ != std::ios::dec && base_ != std::ios::fmtflags(0)) continue;
+                                if (grouped_ && base_ == std::ios::oct && (extra_ & 1)) continue;
+                                mismatches_ += put(loc_, flags_ | adjust_, width_, fill_, int128_t(v_)) !=
+                                               put(loc_, flags_ | adjust_, width_, fill_, v_);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+    CHECK(mismatches_ == 0);
+    // the one difference, kept from the snprintf version: the 0 of showbase in octal is grouped with the digits
+    CHECK(put(locales_[1], std::ios::oct | std::ios::showbase, 0, ' ', uint128_t(255)) == "0'377");
+    CHECK(put(locales_[1], std::ios::oct | std::ios::showbase, 0, ' ', uint64_t(255)) == "0377");
+
+    // past 64 bits, where the stream has no reference
+    auto group3_ = locales_[1];
+    auto classic_ = std::locale::classic();
+    CHECK(put(group3_, std::ios::dec, 0, ' ', ~uint128_t(0)) ==
+          "340'282'366'920'938'463'463'374'607'431'768'211'455");
+    CHECK(put(group3_, std::ios::dec | std::ios::internal, 55, '*', min128) ==
+          "-***170'141'183'460'469'231'731'687'303'715'884'105'728");
+    CHECK(put(classic_, std::ios::dec | std::ios::internal, 45, '*', min128) ==
+          "-*****170141183460469231731687303715884105728");
+    CHECK(put(classic_, std::ios::hex | std::ios::showbase | std::ios::uppercase | std::ios::internal, 36, '0',
+              ~uint128_t(0)) == "0X00FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF");
+    CHECK(put(classic_, std::ios::hex | std::ios::showbase | std::ios::internal, 40, '0', uint128_t(1) << 100) ==
+          "0x0000000000001" + std::string(25, '0'));
+    CHECK(put(classic_, std::ios::oct | std::ios::showbase, 0, ' ', ~uint128_t(0)) ==
+          "03777777777777777777777777777777777777777777");
+    CHECK(put(classic_, std::ios::dec | std::ios::showpos | std::ios::left, 42, '.', int128_t(~uint128_t(0) >> 1)) ==
+          "+170141183460469231731687303715884105727..");
+    CHECK(put(classic_, std::ios::hex, 0, ' ', int128_t(-1)) == std::string(32, 'f'));
+
+    std::wostringstream wos_;
+    wos_ << std::showpos << int128_t(42) << L' ' << std::hex << std::showbase << uint128_t(255);
+    CHECK(wos_.str() == L"+42 0xff");
+}
+
+// the digit count at each power of ten and either side of it, where the table lookup changes its answer
+TEST_CASE(format_to_chars_size) {
+    CHECK(large_int::to_chars_size(uint128_t(0)) == 1 && large_int::to_chars_size(int128_t(0)) == 1);
+    uint128_t pow_(1);
+    for (int exp_ = 0; exp_ <= 38; ++exp_, pow_ *= uint128_t(10)) {
+        CHECK(large_int::to_chars_size(pow_) == exp_ + 1);
+        CHECK(large_int::to_chars_size(pow_ - uint128_t(1)) == (exp_ ? exp_ : 1));
+        CHECK(large_int::to_chars_size(pow_ + uint128_t(1)) == exp_ + 1);
+        CHECK(large_int::to_chars_size(-int128_t(pow_)) == exp_ + 2);
+        CHECK(large_int::to_chars_size(int128_t(pow_) - int128_t(1)) == (exp_ ? exp_ : 1));
+        CHECK(static_cast<std::size_t>(large_int::to_chars_size(pow_ - uint128_t(1))) ==
+              large_int::to_string(pow_ - uint128_t(1)).size());
+    }
+    CHECK(large_int::to_chars_size(~uint128_t(0)) == 39 && large_int::to_chars_size(min128) == 40);
+    std::mt19937_64 rng_(5);
+    for (int i_ = 0; i_ < 5000; ++i_) {
+        auto val_ = int128_test::random128(rng_);
+        CHECK(static_cast<std::size_t>(large_int::to_chars_size(val_)) == large_int::to_string(val_).size());
+        CHECK(static_cast<std::size_t>(large_int::to_chars_size(int128_t(val_))) ==
+              large_int::to_string(int128_t(val_)).size());
+    }
+}
+
+// values around 10^19 and 10^38 where the chunks are zero padded, joined by the delimiter; a buffer short at a digit
+// or at a delimiter is value_too_large and last_
+TEST_CASE(format_batch) {
+    const uint64_t ten19_ = UINT64_C(10000000000000000000);
+    const uint128_t vals_[] = {uint128_t(0), uint128_t(9), uint128_t(10), uint128_t(99), uint128_t(100),
+                               uint128_t(ten19_ - 1), uint128_t(ten19_), uint128_t(ten19_) + uint128_t(1),
+                               uint128_t(ten19_) * uint128_t(ten19_), uint128_t(ten19_) * uint128_t(ten19_) - uint128_t(1),
+                               uint128_t(ten19_) * uint128_t(ten19_) + uint128_t(7), ~uint128_t(0)};
+    std::string want_;
+    for (auto v_ : vals_) {
+        CHECK(large_int::to_string(v_) == reference_digits(v_, 10));
+        want_ += (want_.empty() ? "" : ";") + reference_digits(v_, 10);
+    }
+    const std::size_t count_ = sizeof(vals_) / sizeof(vals_[0]);
+    char buf_[40 * count_ + count_];
+    auto res_ = large_int::to_chars_batch(buf_, buf_ + sizeof(buf_), vals_, count_, ';');
+    CHECK(res_.ec == std::errc() && std::string(buf_, res_.ptr) == want_);
+    // one short fails, at the last digit or at the last delimiter
+    res_ = large_int::to_chars_batch(buf_, buf_ + want_.size() - 1, vals_, count_, ';');
+    CHECK(res_.ec == std::errc::value_too_large && res_.ptr == buf_ + want_.size() - 1);
+    auto before_last_ = want_.size() - reference_digits(vals_[count_ - 1], 10).size() - 1;
+    res_ = large_int::to_chars_batch(buf_, buf_ + before_last_, vals_, count_, ';');
+    CHECK(res_.ec == std::errc::value_too_large && res_.ptr == buf_ + before_last_);
+    res_ = large_int::to_chars_batch(buf_, buf_, vals_, 0);
+    CHECK(res_.ec == std::errc() && res_.ptr == buf_);
+
+    // 41 characters per signed value and delimiter are enough for INT128_MIN each time
+    const int128_t mins_[] = {min128, min128, min128};
+    char sbuf_[41 * 3];
+    auto sres_ = large_int::to_chars_batch(sbuf_, sbuf_ + sizeof(sbuf_), mins_, 3);
+    CHECK(sres_.ec == std::errc() && sres_.ptr == sbuf_ + 3 * 40 + 2);
+    CHECK(std::string(sbuf_, sbuf_ + 41) == "-170141183460469231731687303715884105728,");
+    std::mt19937_64 rng_(6);
+    std::vector<int128_t> rand_(100);
+    std::string rwant_;
+    for (auto &v_ : rand_) {
+        v_ = int128_t(int128_test::random128(rng_));
+        rwant_ += (rwant_.empty() ? "" : " ") + reference_digits(v_, 10);
+    }
+    std::vector<char> rbuf_(41 * rand_.size());
+    sres_ = large_int::to_chars_batch(rbuf_.data(), rbuf_.data() + rbuf_.size(), rand_.data(), rand_.size(), ' ');
+    CHECK(sres_.ec == std::errc() && std::string(rbuf_.data(), sres_.ptr) == rwant_);
+}
@@ -0,0 +1,161 @@
+#include "wide_int.h"
+
+#include "check.h"
+
+#include <vector>
+
+using large_int::int128_t;
+using large_int::uint128_t;
+using large_int::uint256_t;
+
+namespace {
+    const int128_t min128 = int128_t(uint128_t(1) << 127);
+    const int128_t max128 = int128_t(~uint128_t(0) >> 1);
+
+    uint128_t reference_gcd(uint128_t lhs_, uint128_t rhs_) {
+        while (rhs_) {
+            auto rem_ = lhs_ % rhs_;
+            lhs_ = rhs_;
+            rhs_ = rem_;
+        }
+        return lhs_;
+    }
+
+    uint128_t magnitude(int128_t val_) { return val_ < int128_t(0) ? -uint128_t(val_) : uint128_t(val_); }
+
+    // random of every width, half of them pairs sharing a random factor
+    std::vector<uint128_t> gcd_operands(std::mt19937_64 &rng_) {
+        std::vector<uint128_t> res_ = {uint128_t(0), uint128_t(1), uint128_t(2), ~uint128_t(0),
+                                       uint128_t(1) << 127, uint128_t(1) << 64, uint128_t(~UINT64_C(0)),
+                                       (uint128_t(1) << 64) + uint128_t(1)};
+        for (int i_ = 0; i_ < 4000; ++i_) {
+            auto val_ = int128_test::random128(rng_) >> (rng_() % 128);
+            if (i_ & 1) {
+                auto factor_ = int128_test::random128(rng_) >> (64 + rng_() % 64);
+                val_ = (val_ >> (rng_() % 128 < 64 ? 0 : 64)) * factor_;
+                res_.back() *= factor_;
+            }
+            res_.push_back(val_);
+        }
+        return res_;
+    }
+
+    // the identity wraps, and Euclid's coefficients stay within half the other operand over the gcd unless one
+    // operand is 0 or a multiple of the other
+    void check_extended(uint128_t lhs_, uint128_t rhs_) {
+        auto res_ = large_int::extended_gcd(lhs_, rhs_);
+        CHECK(res_.gcd == reference_gcd(lhs_, rhs_));
+        CHECK(lhs_ * uint128_t(res_.x) + rhs_ * uint128_t(res_.y) == res_.gcd);
+        if (lhs_ && rhs_ && res_.gcd != lhs_ && res_.gcd != rhs_) {
+            CHECK(magnitude(res_.x) <= rhs_ / res_.gcd / uint128_t(2));
+            CHECK(magnitude(res_.y) <= lhs_ / res_.gcd / uint128_t(2));
+        }
+    }
+
+    // the lcm in 256 bits, over once it passes 128
+    bool reference_lcm(uint128_t lhs_, uint128_t rhs_, uint256_t &res_) {
+        res_ = !lhs_ || !rhs_ ? uint256_t(0) : uint256_t(lhs_ / reference_gcd(lhs_, rhs_)) * uint256_t(rhs_);
+        return !!(res_ >> 128);
+    }
+}
+
+// binary gcd and the extended one against Euclid, both signs, with the zero operands and INT128_MIN
+TEST_CASE(gcd_euclid) {
+    std::mt19937_64 rng_(26);
+    auto values_ = gcd_operands(rng_);
+    for (std::size_t i_ = 0; i_ + 1 < values_.size(); ++i_) {
+        auto lhs_ = values_[i_], rhs_ = values_[i_ + 1];
+        auto want_ = reference_gcd(lhs_, rhs_);
+        CHECK(large_int::gcd(lhs_, rhs_) == want_ && large_int::gcd(rhs_, lhs_) == want_);
+        check_extended(lhs_, rhs_);
+        check_extended(rhs_, lhs_);
+
+        auto slhs_ = int128_t(lhs_), srhs_ = (i_ & 1) ? -int128_t(rhs_) : int128_t(rhs_);
+        CHECK(large_int::gcd(slhs_, srhs_) == int128_t(reference_gcd(magnitude(slhs_), magnitude(srhs_))));
+        auto sres_ = large_int::extended_gcd(slhs_, srhs_);
+        CHECK(sres_.gcd == uint128_t(large_int::gcd(slhs_, srhs_)));
+        CHECK(uint128_t(slhs_) * uint128_t(sres_.x) + uint128_t(srhs_) * uint128_t(sres_.y) == sres_.gcd);
+    }
+    CHECK(large_int::gcd(uint128_t(0), uint128_t(0)) == uint128_t(0));
+    CHECK(large_int::gcd(~uint128_t(0), uint128_t(0)) == ~uint128_t(0));
+    CHECK(large_int::gcd(uint128_t(0), uint128_t(12)) == uint128_t(12));
+    CHECK(large_int::gcd(int128_t(-12), int128_t(0)) == int128_t(12));
+    CHECK(large_int::gcd(int128_t(-12), int128_t(-18)) == int128_t(6));
+    auto zero_ = large_int::extended_gcd(uint128_t(0), uint128_t(0));
+    CHECK(zero_.gcd == uint128_t(0) && zero_.x == int128_t(1) && zero_.y == int128_t(0));
+    auto left_ = large_int::extended_gcd(int128_t(0), int128_t(-5));
+    CHECK(left_.gcd == uint128_t(5) && left_.x == int128_t(0) && left_.y == int128_t(-1));
+
+    // 2^127 wraps back to INT128_MIN
+    CHECK(large_int::gcd(min128, int128_t(0)) == min128 && large_int::gcd(min128, min128) == min128);
+    CHECK(large_int::gcd(min128, int128_t(-6)) == int128_t(2) && large_int::gcd(min128, max128) == int128_t(1));
+    auto min_ = large_int::extended_gcd(min128, int128_t(0));
+    CHECK(min_.gcd == uint128_t(1) << 127 && min_.x == int128_t(-1) && min_.y == int128_t(0));
+    min_ = large_int::extended_gcd(min128, int128_t(3));
+    CHECK(min_.gcd == uint128_t(1));
+    CHECK(uint128_t(min128) * uint128_t(min_.x) + uint128_t(3) * uint128_t(min_.y) == uint128_t(1));
+}
+
+// the inverse against a 256-bit product where there is one, 0 where there is not
+TEST_CASE(gcd_mod_inverse) {
+    std::mt19937_64 rng_(27);
+    auto values_ = gcd_operands(rng_);
+    for (std::size_t i_ = 0; i_ + 1 < values_.size(); ++i_) {
+        auto val_ = values_[i_], mod_ = values_[i_ + 1] | uint128_t(!values_[i_ + 1]);
+        auto inv_ = large_int::mod_inverse(val_, mod_);
+        if (mod_ == uint128_t(1) || reference_gcd(val_ % mod_, mod_) != uint128_t(1)) {
+            CHECK(inv_ == uint128_t(0));
+        } else {
+            CHECK(inv_ < mod_ && uint256_t(val_) * uint256_t(inv_) % uint256_t(mod_) == uint256_t(1));
+        }
+    }
+    CHECK(large_int::mod_inverse(uint128_t(3), uint128_t(7)) == uint128_t(5));
+    CHECK(large_int::mod_inverse(uint128_t(10), uint128_t(7)) == uint128_t(5));
+    CHECK(large_int::mod_inverse(uint128_t(6), uint128_t(9)) == uint128_t(0));
+    CHECK(large_int::mod_inverse(uint128_t(0), uint128_t(7)) == uint128_t(0));
+    CHECK(large_int::mod_inverse(uint128_t(14), uint128_t(7)) == uint128_t(0));
+    CHECK(large_int::mod_inverse(uint128_t(1), uint128_t(1)) == uint128_t(0));
+    CHECK(large_int::mod_inverse(uint128_t(5), uint128_t(1)) == uint128_t(0));
+    CHECK(large_int::mod_inverse(uint128_t(2), ~uint128_t(0)) == uint128_t(1) << 127);
+    CHECK(large_int::mod_inverse(~uint128_t(0), uint128_t(1) << 127) == (uint128_t(1) << 127) - uint128_t(1));
+    CHECK(large_int::mod_inverse(uint128_t(1) << 64, uint128_t(1) << 127) == uint128_t(0));
+}
+
+// lcm and lcm_overflow against 256 bits, then the products that just fit and the ones just past
+TEST_CASE(gcd_lcm) {
+    std::mt19937_64 rng_(28);
+    auto values_ = gcd_operands(rng_);
+    for (std::size_t i_ = 0; i_ + 1 < values_.size(); ++i_) {
+        auto lhs_ = values_[i_], rhs_ = values_[i_ + 1];
+        uint256_t want_;
+        bool over_ = reference_lcm(lhs_, rhs_, want_);
+        uint128_t res_;
+        CHECK(large_int::lcm_overflow(lhs_, rhs_, res_) == over_ && res_ == uint128_t(want_));
+        CHECK(large_int::lcm(lhs_, rhs_) == res_ && large_int::lcm(rhs_, lhs_) == res_);
+
+        auto slhs_ = -int128_t(lhs_), srhs_ = int128_t(rhs_);
+        over_ = reference_lcm(magnitude(slhs_), magnitude(srhs_), want_);
+        int128_t sres_;
+        CHECK(large_int::lcm_overflow(slhs_, srhs_, sres_) == (over_ || !!(want_ >> 127)));
+        CHECK(sres_ == int128_t(uint128_t(want_)) && large_int::lcm(slhs_, srhs_) == sres_);
+    }
+    const auto two64 = uint128_t(1) << 64;
+    uint128_t res_;
+    CHECK(!large_int::lcm_overflow(uint128_t(0), ~uint128_t(0), res_) && res_ == uint128_t(0));
+    CHECK(!large_int::lcm_overflow(two64 + uint128_t(1), two64 - uint128_t(1), res_) && res_ == ~uint128_t(0));
+    CHECK(large_int::lcm_overflow(two64 + uint128_t(1), two64 + uint128_t(3), res_));
+    CHECK(!large_int::lcm_overflow(two64, two64 - uint128_t(1), res_) && res_ == -two64);
+    CHECK(!large_int::lcm_overflow(uint128_t(1) << 127, uint128_t(2), res_) && res_ == uint128_t(1) << 127);
+    CHECK(large_int::lcm_overflow(uint128_t(1) << 127, uint128_t(3), res_) && res_ == uint128_t(1) << 127);
+    CHECK(!large_int::lcm_overflow(~uint128_t(0), uint128_t(5), res_) && res_ == ~uint128_t(0)); // 5 divides it
+
+    // 2^127 only fits as a wrapped INT128_MIN, not as an lcm
+    int128_t sres_;
+    CHECK(!large_int::lcm_overflow(max128, int128_t(-1), sres_) && sres_ == max128);
+    CHECK(large_int::lcm_overflow(max128, int128_t(2), sres_) && sres_ == int128_t(-2));
+    CHECK(!large_int::lcm_overflow(int128_t(1) << 126, int128_t(-2), sres_) && sres_ == int128_t(1) << 126);
+    CHECK(large_int::lcm_overflow(int128_t(1) << 126, int128_t(-3), sres_) && sres_ == -(int128_t(1) << 126));
+    CHECK(large_int::lcm_overflow(min128, int128_t(1), sres_) && sres_ == min128);
+    CHECK(!large_int::lcm_overflow(min128, int128_t(0), sres_) && sres_ == int128_t(0));
+    CHECK(large_int::lcm(min128, int128_t(3)) == min128 && large_int::lcm(int128_t(-4), int128_t(6)) == int128_t(12));
+}
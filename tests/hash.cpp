@@ -0,0 +1,51 @@
+#include "int128.h"
+
+#include "check.h"
+
+#include <functional>
+#include <unordered_set>
+
+using large_int::int128_t;
+using large_int::uint128_t;
+
+// keys that differ in one half only, or only in the high bits, still spread over all 64 bits; seeds give other hashes
+TEST_CASE(hash_spread) {
+    std::unordered_set<uint64_t> low_, high_, top_;
+    for (uint64_t i_ = 1; i_ <= 50000; ++i_) {
+        low_.insert(large_int::hash128(uint128_t(i_)));
+        high_.insert(large_int::hash128(uint128_t(i_) << 64));
+        top_.insert(large_int::hash128(uint128_t(i_) << 112));
+    }
+    CHECK(low_.size() == 50000 && high_.size() == 50000 && top_.size() == 50000);
+    std::size_t common_ = 0;
+    for (auto h_ : low_) common_ += high_.count(h_);
+    CHECK(common_ == 0);
+
+    std::mt19937_64 rng_(10);
+    for (int i_ = 0; i_ < 1000; ++i_) {
+        auto val_ = int128_test::random128(rng_);
+        CHECK(large_int::hash128(int128_t(val_)) == large_int::hash128(val_));
+        CHECK(large_int::hash128(val_, 1) != large_int::hash128(val_));
+    }
+    // a zero half in the first round must not drop the other one
+    CHECK(large_int::hash128(uint128_t(UINT64_C(0xe7037ed1a0b428db)) << 64) !=
+          large_int::hash128(uint128_t(UINT64_C(0xe7037ed1a0b428db)) << 64 | uint128_t(1)));
+}
+
+#ifdef INT128_SPECIALIZATION
+// std::hash is hash128 with no seed for either type, so unordered containers take the keys as they are
+TEST_CASE(hash_std) {
+    std::mt19937_64 rng_(11);
+    for (int i_ = 0; i_ < 1000; ++i_) {
+        auto val_ = int128_test::random128(rng_);
+        CHECK(std::hash<uint128_t>()(val_) == static_cast<std::size_t>(large_int::hash128(val_)));
+        CHECK(std::hash<int128_t>()(int128_t(val_)) == static_cast<std::size_t>(large_int::hash128(int128_t(val_))));
+    }
+    std::unordered_set<uint128_t> set_;
+    for (uint64_t i_ = 0; i_ < 1000; ++i_) set_.insert(uint128_t(i_) << 64 | uint128_t(i_));
+    CHECK(set_.size() == 1000 && set_.count(uint128_t(7) << 64 | uint128_t(7)) && !set_.count(uint128_t(7)));
+    CHECK(std::is_integral<const uint128_t>::value && std::is_signed<int128_t>::value);
+    CHECK(std::numeric_limits<int128_t>::max() == int128_t(~uint128_t(0) >> 1));
+    CHECK(std::numeric_limits<uint128_t>::max() == ~uint128_t(0) && std::numeric_limits<int128_t>::digits == 127);
+}
+#endif
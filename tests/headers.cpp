@@ -0,0 +1,20 @@
+// every header together, in each language mode and delegate the test targets build; the other tests include the
+// header they cover first, so each one compiles on its own too
+#include "int128.h"
+#include "int128_atomic.h"
+#include "int128_binary.h"
+#include "int128_column.h"
+#include "int128_decimal.h"
+#include "int128_float.h"
+#include "int128_hex.h"
+#include "int128_modular.h"
+#include "int128_reduce.h"
+#include "int128_sort.h"
+#include "wide_int.h"
+
+#include "check.h"
+
+TEST_CASE(headers) {
+    CHECK(sizeof(large_int::uint128_t) == 16 && sizeof(large_int::int128_t) == 16);
+    CHECK(sizeof(large_int::uint256_t) == 32);
+}
@@ -0,0 +1,122 @@
+#include "int128_hex.h"
+
+#include "check.h"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+using large_int::uint128_t;
+
+namespace {
+    namespace dt = large_int::detail_;
+
+    struct kernel {
+        const char *name;
+        dt::hex_encode_fn_ encode;
+        dt::hex_decode_fn_ decode;
+    };
+
+    // every kernel, not only the one the dispatch settles on
+    std::vector<kernel> kernels() {
+        std::vector<kernel> kernels_ = {{"scalar", dt::hex_encode_scalar_, dt::hex_decode_scalar_}};
+#ifdef INT128_HEX_X86
+        if (__builtin_cpu_supports("sse2")) kernels_.push_back({"sse2", dt::hex_encode_sse2_, dt::hex_decode_sse2_});
+        if (__builtin_cpu_supports("ssse3")) kernels_.push_back({"ssse3", dt::hex_encode_ssse3_, dt::hex_decode_ssse3_});
+        if (__builtin_cpu_supports("avx2")) kernels_.push_back({"avx2", dt::hex_encode_avx2_, dt::hex_decode_avx2_});
+#endif
+        return kernels_;
+    }
+
+    // 32 digits through to_chars, zero padded
+    std::string reference_hex(uint128_t value_, bool upper_) {
+        char buf_[32];
+        auto end_ = large_int::to_chars(buf_, buf_ + sizeof(buf_), value_, 16).ptr;
+        std::string res_(32 - static_cast<std::size_t>(end_ - buf_), '0');
+        res_.append(buf_, end_);
+        if (upper_) for (auto &c_ : res_) if (c_ >= 'a') c_ = static_cast<char>(c_ - 'a' + 'A');
+        return res_;
+    }
+
+    int nibble(unsigned char c_) {
+        if (c_ >= '0' && c_ <= '9') return c_ - '0';
+        if (c_ >= 'a' && c_ <= 'f') return c_ - 'a' + 10;
+        if (c_ >= 'A' && c_ <= 'F') return c_ - 'A' + 10;
+        return -1;
+    }
+}
+
+// batch counts around the 1 value per step of the kernels and the 2 of a 32-byte load, both cases
+TEST_CASE(hex_encode_kernels) {
+    std::mt19937_64 rng_(6);
+    for (auto &k_ : kernels()) {
+        for (std::size_t count_ : {0, 1, 2, 3, 5, 7, 16, 33}) {
+            for (bool upper_ : {false, true}) {
+                std::vector<uint128_t> values_(count_);
+                for (auto &v_ : values_) v_ = int128_test::random128(rng_);
+                std::vector<char> out_(32 * count_ + 32, '#');
+                k_.encode(out_.data(), values_.data(), count_, upper_);
+                for (std::size_t i_ = 0; i_ < count_; ++i_) {
+                    CHECK(std::string(out_.data() + 32 * i_, 32) == reference_hex(values_[i_], upper_));
+                }
+                CHECK(std::string(out_.data() + 32 * count_, 32) == std::string(32, '#'));
+            }
+        }
+    }
+}
+
+// each byte value at each digit position, the rest valid digits of mixed case
+TEST_CASE(hex_decode_kernels) {
+    std::mt19937_64 rng_(7);
+    static const char digits_[] = "0123456789abcdefABCDEF";
+    for (auto &k_ : kernels()) {
+        for (int pos_ = 0; pos_ < 32; ++pos_) {
+            for (int byte_ = 0; byte_ < 256; ++byte_) {
+                char in_[32];
+                for (auto &c_ : in_) c_ = digits_[rng_() % 22];
+                in_[pos_] = static_cast<char>(byte_);
+                uint128_t expect_(0);
+                bool valid_ = true;
+                for (auto c_ : in_) {
+                    auto n_ = nibble(static_cast<unsigned char>(c_));
+                    valid_ &= n_ >= 0;
+                    expect_ = expect_ << 4 | uint128_t(static_cast<uint64_t>(n_ & 15));
+                }
+                auto value_ = uint128_t(12345);
+                auto done_ = k_.decode(in_, &value_, 1);
+                CHECK(done_ == std::size_t(valid_));
+                CHECK(value_ == (valid_ ? expect_ : uint128_t(12345)));
+            }
+        }
+    }
+}
+
+// round trips of batches, a bad digit stops the batch at its value
+TEST_CASE(hex_decode_batch) {
+    std::mt19937_64 rng_(8);
+    for (auto &k_ : kernels()) {
+        for (std::size_t count_ : {0, 1, 2, 3, 5, 7, 16, 33}) {
+            std::vector<uint128_t> values_(count_), back_(count_);
+            for (auto &v_ : values_) v_ = int128_test::random128(rng_);
+            std::vector<char> text_(32 * count_);
+            dt::hex_encode_scalar_(text_.data(), values_.data(), count_, rng_() % 2 != 0);
+            CHECK(k_.decode(text_.data(), back_.data(), count_) == count_);
+            CHECK(back_ == values_);
+            if (!count_) continue;
+            auto bad_ = rng_() % count_;
+            text_[32 * bad_ + rng_() % 32] = 'g';
+            CHECK(k_.decode(text_.data(), back_.data(), count_) == bad_);
+        }
+    }
+}
+
+TEST_CASE(hex_api) {
+    char buf_[32];
+    auto value_ = uint128_t(UINT64_C(0x0123456789abcdef)) << 64 | uint128_t(UINT64_C(0xfedcba9876543210));
+    large_int::to_hex(buf_, value_, true);
+    CHECK(std::string(buf_, 32) == "0123456789ABCDEFFEDCBA9876543210");
+    uint128_t back_;
+    CHECK(large_int::from_hex(buf_, back_) && back_ == value_);
+    buf_[31] = 'x';
+    CHECK(!large_int::from_hex(buf_, back_) && back_ == value_);
+}
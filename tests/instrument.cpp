@@ -0,0 +1,122 @@
+#include "int128.h"
+
+#include "check.h"
+
+#include <sstream>
+#include <string>
+#include <thread>
+
+using large_int::instrument_op;
+using large_int::int128_t;
+using large_int::uint128_t;
+
+namespace {
+    uint64_t count(const large_int::instrument_stats &stats_, instrument_op op_) {
+        return stats_.count[static_cast<unsigned>(op_)];
+    }
+
+    bool all_zero(const large_int::instrument_stats &stats_) {
+        for (unsigned i_ = 0; i_ < large_int::instrument_stats::ops; ++i_) {
+            if (stats_.count[i_] || stats_.ticks[i_]) return false;
+            for (auto h_ : stats_.histogram[i_]) {
+                if (h_) return false;
+            }
+        }
+        return true;
+    }
+
+    // every call adds one to count and to one histogram bucket
+    bool histograms_match(const large_int::instrument_stats &stats_) {
+        for (unsigned i_ = 0; i_ < large_int::instrument_stats::ops; ++i_) {
+            uint64_t sum_ = 0;
+            for (auto h_ : stats_.histogram[i_]) sum_ += h_;
+            if (sum_ != stats_.count[i_] && sum_) return false;
+        }
+        return true;
+    }
+
+    // operands hidden from the optimizer, which could otherwise fold a division with no hook to time
+    template<class _Tp>
+    _Tp opaque(_Tp val_) {
+        static volatile uint64_t zero_ = 0;
+        return val_ + _Tp(zero_);
+    }
+}
+
+// each width class of /, % and divmod counted once per call, signed by the magnitudes; print_value and part_div once
+// per value printed
+TEST_CASE(instrument_classes) {
+    large_int::instrument_reset();
+    auto small_ = opaque(uint128_t(1000)), big_ = opaque(uint128_t(1) << 100), seven_ = opaque(uint128_t(7));
+    auto wide_ = opaque(uint128_t(1) << 70);
+    uint128_t sink_(0);
+    sink_ += small_ / seven_;   // div.64
+    sink_ += big_ / seven_;     // div.128/64
+    sink_ += big_ / seven_;
+    sink_ += small_ / wide_;    // div.below
+    sink_ += big_ / wide_;      // div.128/128
+    sink_ += big_ % seven_;     // mod.128/64
+    sink_ += small_ % wide_;    // mod.below
+    sink_ += large_int::divmod(big_, wide_).quot; // divmod.128/128
+    sink_ += uint128_t(-int128_t(big_) / -int128_t(seven_)); // div.128/64 again, by magnitude
+    sink_ += uint128_t(int128_t(-1000) % int128_t(seven_));  // mod.64
+    CHECK(sink_ != uint128_t(0));
+
+    std::ostringstream os_;
+    os_ << ~uint128_t(0);
+    os_ << std::hex << uint128_t(255);
+    CHECK(os_.str() == "340282366920938463463374607431768211455ff");
+
+    auto stats_ = large_int::instrument_thread_snapshot();
+    CHECK(count(stats_, instrument_op::div_64) == 1 && count(stats_, instrument_op::div_128_64) == 3);
+    CHECK(count(stats_, instrument_op::div_below) == 1 && count(stats_, instrument_op::div_128) == 1);
+    CHECK(count(stats_, instrument_op::mod_64) == 1 && count(stats_, instrument_op::mod_128_64) == 1);
+    CHECK(count(stats_, instrument_op::mod_below) == 1 && count(stats_, instrument_op::mod_128) == 0);
+    CHECK(count(stats_, instrument_op::divmod_128) == 1 && count(stats_, instrument_op::divmod_64) == 0);
+    CHECK(count(stats_, instrument_op::print_dec) == 1 && count(stats_, instrument_op::print_hex) == 1);
+    CHECK(count(stats_, instrument_op::part_div) == 1 && count(stats_, instrument_op::print_oct) == 0);
+    CHECK(count(stats_, instrument_op::put_plain) + count(stats_, instrument_op::put_grouped) == 2);
+    CHECK(histograms_match(stats_));
+
+    // the fallback's digit steps are counted, not timed, whichever delegate the build uses
+    uint128_t rem_;
+    large_int::detail_delegate<false>::divmod(big_, seven_, rem_);
+    stats_ = large_int::instrument_thread_snapshot();
+    CHECK(count(stats_, instrument_op::div_step) >= 1);
+    CHECK(stats_.ticks[static_cast<unsigned>(instrument_op::div_step)] == 0);
+    CHECK(count(stats_, instrument_op::div_128_64) == 3);
+
+    std::ostringstream dump_;
+    large_int::instrument_dump(dump_, stats_);
+    CHECK(dump_.str().find("div.128/64 3 mean ") != std::string::npos);
+    CHECK(dump_.str().find("divmod.128/128 1 mean ") != std::string::npos);
+    CHECK(dump_.str().find("\nmod.128/128") == std::string::npos);
+    CHECK(std::string(large_int::instrument_name(instrument_op::div_quot_fix)) == "div.quot_fix");
+    CHECK(std::string(large_int::instrument_name(instrument_op::count_)).empty());
+}
+
+// what a thread counted stays in instrument_snapshot after it exits, and only there
+TEST_CASE(instrument_exited_thread) {
+    large_int::instrument_reset();
+    std::thread([] {
+        uint128_t sink_(0);
+        for (int i_ = 0; i_ < 10; ++i_) sink_ += opaque(uint128_t(1) << 120) / opaque(uint128_t(1) << 70);
+        CHECK(sink_ == uint128_t(10) << 50);
+        CHECK(count(large_int::instrument_thread_snapshot(), instrument_op::div_128) == 10);
+    }).join();
+    auto all_ = large_int::instrument_snapshot();
+    CHECK(count(all_, instrument_op::div_128) == 10 && histograms_match(all_));
+    CHECK(count(large_int::instrument_thread_snapshot(), instrument_op::div_128) == 0);
+
+    CHECK(opaque(uint128_t(1) << 120) / opaque(uint128_t(1) << 70) == uint128_t(1) << 50);
+    CHECK(count(large_int::instrument_snapshot(), instrument_op::div_128) == 11);
+}
+
+// reset clears the calling thread and what exited threads left
+TEST_CASE(instrument_reset) {
+    std::thread([] { CHECK(opaque(uint128_t(9)) / opaque(uint128_t(3)) == uint128_t(3)); }).join();
+    CHECK(opaque(uint128_t(9)) % opaque(uint128_t(3)) == uint128_t(0));
+    CHECK(!all_zero(large_int::instrument_snapshot()) && !all_zero(large_int::instrument_thread_snapshot()));
+    large_int::instrument_reset();
+    CHECK(all_zero(large_int::instrument_snapshot()) && all_zero(large_int::instrument_thread_snapshot()));
+}
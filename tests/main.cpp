@@ -0,0 +1,45 @@
+#include "check.h"
+
+#include <cstring>
+#include <vector>
+
+namespace int128_test {
+    namespace {
+        struct entry {
+            const char *name;
+            test_fn fn;
+        };
+
+        std::vector<entry> &tests() {
+            static std::vector<entry> tests_;
+            return tests_;
+        }
+
+        int failures = 0;
+    }
+
+    bool add(const char *name_, test_fn fn_) {
+        tests().push_back({name_, fn_});
+        return true;
+    }
+
+    void fail(const char *file_, int line_, const char *expr_) {
+        if (++failures <= 50) printf("%s:%d: CHECK(%s) failed\n", file_, line_, expr_);
+    }
+}
+
+int main(int argc, char *argv[]) {
+    int ran_ = 0;
+    for (auto &t_ : int128_test::tests()) {
+        if (argc > 1 && strcmp(argv[1], t_.name) != 0) continue;
+        auto before_ = int128_test::failures;
+        t_.fn();
+        printf("%-28s %s\n", t_.name, int128_test::failures == before_ ? "ok" : "FAILED");
+        ++ran_;
+    }
+    if (!ran_) {
+        printf("no test named %s\n", argc > 1 ? argv[1] : "");
+        return 1;
+    }
+    return int128_test::failures ? 1 : 0;
+}
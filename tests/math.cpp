@@ -0,0 +1,145 @@
+#include "int128.h"
+
+#include "check.h"
+
+#include <vector>
+
+using large_int::int128_t;
+using large_int::uint128_t;
+
+namespace {
+    const uint64_t cbrt_max = UINT64_C(6981463658331);
+
+    uint128_t square(uint64_t root_) { return uint128_t(root_) * uint128_t(root_); }
+
+    uint128_t cube(uint64_t root_) { return square(root_) * uint128_t(root_); }
+
+    // floor of the root by its defining inequality, (r + 1)^2 past 128 bits only for the largest r
+    bool is_isqrt(uint128_t value_, uint64_t root_) {
+        return square(root_) <= value_ && (root_ == ~UINT64_C(0) || square(root_ + 1) > value_);
+    }
+
+    bool is_icbrt(uint128_t value_, uint64_t root_) {
+        return root_ <= cbrt_max && cube(root_) <= value_ && (root_ == cbrt_max || cube(root_ + 1) > value_);
+    }
+
+    // both roots by both paths, which have to agree with each other too
+    void check_roots(uint128_t value_) {
+        auto sqrt_ = large_int::isqrt(value_), cbrt_ = large_int::icbrt(value_);
+        CHECK(is_isqrt(value_, sqrt_) && is_icbrt(value_, cbrt_));
+        CHECK(large_int::detail_::isqrt_newton_(value_) == sqrt_ && large_int::detail_::isqrt_float_(value_) == sqrt_);
+        CHECK(large_int::detail_::icbrt_newton_(value_) == cbrt_ && large_int::detail_::icbrt_float_(value_) == cbrt_);
+    }
+
+    // base_^exp_ one multiplication at a time, over once a product passes 128 bits
+    bool reference_pow(uint128_t base_, unsigned exp_, uint128_t &res_) {
+        bool over_ = false;
+        res_ = uint128_t(1);
+        for (unsigned i_ = 0; i_ < exp_; ++i_) {
+            over_ |= base_ && res_ > ~uint128_t(0) / base_;
+            res_ *= base_;
+        }
+        return over_;
+    }
+}
+
+// perfect squares and cubes, one either side, the largest roots, then random values of every width
+TEST_CASE(math_roots) {
+    std::mt19937_64 rng_(23);
+    for (uint64_t root_ : {UINT64_C(0), UINT64_C(1), UINT64_C(2), UINT64_C(3), UINT64_C(0xffffffff),
+                           UINT64_C(0x100000000), UINT64_C(94906265), UINT64_C(4294967296) + 1, ~UINT64_C(0) >> 1,
+                           UINT64_C(1) << 63, ~UINT64_C(0) - 1, ~UINT64_C(0)}) {
+        for (auto value_ : {square(root_) - uint128_t(1), square(root_), square(root_) + uint128_t(1)}) {
+            check_roots(value_);
+        }
+    }
+    for (int i_ = 0; i_ < 20000; ++i_) {
+        auto root_ = static_cast<uint64_t>(int128_test::random128(rng_));
+        for (auto value_ : {square(root_) - uint128_t(1), square(root_), square(root_) + uint128_t(1)}) {
+            check_roots(value_);
+        }
+        auto croot_ = root_ % (cbrt_max + 1);
+        for (auto value_ : {cube(croot_) - uint128_t(1), cube(croot_), cube(croot_) + uint128_t(1)}) {
+            check_roots(value_);
+        }
+        check_roots(int128_test::random128(rng_));
+    }
+    CHECK(large_int::isqrt(~uint128_t(0)) == ~UINT64_C(0) && large_int::isqrt(square(~UINT64_C(0))) == ~UINT64_C(0));
+    CHECK(large_int::isqrt(square(~UINT64_C(0)) - uint128_t(1)) == ~UINT64_C(0) - 1);
+    CHECK(large_int::icbrt(~uint128_t(0)) == cbrt_max && large_int::icbrt(cube(cbrt_max)) == cbrt_max);
+    CHECK(large_int::icbrt(cube(cbrt_max) + uint128_t(1)) == cbrt_max);
+    CHECK(large_int::icbrt(cube(cbrt_max) - uint128_t(1)) == cbrt_max - 1);
+    CHECK(large_int::detail_::icbrt_max_() == cbrt_max);
+    check_roots(~uint128_t(0));
+}
+
+// digit counts at each power of ten and either side, in every base against the printed length
+TEST_CASE(math_digits) {
+    CHECK(large_int::ilog10(uint128_t(0)) == -1 && large_int::num_digits(uint128_t(0)) == 1);
+    CHECK(large_int::ilog2(uint128_t(0)) == -1 && large_int::ilog2(~uint128_t(0)) == 127);
+    uint128_t pow_(1);
+    for (int exp_ = 0; exp_ <= 38; ++exp_, pow_ *= uint128_t(10)) {
+        CHECK(large_int::ilog10(pow_) == exp_ && large_int::ilog10(pow_ + uint128_t(1)) == exp_);
+        CHECK(large_int::ilog10(pow_ - uint128_t(1)) == exp_ - 1);
+        CHECK(large_int::num_digits(pow_) == exp_ + 1 && large_int::num_digits(pow_, 10) == exp_ + 1);
+    }
+    CHECK(large_int::ilog10(~uint128_t(0)) == 38);
+    std::mt19937_64 rng_(24);
+    std::vector<uint128_t> values_ = {uint128_t(0), uint128_t(1), ~uint128_t(0)};
+    for (int i_ = 0; i_ < 500; ++i_) values_.push_back(int128_test::random128(rng_));
+    for (auto value_ : values_) {
+        for (int base_ = 2; base_ <= 36; ++base_) {
+            CHECK(static_cast<std::size_t>(large_int::num_digits(value_, base_)) ==
+                  large_int::to_string(value_, base_).size());
+        }
+    }
+    // each power of the base and one below it, where the product per digit stops
+    for (int base_ = 2; base_ <= 36; ++base_) {
+        uint128_t pow_(base_);
+        for (int len_ = 1; ; ++len_, pow_ *= uint128_t(base_)) {
+            CHECK(large_int::num_digits(pow_ - uint128_t(1), base_) == len_);
+            CHECK(large_int::num_digits(pow_, base_) == len_ + 1);
+            if (pow_ > ~uint128_t(0) / uint128_t(base_)) break;
+        }
+    }
+}
+
+// powers that just fit and just do not, both signs; a square that overflows after the last bit of exp_ is no
+// overflow
+TEST_CASE(math_ipow) {
+    std::mt19937_64 rng_(25);
+    std::vector<uint128_t> bases_ = {uint128_t(0), uint128_t(1), uint128_t(2), uint128_t(3), uint128_t(10),
+                                     uint128_t(UINT64_C(0xffffffff)), uint128_t(1) << 63, uint128_t(1) << 64,
+                                     uint128_t(1) << 127, ~uint128_t(0)};
+    for (int i_ = 0; i_ < 40; ++i_) bases_.push_back(uint128_t(rng_() % 1000));
+    for (auto base_ : bases_) {
+        for (unsigned exp_ = 0; exp_ <= 130; ++exp_) {
+            uint128_t want_, res_;
+            bool over_ = reference_pow(base_, exp_, want_);
+            CHECK(large_int::ipow_overflow(base_, exp_, res_) == over_ && res_ == want_);
+            CHECK(large_int::ipow(base_, exp_) == want_);
+
+            // signed: the magnitude may reach 2^127 for an odd power of a negative base only
+            for (auto sbase_ : {int128_t(base_), -int128_t(base_)}) {
+                uint128_t mag_;
+                over_ = reference_pow(sbase_ < int128_t(0) ? -uint128_t(sbase_) : uint128_t(sbase_), exp_, mag_);
+                bool neg_ = sbase_ < int128_t(0) && (exp_ & 1U);
+                bool fits_ = !over_ && mag_ <= (uint128_t(1) << 127) - uint128_t(!neg_);
+                int128_t sres_;
+                CHECK(large_int::ipow_overflow(sbase_, exp_, sres_) == !fits_);
+                CHECK(sres_ == int128_t(neg_ ? -mag_ : mag_) && large_int::ipow(sbase_, exp_) == sres_);
+            }
+        }
+    }
+    const int128_t min128 = int128_t(uint128_t(1) << 127);
+    int128_t sres_;
+    CHECK(!large_int::ipow_overflow(int128_t(-2), 127, sres_) && sres_ == min128);
+    CHECK(large_int::ipow_overflow(int128_t(2), 127, sres_) && sres_ == min128);
+    CHECK(!large_int::ipow_overflow(int128_t(2), 126, sres_) && sres_ == int128_t(uint128_t(1) << 126));
+    CHECK(large_int::ipow_overflow(int128_t(-2), 128, sres_) && sres_ == int128_t(0));
+    uint128_t res_;
+    CHECK(!large_int::ipow_overflow(uint128_t(2), 127, res_) && res_ == uint128_t(1) << 127);
+    CHECK(large_int::ipow_overflow(uint128_t(2), 128, res_) && res_ == uint128_t(0));
+    CHECK(!large_int::ipow_overflow(uint128_t(1) << 64, 1, res_) && res_ == uint128_t(1) << 64);
+    CHECK(!large_int::ipow_overflow(uint128_t(10), 38, res_) && large_int::ipow_overflow(uint128_t(10), 39, res_));
+}
@@ -0,0 +1,145 @@
+#include "int128_modular.h"
+#include "wide_int.h"
+
+#include "check.h"
+
+#include <vector>
+
+using large_int::uint128_t;
+using large_int::uint256_t;
+
+namespace {
+    uint128_t make128(uint64_t high_, uint64_t low_) { return uint128_t(high_) << 64 | uint128_t(low_); }
+
+    uint128_t pow2(int exp_) { return uint128_t(1) << exp_; }
+
+    // the reference, 256-bit product and remainder
+    uint128_t mulmod_ref(uint128_t lhs_, uint128_t rhs_, uint128_t mod_) {
+        return uint128_t(uint256_t(lhs_) * uint256_t(rhs_) % uint256_t(mod_));
+    }
+
+    uint128_t powmod_ref(uint128_t base_, uint128_t exp_, uint128_t mod_) {
+        uint128_t res_ = uint128_t(1) % mod_;
+        base_ %= mod_;
+        for (; exp_; exp_ >>= 1) {
+            if (exp_ & uint128_t(1)) res_ = mulmod_ref(res_, base_, mod_);
+            base_ = mulmod_ref(base_, base_, mod_);
+        }
+        return res_;
+    }
+
+    // small, at the limb edge, near 2^128, powers of two, and random of every width
+    std::vector<uint128_t> moduli(std::mt19937_64 &rng_) {
+        std::vector<uint128_t> mods_ = {uint128_t(1), uint128_t(2), uint128_t(3), uint128_t(10), pow2(64) - uint128_t(1),
+                                        pow2(64), pow2(64) + uint128_t(1), pow2(127), pow2(127) + uint128_t(1),
+                                        -uint128_t(159), ~uint128_t(0), ~uint128_t(0) - uint128_t(1)};
+        for (int i_ = 0; i_ < 60; ++i_) {
+            auto mod_ = int128_test::random128(rng_);
+            if (mod_) mods_.push_back(mod_);
+        }
+        return mods_;
+    }
+}
+
+// Montgomery for odd moduli and Barrett for any against the 256-bit reference, operands below the modulus and
+// any, exponents of every width
+TEST_CASE(modular_contexts) {
+    std::mt19937_64 rng_(19);
+    for (auto mod_ : moduli(rng_)) {
+        large_int::barrett_context barrett_(mod_);
+        bool odd_ = !!(mod_ & uint128_t(1));
+        for (int i_ = 0; i_ < 100; ++i_) {
+            auto lhs_ = int128_test::random128(rng_), rhs_ = int128_test::random128(rng_);
+            auto exp_ = int128_test::random128(rng_) >> static_cast<int>(rng_() % 128);
+            auto want_mul_ = mulmod_ref(lhs_, rhs_, mod_), want_pow_ = powmod_ref(lhs_, exp_, mod_);
+            CHECK(large_int::mulmod(lhs_, rhs_, mod_) == want_mul_);
+            CHECK(large_int::powmod(lhs_, exp_, mod_) == want_pow_);
+            CHECK(barrett_.mulmod(lhs_, rhs_) == want_mul_);
+            CHECK(barrett_.powmod(lhs_, exp_) == want_pow_);
+            CHECK(barrett_.mul(lhs_ % mod_, rhs_ % mod_) == want_mul_);
+            auto high_ = rhs_ % mod_;
+            CHECK(barrett_.reduce(high_, lhs_) == uint128_t((uint256_t(high_) << 128 | uint256_t(lhs_)) %
+                                                            uint256_t(mod_)));
+            if (odd_) {
+                large_int::montgomery_context mont_(mod_);
+                CHECK(mont_.mulmod(lhs_, rhs_) == want_mul_);
+                CHECK(mont_.powmod(lhs_, exp_) == want_pow_);
+                auto a_ = mont_.to_form(lhs_), b_ = mont_.to_form(rhs_);
+                CHECK(mont_.from_form(mont_.mul(a_, b_)) == want_mul_);
+                CHECK(mont_.from_form(mont_.add(a_, b_)) ==
+                      uint128_t((uint256_t(lhs_ % mod_) + uint256_t(rhs_ % mod_)) % uint256_t(mod_)));
+                CHECK(mont_.from_form(mont_.sub(a_, b_)) ==
+                      uint128_t((uint256_t(lhs_ % mod_) + uint256_t(mod_ - rhs_ % mod_)) % uint256_t(mod_)));
+                CHECK(mont_.from_form(mont_.pow(a_, exp_)) == want_pow_);
+                CHECK(mont_.from_form(mont_.one()) == uint128_t(1) % mod_);
+            }
+        }
+    }
+}
+
+// every n below 2 * 10^5 against a sieve
+TEST_CASE(modular_is_prime_small) {
+    const std::size_t limit_ = 200000;
+    std::vector<bool> composite_(limit_);
+    composite_[0] = composite_[1] = true;
+    for (std::size_t p_ = 2; p_ * p_ < limit_; ++p_) {
+        if (composite_[p_]) continue;
+        for (auto m_ = p_ * p_; m_ < limit_; m_ += p_) composite_[m_] = true;
+    }
+    std::size_t wrong_ = 0;
+    for (std::size_t n_ = 0; n_ < limit_; ++n_) wrong_ += large_int::is_prime(uint128_t(n_)) == composite_[n_];
+    CHECK(wrong_ == 0);
+}
+
+// strong pseudoprimes to the first bases, squares and products of two primes near 2^64 and 2^41, on both sides
+// of 3.3 * 10^24 where Miller-Rabin hands over to Baillie-PSW
+TEST_CASE(modular_is_prime_hard) {
+    // psi_1, psi_2, psi_4, psi_9 and psi_12, the smallest strong pseudoprimes to the first 1, 2, 4, 9 and 12 prime
+    // bases, which the 13 bases of Miller-Rabin catch
+    CHECK(!large_int::is_prime(uint128_t(2047)));
+    CHECK(!large_int::is_prime(uint128_t(1373653)));
+    CHECK(!large_int::is_prime(uint128_t(3215031751ULL)));
+    CHECK(!large_int::is_prime(uint128_t(3825123056546413051ULL)));
+    CHECK(!large_int::is_prime(make128(17274, 16800704772356552677ULL))); // 318665857834031151167461
+    // 3317044064679887385961981, psi_13, passes all 13 bases and is the first n left to Baillie-PSW
+    auto psi13_ = make128(179817, 5885577656943027709ULL);
+    CHECK(!large_int::is_prime(psi13_));
+    // squares of Wieferich primes are strong pseudoprimes to base 2
+    CHECK(!large_int::is_prime(uint128_t(1093 * 1093)));
+    CHECK(!large_int::is_prime(uint128_t(3511 * 3511)));
+
+    const uint128_t below_[] = {pow2(64) - uint128_t(59), pow2(64) - uint128_t(83), pow2(64) - uint128_t(95)};
+    const uint128_t above_[] = {pow2(64) + uint128_t(13), pow2(64) + uint128_t(37)};
+    const uint128_t p41_[] = {pow2(41) + uint128_t(27), pow2(41) + uint128_t(65)};
+    for (auto p_ : below_) CHECK(large_int::is_prime(p_));
+    for (auto p_ : above_) CHECK(large_int::is_prime(p_));
+    for (auto p_ : p41_) CHECK(large_int::is_prime(p_));
+    CHECK(!large_int::is_prime(below_[0] * below_[0]));
+    CHECK(!large_int::is_prime(below_[0] * below_[1]));
+    CHECK(!large_int::is_prime(below_[1] * below_[2]));
+    CHECK(!large_int::is_prime(below_[0] * above_[0]));
+    CHECK(!large_int::is_prime(p41_[0] * p41_[0]));
+    CHECK(!large_int::is_prime(p41_[0] * p41_[1]));
+    CHECK(!large_int::is_prime(above_[0] * uint128_t(1000003)));
+
+    CHECK(large_int::is_prime(pow2(127) - uint128_t(1)));
+    CHECK(large_int::is_prime(pow2(89) - uint128_t(1)));
+    CHECK(large_int::is_prime(-uint128_t(159)));
+    CHECK(!large_int::is_prime(~uint128_t(0)));
+    for (uint128_t n_ = -uint128_t(158); n_ != uint128_t(0); ++n_) CHECK(!large_int::is_prime(n_));
+}
+
+// squares and their neighbours, the guard in front of the Lucas test
+TEST_CASE(modular_is_square) {
+    std::mt19937_64 rng_(20);
+    for (int i_ = 0; i_ < 2000; ++i_) {
+        auto root_ = uint128_t(rng_() >> (rng_() % 64));
+        auto sq_ = root_ * root_;
+        CHECK(large_int::detail_::is_square_(sq_));
+        if (root_ > uint128_t(1)) {
+            CHECK(!large_int::detail_::is_square_(sq_ + uint128_t(1)));
+            CHECK(!large_int::detail_::is_square_(sq_ - uint128_t(1)));
+        }
+    }
+    CHECK(large_int::detail_::is_square_(~uint128_t(0) - pow2(65) + uint128_t(2))); // (2^64 - 1)^2
+}
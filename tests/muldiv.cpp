@@ -0,0 +1,125 @@
+#include "wide_int.h"
+
+#include "check.h"
+
+using large_int::int128_t;
+using large_int::int256_t;
+using large_int::rounding;
+using large_int::uint128_t;
+using large_int::uint256_t;
+
+namespace {
+    const int128_t min128 = int128_t(uint128_t(1) << 127);
+    const int128_t max128 = int128_t(~uint128_t(0) >> 1);
+    const rounding modes[] = {rounding::toward_zero, rounding::floor, rounding::ceil, rounding::half_up,
+                              rounding::half_even};
+
+    // whether the truncated quotient quot_ with remainder magnitude rem_ by a divisor of magnitude div_ moves one away
+    // from zero, the halves compared in 256 bits
+    bool round_away(rounding mode_, bool neg_, const uint256_t &quot_, const uint256_t &rem_, const uint256_t &div_) {
+        if (!rem_) return false;
+        auto twice_ = rem_ + rem_;
+        switch (mode_) {
+            case rounding::floor:
+                return neg_;
+            case rounding::ceil:
+                return !neg_;
+            case rounding::half_up:
+                return twice_ >= div_;
+            case rounding::half_even:
+                return twice_ > div_ || (twice_ == div_ && (static_cast<unsigned>(uint128_t(quot_)) & 1U));
+            default:
+                return false;
+        }
+    }
+
+    // the rounded quotient of the exact product, false when it does not fit
+    bool reference_muldiv(uint128_t lhs_, uint128_t rhs_, uint128_t div_, rounding mode_, uint128_t &res_) {
+        auto qr_ = divmod(uint256_t(lhs_) * uint256_t(rhs_), uint256_t(div_));
+        auto quot_ = qr_.quot + uint256_t(round_away(mode_, false, qr_.quot, qr_.rem, uint256_t(div_)));
+        res_ = uint128_t(quot_);
+        return !(quot_ >> 128);
+    }
+
+    bool reference_muldiv(int128_t lhs_, int128_t rhs_, int128_t div_, rounding mode_, int128_t &res_) {
+        auto qr_ = divmod(int256_t(lhs_) * int256_t(rhs_), int256_t(div_));
+        bool neg_ = (qr_.rem < int256_t(0)) != (div_ < int128_t(0));
+        auto abs_ = [](const int256_t &val_) { return uint256_t(val_ < int256_t(0) ? -val_ : val_); };
+        auto quot_ = qr_.quot;
+        if (round_away(mode_, neg_, abs_(quot_), abs_(qr_.rem), abs_(int256_t(div_))))
+            quot_ += neg_ ? int256_t(-1) : int256_t(1);
+        res_ = int128_t(quot_);
+        return int256_t(min128) <= quot_ && quot_ <= int256_t(max128);
+    }
+
+    void check_muldiv(uint128_t lhs_, uint128_t rhs_, uint128_t div_) {
+        for (auto mode_ : modes) {
+            uint128_t want_;
+            if (div_ && reference_muldiv(lhs_, rhs_, div_, mode_, want_))
+                CHECK(large_int::muldiv(lhs_, rhs_, div_, mode_) == want_);
+            auto slhs_ = int128_t(lhs_), srhs_ = int128_t(rhs_), sdiv_ = int128_t(div_);
+            int128_t swant_;
+            if (sdiv_ && reference_muldiv(slhs_, srhs_, sdiv_, mode_, swant_))
+                CHECK(large_int::muldiv(slhs_, srhs_, sdiv_, mode_) == swant_);
+        }
+    }
+}
+
+// the high halves against a 256-bit product, through the delegate of the build and the fallback one
+TEST_CASE(muldiv_mulhi) {
+    std::mt19937_64 rng_(7);
+    for (int i_ = 0; i_ < 20000; ++i_) {
+        auto lhs_ = int128_test::random128(rng_), rhs_ = int128_test::random128(rng_);
+        auto prod_ = uint256_t(lhs_) * uint256_t(rhs_);
+        CHECK(large_int::mulhi(lhs_, rhs_) == uint128_t(prod_ >> 128));
+        uint128_t low_;
+        CHECK(large_int::detail_delegate<false>::mul_wide(lhs_, rhs_, low_) == uint128_t(prod_ >> 128));
+        CHECK(low_ == uint128_t(prod_) && large_int::detail_delegate<false>::mulhi(lhs_, rhs_) == uint128_t(prod_ >> 128));
+        auto wide_ = large_int::mul_wide(lhs_, rhs_);
+        CHECK(wide_.high == uint128_t(prod_ >> 128) && wide_.low == uint128_t(prod_));
+
+        auto sprod_ = int256_t(int128_t(lhs_)) * int256_t(int128_t(rhs_));
+        CHECK(large_int::mulhi(int128_t(lhs_), int128_t(rhs_)) == int128_t(sprod_ >> 128));
+    }
+    CHECK(large_int::mulhi(~uint128_t(0), ~uint128_t(0)) == ~uint128_t(0) - uint128_t(1));
+    CHECK(large_int::mulhi(min128, min128) == int128_t(uint128_t(1) << 126));
+    CHECK(large_int::mulhi(min128, max128) == -int128_t(uint128_t(1) << 126));
+    CHECK(large_int::mulhi(int128_t(-1), int128_t(1)) == int128_t(-1));
+}
+
+// every rounding mode against the exact quotient, products of every width and divisors of both signs
+TEST_CASE(muldiv_random) {
+    std::mt19937_64 rng_(8);
+    for (int i_ = 0; i_ < 20000; ++i_) {
+        auto lhs_ = int128_test::random128(rng_), rhs_ = int128_test::random128(rng_);
+        check_muldiv(lhs_, rhs_, int128_test::random128(rng_));
+        // a divisor near one of the factors keeps the quotient in range
+        check_muldiv(lhs_, rhs_ >> static_cast<int>(rng_() % 128), rhs_ - uint128_t(rng_() % 3));
+    }
+}
+
+// exact halves, where half_up goes away from zero and half_even to the even neighbour, and quotients at the limits
+TEST_CASE(muldiv_ties) {
+    std::mt19937_64 rng_(9);
+    for (int i_ = 0; i_ < 5000; ++i_) {
+        // odd / 2 times div_ / div_
+        auto odd_ = int128_test::random128(rng_) >> 2 | uint128_t(1), div_ = int128_test::random128(rng_) | uint128_t(1);
+        check_muldiv(odd_, div_, div_ + div_);
+        check_muldiv(-odd_, div_, div_ + div_);
+        check_muldiv(odd_, -div_, div_ + div_);
+    }
+    const uint128_t all_ = ~uint128_t(0);
+    for (auto mode_ : modes) {
+        CHECK(large_int::muldiv(all_, all_, all_, mode_) == all_);
+        CHECK(large_int::muldiv(min128, int128_t(-1), int128_t(-1), mode_) == min128);
+        CHECK(large_int::muldiv(max128, max128, max128, mode_) == max128);
+        CHECK(large_int::muldiv(min128, max128, max128, mode_) == min128);
+    }
+    CHECK(large_int::muldiv(uint128_t(5), uint128_t(1), uint128_t(2), rounding::half_even) == uint128_t(2));
+    CHECK(large_int::muldiv(uint128_t(7), uint128_t(1), uint128_t(2), rounding::half_even) == uint128_t(4));
+    CHECK(large_int::muldiv(int128_t(-5), int128_t(1), int128_t(2), rounding::half_up) == int128_t(-3));
+    CHECK(large_int::muldiv(int128_t(-5), int128_t(1), int128_t(2), rounding::half_even) == int128_t(-2));
+    CHECK(large_int::muldiv(int128_t(-5), int128_t(1), int128_t(2), rounding::floor) == int128_t(-3));
+    CHECK(large_int::muldiv(int128_t(5), int128_t(1), int128_t(-2), rounding::ceil) == int128_t(-2));
+    CHECK(large_int::muldiv(int128_t(5), int128_t(1), int128_t(-2), rounding::toward_zero) == int128_t(-2));
+}
@@ -0,0 +1,121 @@
+#include "int128.h"
+
+#include "check.h"
+
+#include <vector>
+
+using large_int::int128_t;
+using large_int::uint128_t;
+
+namespace {
+    const int128_t min128 = int128_t(uint128_t(1) << 127);
+    const int128_t max128 = int128_t(~uint128_t(0) >> 1);
+
+#ifdef INT128_TEST_BUILTIN
+    // the limits and both sides of the limb edge and of the square roots of the limits
+    std::vector<uint128_t> edge_operands() {
+        std::vector<uint128_t> res_;
+        for (int bits_ : {0, 1, 2, 63, 64, 65, 126, 127}) {
+            auto pow_ = uint128_t(1) << bits_;
+            for (auto val_ : {pow_ - uint128_t(1), pow_, pow_ + uint128_t(1)}) {
+                res_.push_back(val_);
+                res_.push_back(-val_);
+            }
+        }
+        // floor(sqrt(2^127)), its square is just under max128
+        for (uint64_t root_ : {UINT64_C(13043817825332782212), UINT64_C(13043817825332782213)}) {
+            res_.push_back(uint128_t(root_));
+            res_.push_back(-uint128_t(root_));
+        }
+        return res_;
+    }
+
+    void check_unsigned(uint128_t lhs_, uint128_t rhs_) {
+        using int128_test::from_builtin;
+        auto a_ = int128_test::to_builtin(lhs_), b_ = int128_test::to_builtin(rhs_);
+        int128_test::builtin_u128 want_;
+        uint128_t res_, fres_;
+
+        bool over_ = __builtin_add_overflow(a_, b_, &want_);
+        CHECK(large_int::add_overflow(lhs_, rhs_, res_) == over_ && res_ == from_builtin(want_));
+        CHECK(large_int::detail_delegate<false>::add_overflow(lhs_, rhs_, fres_) == over_ && fres_ == res_);
+        CHECK(large_int::add_sat(lhs_, rhs_) == (over_ ? ~uint128_t(0) : res_));
+
+        over_ = __builtin_sub_overflow(a_, b_, &want_);
+        CHECK(large_int::sub_overflow(lhs_, rhs_, res_) == over_ && res_ == from_builtin(want_));
+        CHECK(large_int::detail_delegate<false>::sub_overflow(lhs_, rhs_, fres_) == over_ && fres_ == res_);
+        CHECK(large_int::sub_sat(lhs_, rhs_) == (over_ ? uint128_t(0) : res_));
+
+        over_ = __builtin_mul_overflow(a_, b_, &want_);
+        CHECK(large_int::mul_overflow(lhs_, rhs_, res_) == over_ && res_ == from_builtin(want_));
+        CHECK(large_int::detail_delegate<false>::mul_overflow(lhs_, rhs_, fres_) == over_ && fres_ == res_);
+        CHECK(large_int::mul_sat(lhs_, rhs_) == (over_ ? ~uint128_t(0) : res_));
+    }
+
+    // an overflowing sum or difference goes the way of lhs_, since rhs_ pulled it further out; a product the way of
+    // the sign it should have had
+    void check_signed(int128_t lhs_, int128_t rhs_) {
+        using int128_test::from_builtin;
+        auto a_ = int128_test::to_builtin(lhs_), b_ = int128_test::to_builtin(rhs_);
+        int128_test::builtin_i128 want_;
+        int128_t res_, fres_;
+        auto limit_ = [](bool neg_) { return neg_ ? min128 : max128; };
+
+        bool over_ = __builtin_add_overflow(a_, b_, &want_);
+        CHECK(large_int::add_overflow(lhs_, rhs_, res_) == over_ && res_ == from_builtin(want_));
+        CHECK(large_int::detail_delegate<false>::add_overflow(lhs_, rhs_, fres_) == over_ && fres_ == res_);
+        CHECK(large_int::add_sat(lhs_, rhs_) == (over_ ? limit_(lhs_ < int128_t(0)) : res_));
+
+        over_ = __builtin_sub_overflow(a_, b_, &want_);
+        CHECK(large_int::sub_overflow(lhs_, rhs_, res_) == over_ && res_ == from_builtin(want_));
+        CHECK(large_int::detail_delegate<false>::sub_overflow(lhs_, rhs_, fres_) == over_ && fres_ == res_);
+        CHECK(large_int::sub_sat(lhs_, rhs_) == (over_ ? limit_(lhs_ < int128_t(0)) : res_));
+
+        over_ = __builtin_mul_overflow(a_, b_, &want_);
+        CHECK(large_int::mul_overflow(lhs_, rhs_, res_) == over_ && res_ == from_builtin(want_));
+        CHECK(large_int::detail_delegate<false>::mul_overflow(lhs_, rhs_, fres_) == over_ && fres_ == res_);
+        CHECK(large_int::mul_sat(lhs_, rhs_) == (over_ ? limit_((lhs_ < int128_t(0)) != (rhs_ < int128_t(0))) : res_));
+    }
+#endif
+}
+
+#ifdef INT128_TEST_BUILTIN
+// the flags, wrapped results and saturated values against the compiler's checked arithmetic, through the delegate of
+// the build and the fallback one
+TEST_CASE(overflow_random) {
+    std::mt19937_64 rng_(9);
+    for (int i_ = 0; i_ < 50000; ++i_) {
+        auto lhs_ = int128_test::random128(rng_), rhs_ = int128_test::random128(rng_);
+        check_unsigned(lhs_, rhs_);
+        check_signed(int128_t(lhs_), int128_t(rhs_));
+    }
+}
+
+// every pair of operands at the limits, where the flags change
+TEST_CASE(overflow_edges) {
+    auto edges_ = edge_operands();
+    for (auto lhs_ : edges_) {
+        for (auto rhs_ : edges_) {
+            check_unsigned(lhs_, rhs_);
+            check_signed(int128_t(lhs_), int128_t(rhs_));
+        }
+    }
+}
+#endif
+
+// the saturated values themselves, whatever the reference
+TEST_CASE(overflow_saturate) {
+    const uint128_t all_ = ~uint128_t(0);
+    int128_t res_;
+    CHECK(large_int::add_sat(all_, uint128_t(1)) == all_ && large_int::sub_sat(uint128_t(0), uint128_t(1)) == uint128_t(0));
+    CHECK(large_int::mul_sat(uint128_t(1) << 64, uint128_t(1) << 64) == all_);
+    CHECK(large_int::mul_sat(uint128_t(1) << 63, uint128_t(1) << 64) == uint128_t(1) << 127);
+    CHECK(large_int::add_sat(max128, int128_t(1)) == max128 && large_int::add_sat(min128, int128_t(-1)) == min128);
+    CHECK(large_int::sub_sat(min128, int128_t(1)) == min128 && large_int::sub_sat(max128, int128_t(-1)) == max128);
+    CHECK(large_int::sub_sat(int128_t(-1), min128) == max128 && large_int::sub_sat(int128_t(0), min128) == max128);
+    CHECK(large_int::mul_sat(min128, int128_t(-1)) == max128 && large_int::mul_sat(min128, int128_t(1)) == min128);
+    CHECK(large_int::mul_sat(max128, int128_t(-1)) == -max128 && large_int::mul_sat(max128, int128_t(-2)) == min128);
+    CHECK(large_int::mul_sat(int128_t(uint128_t(1) << 64), -int128_t(uint128_t(1) << 63)) == min128);
+    CHECK(!large_int::mul_overflow(int128_t(uint128_t(1) << 64), -int128_t(uint128_t(1) << 63), res_) && res_ == min128);
+    CHECK(large_int::mul_overflow(int128_t(uint128_t(1) << 64), int128_t(uint128_t(1) << 63), res_) && res_ == min128);
+}
@@ -0,0 +1,189 @@
+#include "int128.h"
+
+#include "check.h"
+
+#include <cstring>
+#include <sstream>
+#include <string>
+
+using large_int::int128_t;
+using large_int::uint128_t;
+
+namespace {
+    const int128_t min128 = int128_t(uint128_t(1) << 127);
+    const int128_t max128 = int128_t(~uint128_t(0) >> 1);
+    const uint128_t sentinel = uint128_t(0x5a5a5a5a5a5a5a5aULL) << 64 | uint128_t(0x5a5a5a5a5a5a5a5aULL);
+
+    template<class _Tp>
+    large_int::from_chars_result parse(const std::string &str_, _Tp &value_, int base_ = 10) {
+        return large_int::from_chars(str_.data(), str_.data() + str_.size(), value_, base_);
+    }
+
+    // whether str_ parses whole to want_
+    template<class _Tp>
+    bool parses_to(const std::string &str_, _Tp want_, int base_ = 10) {
+        _Tp got_(sentinel);
+        auto res_ = parse(str_, got_, base_);
+        return res_.ec == std::errc() && res_.ptr == str_.data() + str_.size() && got_ == want_;
+    }
+
+    // whether str_ fails with ec_ at ptr_ from the start, value left alone
+    template<class _Tp>
+    bool fails(const std::string &str_, std::errc ec_, std::size_t at_, int base_ = 10) {
+        _Tp got_(sentinel);
+        auto res_ = parse(str_, got_, base_);
+        return res_.ec == ec_ && res_.ptr == str_.data() + at_ && got_ == _Tp(sentinel);
+    }
+
+    template<class _Tp>
+    _Tp scan(const std::string &str_, std::ios::fmtflags base_, std::ios::iostate &state_, std::string &rest_) {
+        std::istringstream in_(str_);
+        in_.setf(base_, std::ios::basefield);
+        _Tp val_(sentinel);
+        in_ >> val_;
+        state_ = in_.rdstate();
+        in_.clear();
+        std::getline(in_, rest_, '\0');
+        return val_;
+    }
+}
+
+// to_chars and back in the bases the parser has paths for, both cases of letters
+TEST_CASE(parse_round_trip) {
+    std::mt19937_64 rng_(3);
+    for (int i_ = 0; i_ < 5000; ++i_) {
+        auto val_ = int128_test::random128(rng_);
+        for (int base_ : {2, 8, 10, 16, 36}) {
+            auto str_ = large_int::to_string(val_, base_);
+            CHECK(parses_to(str_, val_, base_));
+            for (auto &c_ : str_) c_ = static_cast<char>(toupper(c_));
+            CHECK(parses_to(str_, val_, base_));
+            auto sval_ = int128_t(val_);
+            CHECK(parses_to(large_int::to_string(sval_, base_), sval_, base_));
+        }
+    }
+}
+
+// the decimal word loads against a digit at a time: digit runs of every length up to 38 ended by each of the bytes
+// just outside '0'..'9', or by the end
+TEST_CASE(parse_decimal_runs) {
+    std::mt19937_64 rng_(4);
+    for (std::size_t len_ = 1; len_ <= 38; ++len_) {
+        for (const char *stop_ : {"", "/", ":", "a", " "}) {
+            std::string str_;
+            uint128_t want_(0);
+            for (std::size_t i_ = 0; i_ < len_; ++i_) {
+                auto d_ = static_cast<unsigned>(rng_() % 10);
+                str_ += static_cast<char>('0' + d_);
+                want_ = want_ * uint128_t(10) + uint128_t(d_);
+            }
+            if (*stop_) str_ = str_ + stop_ + "12345678";
+            uint128_t got_;
+            auto res_ = parse(str_, got_);
+            CHECK(res_.ec == std::errc() && got_ == want_ && res_.ptr == str_.data() + len_);
+        }
+    }
+    CHECK(parses_to(std::string(1000, '0'), uint128_t(0)));
+    CHECK(parses_to(std::string(100, '0') + "340282366920938463463374607431768211455", ~uint128_t(0)));
+    CHECK(parses_to(std::string(45, '0') + "12", int128_t(12)));
+    CHECK(parses_to("-" + std::string(45, '0') + "170141183460469231731687303715884105728", min128));
+    CHECK(parses_to(std::string(50, '0') + "ff", uint128_t(255), 16));
+}
+
+// exactly the limits parse, one past them is result_out_of_range after all the digits, value untouched
+TEST_CASE(parse_limits) {
+    CHECK(parses_to("340282366920938463463374607431768211455", ~uint128_t(0)));
+    CHECK(fails<uint128_t>("340282366920938463463374607431768211456", std::errc::result_out_of_range, 39));
+    CHECK(fails<uint128_t>("1000000000000000000000000000000000000000", std::errc::result_out_of_range, 40));
+    CHECK(fails<uint128_t>("999999999999999999999999999999999999999x", std::errc::result_out_of_range, 39));
+    CHECK(parses_to("170141183460469231731687303715884105727", max128));
+    CHECK(fails<int128_t>("170141183460469231731687303715884105728", std::errc::result_out_of_range, 39));
+    CHECK(parses_to("-170141183460469231731687303715884105728", min128));
+    CHECK(fails<int128_t>("-170141183460469231731687303715884105729", std::errc::result_out_of_range, 40));
+    CHECK(parses_to(std::string(32, 'f'), ~uint128_t(0), 16));
+    CHECK(fails<uint128_t>("1" + std::string(32, '0'), std::errc::result_out_of_range, 33, 16));
+    CHECK(parses_to("3" + std::string(42, '7'), ~uint128_t(0), 8));
+    CHECK(fails<uint128_t>("4" + std::string(42, '0'), std::errc::result_out_of_range, 43, 8));
+    CHECK(parses_to(std::string(128, '1'), ~uint128_t(0), 2));
+    CHECK(fails<uint128_t>(std::string(129, '1'), std::errc::result_out_of_range, 129, 2));
+    CHECK(parses_to("f5lxx1zz5pnorynqglhzmsp33", ~uint128_t(0), 36));
+    CHECK(fails<uint128_t>("f5lxx1zz5pnorynqglhzmsp34", std::errc::result_out_of_range, 25, 36));
+    CHECK(parses_to("-" + std::string(1, '8') + std::string(31, '0'), min128, 16));
+    CHECK(fails<int128_t>("8" + std::string(31, '0'), std::errc::result_out_of_range, 32, 16));
+}
+
+// no sign for the unsigned type, no '+', no prefix, no digits; parsing stops at the first non-digit
+TEST_CASE(parse_invalid) {
+    CHECK(fails<uint128_t>("", std::errc::invalid_argument, 0));
+    CHECK(fails<int128_t>("", std::errc::invalid_argument, 0));
+    CHECK(fails<int128_t>("-", std::errc::invalid_argument, 0));
+    CHECK(fails<uint128_t>("-", std::errc::invalid_argument, 0));
+    CHECK(fails<uint128_t>("-1", std::errc::invalid_argument, 0));
+    CHECK(fails<int128_t>("+1", std::errc::invalid_argument, 0));
+    CHECK(fails<uint128_t>("+1", std::errc::invalid_argument, 0));
+    CHECK(fails<int128_t>(" 1", std::errc::invalid_argument, 0));
+    CHECK(fails<int128_t>("--1", std::errc::invalid_argument, 0));
+    CHECK(fails<uint128_t>("g", std::errc::invalid_argument, 0, 16));
+    CHECK(fails<uint128_t>("2", std::errc::invalid_argument, 0, 2));
+
+    uint128_t val_;
+    std::string hex_ = "0x10";
+    auto res_ = parse(hex_, val_, 16);
+    CHECK(res_.ec == std::errc() && val_ == uint128_t(0) && res_.ptr == hex_.data() + 1);
+    std::string dec_ = "123abc";
+    res_ = parse(dec_, val_);
+    CHECK(res_.ec == std::errc() && val_ == uint128_t(123) && res_.ptr == dec_.data() + 3);
+    res_ = parse(dec_, val_, 16);
+    CHECK(res_.ec == std::errc() && val_ == uint128_t(0x123abc) && res_.ptr == dec_.data() + 6);
+    int128_t sval_;
+    std::string neg_ = "-0";
+    auto sres_ = parse(neg_, sval_);
+    CHECK(sres_.ec == std::errc() && sval_ == int128_t(0) && sres_.ptr == neg_.data() + 2);
+}
+
+// the basefield picks the base, unset it follows the prefix like %i; out of range sets failbit and clamps
+TEST_CASE(parse_stream) {
+    std::ios::iostate state_;
+    std::string rest_;
+    auto dec_ = std::ios::dec, hex_ = std::ios::hex, oct_ = std::ios::oct, none_ = std::ios::fmtflags(0);
+
+    CHECK(scan<uint128_t>("ff", hex_, state_, rest_) == uint128_t(255) && state_ == std::ios::eofbit);
+    CHECK(scan<uint128_t>("0xff ", hex_, state_, rest_) == uint128_t(255) && !state_ && rest_ == " ");
+    CHECK(scan<uint128_t>("0XFF", hex_, state_, rest_) == uint128_t(255));
+    CHECK(scan<uint128_t>("17", oct_, state_, rest_) == uint128_t(15));
+    CHECK(scan<uint128_t>("017", oct_, state_, rest_) == uint128_t(15));
+    CHECK(scan<uint128_t>("0x1f", oct_, state_, rest_) == uint128_t(0) && rest_ == "x1f");
+    CHECK(scan<uint128_t>("0x1f", none_, state_, rest_) == uint128_t(31));
+    CHECK(scan<uint128_t>("017", none_, state_, rest_) == uint128_t(15));
+    CHECK(scan<uint128_t>("019", none_, state_, rest_) == uint128_t(1) && rest_ == "9");
+    CHECK(scan<uint128_t>("17", none_, state_, rest_) == uint128_t(17));
+    CHECK(scan<uint128_t>("0", none_, state_, rest_) == uint128_t(0) && state_ == std::ios::eofbit);
+    CHECK(scan<uint128_t>("0x10", dec_, state_, rest_) == uint128_t(0) && !state_ && rest_ == "x10");
+    CHECK(scan<uint128_t>("  42 7", dec_, state_, rest_) == uint128_t(42) && rest_ == " 7");
+    CHECK(scan<int128_t>("-0x10", none_, state_, rest_) == int128_t(-16));
+    CHECK(scan<int128_t>("+12", dec_, state_, rest_) == int128_t(12));
+    CHECK(scan<uint128_t>(std::string(60, '0') + "12", dec_, state_, rest_) == uint128_t(12) &&
+          state_ == std::ios::eofbit);
+    CHECK(scan<uint128_t>("x", dec_, state_, rest_) == uint128_t(0) && (state_ & std::ios::failbit));
+    CHECK(scan<uint128_t>("", dec_, state_, rest_) == sentinel && (state_ & std::ios::failbit)); // the sentry fails
+
+    CHECK(scan<uint128_t>("340282366920938463463374607431768211455", dec_, state_, rest_) == ~uint128_t(0) &&
+          state_ == std::ios::eofbit);
+    CHECK(scan<uint128_t>("340282366920938463463374607431768211456", dec_, state_, rest_) == ~uint128_t(0) &&
+          (state_ & std::ios::failbit));
+    CHECK(scan<uint128_t>(std::string(60, '9'), dec_, state_, rest_) == ~uint128_t(0) && (state_ & std::ios::failbit));
+    CHECK(scan<uint128_t>("1" + std::string(32, '0'), hex_, state_, rest_) == ~uint128_t(0) &&
+          (state_ & std::ios::failbit));
+    CHECK(scan<int128_t>("170141183460469231731687303715884105728", dec_, state_, rest_) == max128 &&
+          (state_ & std::ios::failbit));
+    CHECK(scan<int128_t>("-170141183460469231731687303715884105728", dec_, state_, rest_) == min128 &&
+          !(state_ & std::ios::failbit));
+    CHECK(scan<int128_t>("-170141183460469231731687303715884105729", dec_, state_, rest_) == min128 &&
+          (state_ & std::ios::failbit));
+
+    std::istringstream in_("12 0x34 -5");
+    uint128_t a_, b_;
+    int128_t c_;
+    in_ >> a_ >> std::hex >> b_ >> std::dec >> c_;
+    CHECK(in_ && a_ == uint128_t(12) && b_ == uint128_t(0x34) && c_ == int128_t(-5));
+}
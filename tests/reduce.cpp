@@ -0,0 +1,122 @@
+#include "int128_reduce.h"
+#include "wide_int.h"
+
+#include "check.h"
+
+#include <vector>
+
+using large_int::int128_t;
+using large_int::int512_t;
+using large_int::uint128_t;
+
+namespace {
+    // empty, one value, below a chunk of 4096, and enough that 3 and 7 threads all get a share with a ragged tail
+    const std::size_t sizes[] = {0, 1, 5, 4097, 3 * 4096 + 7, 7 * 4096 + 13};
+
+    const unsigned thread_counts[] = {0, 1, 3, 7};
+
+    enum dist { near_top, near_bottom, alternating, random };
+
+    // within 2^20 of the top or of the bottom of _Tp, or the two in turn so the partial sums wrap but the total
+    // may not, or random of every width
+    template<class _Tp>
+    std::vector<_Tp> make_values(std::mt19937_64 &rng_, dist dist_, std::size_t size_) {
+        const bool signed_ = std::is_same<_Tp, int128_t>::value;
+        const auto top_ = signed_ ? ~uint128_t(0) >> 1 : ~uint128_t(0), bottom_ = signed_ ? ~top_ : uint128_t(0);
+        std::vector<_Tp> values_(size_);
+        for (std::size_t i_ = 0; i_ < size_; ++i_) {
+            auto off_ = uint128_t(rng_() % (1U << 20));
+            switch (dist_) {
+                case near_top:
+                    values_[i_] = _Tp(top_ - off_);
+                    break;
+                case near_bottom:
+                    values_[i_] = _Tp(bottom_ + off_);
+                    break;
+                case alternating:
+                    values_[i_] = _Tp(i_ % 2 ? top_ - off_ : bottom_ + off_);
+                    break;
+                case random:
+                    values_[i_] = _Tp(int128_test::random128(rng_));
+                    break;
+            }
+        }
+        return values_;
+    }
+
+    // the exact total wrapped to _Tp, and whether it fits
+    template<class _Tp>
+    large_int::reduce_result<_Tp> reference(const int512_t &total_) {
+        auto value_ = _Tp(total_);
+        return {value_, !(int512_t(value_) == total_)};
+    }
+
+    template<class _Tp>
+    bool same(const large_int::reduce_result<_Tp> &lhs_, const large_int::reduce_result<_Tp> &rhs_) {
+        return lhs_.value == rhs_.value && lhs_.overflow == rhs_.overflow;
+    }
+
+    template<class _Tp>
+    void check_reduce() {
+        std::mt19937_64 rng_(13);
+        for (std::size_t size_ : sizes) {
+            for (int d_ = near_top; d_ <= random; ++d_) {
+                auto lhs_ = make_values<_Tp>(rng_, dist(d_), size_);
+                auto rhs_ = make_values<_Tp>(rng_, dist((d_ + 1) % 4), size_);
+                int512_t sum_ = 0, dot_ = 0;
+                auto min_ = lhs_.empty() ? _Tp(0) : lhs_[0], max_ = min_;
+                for (std::size_t i_ = 0; i_ < size_; ++i_) {
+                    sum_ += int512_t(lhs_[i_]);
+                    dot_ += int512_t(lhs_[i_]) * int512_t(rhs_[i_]);
+                    if (lhs_[i_] < min_) min_ = lhs_[i_];
+                    if (max_ < lhs_[i_]) max_ = lhs_[i_];
+                }
+                auto want_sum_ = reference<_Tp>(sum_), want_dot_ = reference<_Tp>(dot_);
+                for (unsigned threads_ : thread_counts) {
+                    auto first_ = lhs_.data(), last_ = lhs_.data() + size_;
+                    CHECK(same(large_int::reduce_sum(first_, last_, threads_), want_sum_));
+                    CHECK(same(large_int::dot(first_, last_, rhs_.data(), threads_), want_dot_));
+                    if (size_) {
+                        auto minmax_ = large_int::reduce_minmax(first_, last_, threads_);
+                        CHECK(minmax_.min == min_ && minmax_.max == max_);
+                    }
+                }
+            }
+        }
+    }
+}
+
+// the value and the overflow flag for every thread count against a 512-bit total, on values at the ends of the
+// range where the partials wrap
+TEST_CASE(reduce_threads) {
+    check_reduce<int128_t>();
+    check_reduce<uint128_t>();
+}
+
+// a total that lands exactly on the limits does not overflow, one past them does
+TEST_CASE(reduce_edges) {
+    const auto max_ = int128_t(~uint128_t(0) >> 1), min_ = ~max_;
+    std::vector<int128_t> values_(2 * 4096 + 1, int128_t(0));
+    values_[0] = max_;
+    values_[4096] = int128_t(-1);
+    values_[2 * 4096] = int128_t(1);
+    auto res_ = large_int::reduce_sum(values_.data(), values_.data() + values_.size(), 2);
+    CHECK(res_.value == max_ && !res_.overflow);
+    values_[4096] = int128_t(0);
+    res_ = large_int::reduce_sum(values_.data(), values_.data() + values_.size(), 2);
+    CHECK(res_.value == min_ && res_.overflow);
+
+    std::vector<uint128_t> ones_(3, ~uint128_t(0));
+    auto ures_ = large_int::reduce_sum(ones_.data(), ones_.data() + 1);
+    CHECK(ures_.value == ~uint128_t(0) && !ures_.overflow);
+    ures_ = large_int::reduce_sum(ones_.data(), ones_.data() + 3);
+    CHECK(ures_.value == ~uint128_t(0) - 2 && ures_.overflow);
+
+    // min * min is 2^254, twice it is 2^255, both far out of range but zero below 2^128
+    const int128_t mins_[] = {min_, min_};
+    auto dres_ = large_int::dot(mins_, mins_ + 2, mins_);
+    CHECK(dres_.value == int128_t(0) && dres_.overflow);
+    const int128_t lhs_[] = {min_, min_}, rhs_[] = {int128_t(1), int128_t(-1)};
+    dres_ = large_int::dot(lhs_, lhs_ + 2, rhs_);
+    CHECK(dres_.value == int128_t(0) && !dres_.overflow);
+}
@@ -0,0 +1,113 @@
+#include "int128_sort.h"
+
+#include "check.h"
+
+#include <algorithm>
+#include <vector>
+
+using large_int::int128_t;
+using large_int::uint128_t;
+
+namespace {
+    // 0, 1, around the insertion sort cutoff, past it, past the size where all digits are counted at once and
+    // the parallel sort splits, and large enough that a bucket of the MSD split takes that path again
+    const std::size_t sizes[] = {0, 1, 2, 7, 47, 48, 49, 300, 5000, 70000, 140000};
+
+    enum dist { equal, few, narrow, random, crossing };
+
+    const char *const dist_names[] = {"equal", "few", "narrow", "random", "crossing"};
+
+    // crossing is signed around zero, few repeats 5 keys so stability shows, random of the two top halves in
+    // the upper byte pushes the MSD buckets past the counting threshold
+    template<class _Key>
+    std::vector<_Key> make_keys(std::mt19937_64 &rng_, dist dist_, std::size_t size_) {
+        std::vector<_Key> keys_(size_);
+        for (auto &k_ : keys_) {
+            switch (dist_) {
+                case equal:
+                    k_ = _Key(uint128_t(0x0123456789abcdefULL) << 64 | uint128_t(1));
+                    break;
+                case few:
+                    k_ = _Key(uint128_t(rng_() % 5) << 100);
+                    break;
+                case narrow:
+                    k_ = _Key(rng_() & 0xffffffffffULL);
+                    break;
+                case random:
+                    k_ = _Key(int128_test::random128(rng_) ^ uint128_t(rng_() & 1) << 120);
+                    break;
+                case crossing:
+                    k_ = _Key(int128_t(static_cast<int64_t>(rng_()) >> (rng_() % 64)) << static_cast<int>(rng_() % 60));
+                    break;
+            }
+        }
+        return keys_;
+    }
+
+    // the positions of keys_ in the order std::stable_sort leaves them
+    template<class _Key>
+    std::vector<uint32_t> stable_order(const std::vector<_Key> &keys_) {
+        std::vector<uint32_t> index_(keys_.size());
+        for (std::size_t i_ = 0; i_ < index_.size(); ++i_) index_[i_] = static_cast<uint32_t>(i_);
+        std::stable_sort(index_.begin(), index_.end(), [&](uint32_t lhs_, uint32_t rhs_) {
+            return keys_[lhs_] < keys_[rhs_];
+        });
+        return index_;
+    }
+
+    template<class _Key>
+    bool sorted_as(const std::vector<_Key> &keys_, const std::vector<_Key> &orig_, const std::vector<uint32_t> &order_) {
+        for (std::size_t i_ = 0; i_ < keys_.size(); ++i_) {
+            if (!(keys_[i_] == orig_[order_[i_]])) return false;
+        }
+        return true;
+    }
+
+    template<class _Key>
+    void check_sorts(const char *name_) {
+        std::mt19937_64 rng_(12);
+        for (std::size_t size_ : sizes) {
+            for (int d_ = equal; d_ <= crossing; ++d_) {
+                auto orig_ = make_keys<_Key>(rng_, dist(d_), size_);
+                auto order_ = stable_order(orig_);
+                bool ok_ = true;
+
+                auto keys_ = orig_;
+                large_int::radix_sort(keys_.data(), keys_.data() + size_);
+                ok_ &= sorted_as(keys_, orig_, order_);
+
+                keys_ = orig_;
+                std::vector<uint32_t> vals_(size_);
+                for (std::size_t i_ = 0; i_ < size_; ++i_) vals_[i_] = static_cast<uint32_t>(i_);
+                large_int::radix_sort(keys_.data(), keys_.data() + size_, vals_.data());
+                ok_ &= sorted_as(keys_, orig_, order_) && vals_ == order_;
+
+                std::vector<uint32_t> index_(size_);
+                large_int::radix_argsort(orig_.data(), orig_.data() + size_, index_.data());
+                ok_ &= index_ == order_;
+
+                for (unsigned threads_ : {1U, 3U, 7U}) {
+                    keys_ = orig_;
+                    large_int::parallel_radix_sort(keys_.data(), keys_.data() + size_, threads_);
+                    ok_ &= sorted_as(keys_, orig_, order_);
+
+                    keys_ = orig_;
+                    for (std::size_t i_ = 0; i_ < size_; ++i_) vals_[i_] = static_cast<uint32_t>(i_);
+                    large_int::parallel_radix_sort(keys_.data(), keys_.data() + size_, vals_.data(), threads_);
+                    ok_ &= sorted_as(keys_, orig_, order_) && vals_ == order_;
+                }
+                if (!ok_) printf("%s %s n=%zu\n", name_, dist_names[d_], size_);
+                CHECK(ok_);
+            }
+        }
+    }
+}
+
+// every entry point against std::stable_sort, the keys and for the payload and argsort the exact permutation
+TEST_CASE(radix_sort_unsigned) {
+    check_sorts<uint128_t>("uint128_t");
+}
+
+TEST_CASE(radix_sort_signed) {
+    check_sorts<int128_t>("int128_t");
+}
@@ -0,0 +1,151 @@
+#include "wide_int.h"
+
+#include "check.h"
+
+#include <sstream>
+#include <string>
+
+using large_int::int128_t;
+using large_int::int256_t;
+using large_int::uint128_t;
+using large_int::uint256_t;
+using large_int::uint512_t;
+
+namespace {
+    const int128_t min128 = int128_t(uint128_t(1) << 127);
+
+    uint128_t make128(uint64_t high_, uint64_t low_) { return uint128_t(high_) << 64 | uint128_t(low_); }
+
+    // limbs most significant first, as the number is written
+    uint256_t make256(uint64_t l3_, uint64_t l2_, uint64_t l1_, uint64_t l0_) {
+        return uint256_t(make128(l3_, l2_)) << 128 | uint256_t(make128(l1_, l0_));
+    }
+
+    uint128_t high128(const uint256_t &val_) { return uint128_t(val_ >> 128); }
+
+    uint128_t low128(const uint256_t &val_) { return uint128_t(val_); }
+
+    template<class _Tp>
+    std::string stream(const _Tp &val_, std::ios::fmtflags flags_) {
+        std::ostringstream os_;
+        os_.flags(flags_);
+        os_ << val_;
+        return os_.str();
+    }
+}
+
+// the low and high halves of 256-bit products against mul_wide, signed and unsigned
+TEST_CASE(wide_int_mul) {
+    std::mt19937_64 rng_(8);
+    for (int i_ = 0; i_ < 5000; ++i_) {
+        auto lhs_ = int128_test::random128(rng_), rhs_ = int128_test::random128(rng_);
+        auto prod_ = uint256_t(lhs_) * uint256_t(rhs_);
+        auto want_ = large_int::mul_wide(lhs_, rhs_);
+        CHECK(low128(prod_) == want_.low && high128(prod_) == want_.high);
+
+        auto sprod_ = int256_t(int128_t(lhs_)) * int256_t(int128_t(rhs_));
+        auto swant_ = large_int::mul_wide(int128_t(lhs_), int128_t(rhs_));
+        CHECK(uint128_t(sprod_) == swant_.low && int128_t(sprod_ >> 128) == swant_.high);
+    }
+}
+
+// quotients and remainders of values that fit in 128 bits against int128_t and uint128_t, and 256-by-128 division
+// against div_256_128_
+TEST_CASE(wide_int_divmod) {
+    std::mt19937_64 rng_(9);
+    for (int i_ = 0; i_ < 5000; ++i_) {
+        auto lhs_ = int128_test::random128(rng_), rhs_ = int128_test::random128(rng_);
+        if (!rhs_) rhs_ = uint128_t(1);
+        auto res_ = divmod(uint256_t(lhs_), uint256_t(rhs_));
+        CHECK(res_.quot == uint256_t(lhs_ / rhs_) && res_.rem == uint256_t(lhs_ % rhs_));
+
+        auto slhs_ = int128_t(lhs_), srhs_ = int128_t(rhs_);
+        if (!(slhs_ == min128 && srhs_ == int128_t(-1))) {
+            auto sres_ = divmod(int256_t(slhs_), int256_t(srhs_));
+            CHECK(sres_.quot == int256_t(slhs_ / srhs_) && sres_.rem == int256_t(slhs_ % srhs_));
+        }
+
+        // a 256-bit dividend whose quotient fits in 128 bits
+        auto high_ = int128_test::random128(rng_) % rhs_;
+        auto wide_ = uint256_t(high_) << 128 | uint256_t(lhs_);
+        uint128_t rem_;
+        auto quot_ = large_int::detail_::div_256_128_(high_, lhs_, rhs_, rem_);
+        res_ = divmod(wide_, uint256_t(rhs_));
+        CHECK(res_.quot == uint256_t(quot_) && res_.rem == uint256_t(rem_));
+        CHECK(res_.quot * uint256_t(rhs_) + res_.rem == wide_);
+    }
+    // INT128_MIN / -1 overflows int128_t but not int256_t
+    auto res_ = divmod(int256_t(min128), int256_t(-1));
+    CHECK(res_.quot == -int256_t(min128) && res_.rem == int256_t(0));
+    CHECK(to_string(res_.quot) == "170141183460469231731687303715884105728");
+}
+
+// every shift count against the two 128-bit halves, and arithmetic right shifts of sign extended values
+TEST_CASE(wide_int_shift) {
+    std::mt19937_64 rng_(10);
+    for (int i_ = 0; i_ < 200; ++i_) {
+        auto val_ = int128_test::random128(rng_);
+        for (int s_ = 0; s_ < 256; ++s_) {
+            auto left_ = uint256_t(val_) << s_;
+            auto want_low_ = s_ < 128 ? val_ << s_ : uint128_t(0);
+            auto want_high_ = s_ == 0 ? uint128_t(0) : s_ < 128 ? val_ >> (128 - s_) : val_ << (s_ - 128);
+            CHECK(low128(left_) == want_low_ && high128(left_) == want_high_);
+            CHECK(left_ >> s_ == (s_ <= 128 ? uint256_t(val_) : uint256_t(val_ << (s_ - 128) >> (s_ - 128))));
+
+            auto sval_ = int128_t(val_);
+            auto right_ = int256_t(sval_) >> s_;
+            auto sign_ = sval_ < int128_t(0) ? int256_t(-1) : int256_t(0);
+            CHECK(right_ == (s_ < 128 ? int256_t(sval_ >> s_) : sign_));
+        }
+    }
+    CHECK((uint256_t(1) << 256) == uint256_t(0));
+    CHECK((int256_t(-1) >> 300) == int256_t(-1));
+    CHECK((uint256_t(~uint128_t(0)) << 200 >> 255) == uint256_t(1));
+}
+
+// every base against the 128-bit to_string, and the stream flags
+TEST_CASE(wide_int_to_string) {
+    std::mt19937_64 rng_(11);
+    for (int i_ = 0; i_ < 1000; ++i_) {
+        auto val_ = int128_test::random128(rng_);
+        for (int base_ : {2, 8, 10, 16, 36}) {
+            CHECK(to_string(uint256_t(val_), base_) == large_int::to_string(val_, base_));
+            CHECK(to_string(int256_t(int128_t(val_)), base_) == large_int::to_string(int128_t(val_), base_));
+        }
+        CHECK(stream(int256_t(int128_t(val_)), std::ios::dec) == stream(int128_t(val_), std::ios::dec));
+        CHECK(stream(uint256_t(val_), std::ios::hex | std::ios::showbase) ==
+              stream(val_, std::ios::hex | std::ios::showbase));
+        CHECK(stream(uint256_t(val_), std::ios::oct | std::ios::showbase) ==
+              stream(val_, std::ios::oct | std::ios::showbase));
+    }
+}
+
+// values only 256 bits hold, worked out elsewhere
+TEST_CASE(wide_int_constants) {
+    auto max_ = ~uint256_t(0);
+    CHECK(to_string(max_) == "115792089237316195423570985008687907853269984665640564039457584007913129639935");
+    CHECK(to_string(max_, 16) == std::string(64, 'f'));
+    CHECK(to_string(int256_t(1) << 255) ==
+          "-57896044618658097711785492504343953926634992332820282019728792003956564819968");
+    CHECK(to_string(uint256_t(~uint128_t(0)) * uint256_t(~uint128_t(0))) ==
+          "115792089237316195423570985008687907852589419931798687112530834793049593217025");
+    CHECK(uint256_t(uint128_t(1) << 127) * uint256_t(uint128_t(1) << 127) * uint256_t(4) == uint256_t(0));
+
+    uint256_t pow_ = 1;
+    for (int i_ = 0; i_ < 76; ++i_) pow_ *= uint256_t(10);
+    CHECK(to_string(pow_) == "1" + std::string(76, '0'));
+    CHECK(pow_ == 10000000000000000000000000000000000000000000000000000000000000000000000000000_U256);
+
+    auto x_ = make256(0x0123456789abcdefULL, 0xfedcba9876543210ULL, 0x0f1e2d3c4b5a6978ULL, 0x8796a5b4c3d2e1f0ULL);
+    CHECK(to_string(x_) == "514631507721405312519378913364952599457899916736173488040697764812573303280");
+    auto res_ = divmod(x_, uint256_t(0xfedcba9876543210ULL));
+    CHECK(to_string(res_.quot) == "28022775604404824812619121884822397023458196864713063159");
+    CHECK(res_.rem == uint256_t(14236259949738652800ULL));
+    CHECK(to_string(x_ * x_) == "53864707787182575789184531532788786222650426843512154934005769656588866928896");
+    CHECK(to_string(uint512_t(x_) * uint512_t(x_)) ==
+          "264845588739606855799733498709238752839456489812656545662455345611834941269707783668616735996926645772"
+          "239967024916866883378410999455105043370858758400");
+    res_ = divmod(max_, pow_ / uint256_t(100000000000000000000000000000000000000_U128));
+    CHECK(to_string(res_.quot) == "1157920892373161954235709850086879078532");
+    CHECK(to_string(res_.rem) == "69984665640564039457584007913129639935");
+}